@@ -0,0 +1,174 @@
+// Microbenchmarks for the hot-path allocators against the global heap:
+// object pool and shared memory pool against new/delete, a bump arena
+// against a per-batch std::vector, and an order-id index on a
+// PoolAllocator against the default allocator. Each reports the heap
+// allocations per iteration of its timed loop.
+//
+// Build: g++ -std=c++17 -O2 -o allocator_benchmarks benchmarks/allocator_benchmarks.cpp -lbenchmark -pthread
+// Usage: allocator_benchmarks [--benchmark_filter=<regex>] --benchmark_out=run.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../include/shared_code.h"
+#include "../include/memory_pool.h"
+
+TRADING_COUNT_ALLOCATIONS();
+
+namespace {
+
+struct Record {
+    uint64_t id;
+    int64_t price;
+    uint64_t quantity;
+    uint64_t timestamp;
+};
+
+constexpr size_t LIVE_OBJECTS = 64;
+constexpr size_t BATCH = 256;
+
+void report_allocations(benchmark::State& state, uint64_t before) {
+    state.counters["allocs_per_iter"] = static_cast<double>(thread_allocation_count() - before) /
+                                        static_cast<double>(state.iterations());
+}
+
+// Keeps LIVE_OBJECTS records alive and replaces the oldest each iteration
+void BM_NewDelete(benchmark::State& state) {
+    std::vector<Record*> live(LIVE_OBJECTS);
+    for (auto& record : live) {
+        record = new Record{};
+    }
+    size_t next = 0;
+    const uint64_t before = thread_allocation_count();
+
+    for (auto _ : state) {
+        delete live[next];
+        live[next] = new Record{next, 0, 0, 0};
+        benchmark::DoNotOptimize(live[next]);
+        next = (next + 1) % LIVE_OBJECTS;
+    }
+    report_allocations(state, before);
+    for (auto* record : live) {
+        delete record;
+    }
+}
+BENCHMARK(BM_NewDelete);
+
+void BM_ObjectPool(benchmark::State& state) {
+    ObjectPool<Record> pool(LIVE_OBJECTS);
+    std::vector<Record*> live(LIVE_OBJECTS);
+    for (auto& record : live) {
+        record = pool.create();
+    }
+    size_t next = 0;
+    const uint64_t before = thread_allocation_count();
+
+    for (auto _ : state) {
+        pool.destroy(live[next]);
+        live[next] = pool.create(Record{next, 0, 0, 0});
+        benchmark::DoNotOptimize(live[next]);
+        next = (next + 1) % LIVE_OBJECTS;
+    }
+    report_allocations(state, before);
+}
+BENCHMARK(BM_ObjectPool);
+
+// Same churn through a pool living in a real /dev/shm segment
+void BM_SharedObjectPool(benchmark::State& state) {
+    using Pool = SharedObjectPool<Record, 1024>;
+    SharedMemory<Pool> shm("/bench_record_pool", true);
+    Pool* pool = shm.get();
+    std::vector<uint32_t> live(LIVE_OBJECTS);
+    for (auto& index : live) {
+        index = pool->allocate();
+    }
+    size_t next = 0;
+    const uint64_t before = thread_allocation_count();
+
+    for (auto _ : state) {
+        pool->release(live[next]);
+        live[next] = pool->allocate();
+        pool->at(live[next]).id = next;
+        benchmark::DoNotOptimize(live[next]);
+        next = (next + 1) % LIVE_OBJECTS;
+    }
+    report_allocations(state, before);
+    state.counters["in_use"] = static_cast<double>(pool->size());
+    destroy_memory_block("/bench_record_pool");
+}
+BENCHMARK(BM_SharedObjectPool);
+
+// Per-batch scratch buffer: a fresh vector each batch against the thread arena
+void BM_BatchScratchVector(benchmark::State& state) {
+    const uint64_t before = thread_allocation_count();
+    for (auto _ : state) {
+        std::vector<Record> scratch;
+        scratch.reserve(BATCH);
+        for (size_t i = 0; i < BATCH; ++i) {
+            scratch.push_back(Record{i, 0, 0, 0});
+        }
+        benchmark::DoNotOptimize(scratch.data());
+    }
+    report_allocations(state, before);
+}
+BENCHMARK(BM_BatchScratchVector);
+
+void BM_BatchScratchArena(benchmark::State& state) {
+    BumpArena& arena = thread_arena();
+    arena.reset();
+    arena.allocate_array<Record>(BATCH);  // warmup: the arena's first chunk
+    const uint64_t before = thread_allocation_count();
+
+    for (auto _ : state) {
+        arena.reset();
+        std::vector<Record, ArenaAllocator<Record>> scratch{ArenaAllocator<Record>(arena)};
+        scratch.reserve(BATCH);
+        for (size_t i = 0; i < BATCH; ++i) {
+            scratch.push_back(Record{i, 0, 0, 0});
+        }
+        benchmark::DoNotOptimize(scratch.data());
+    }
+    report_allocations(state, before);
+}
+BENCHMARK(BM_BatchScratchArena);
+
+// Order-id index churn like an L3 book: insert a new id, erase the oldest
+template<typename Map>
+void run_index_churn(benchmark::State& state, Map& index) {
+    uint64_t next_id = 0;
+    for (; next_id < LIVE_OBJECTS; ++next_id) {
+        index.emplace(next_id, next_id);
+    }
+    const uint64_t before = thread_allocation_count();
+
+    for (auto _ : state) {
+        index.erase(next_id - LIVE_OBJECTS);
+        index.emplace(next_id, next_id);
+        ++next_id;
+    }
+    report_allocations(state, before);
+}
+
+void BM_IndexDefaultAllocator(benchmark::State& state) {
+    std::unordered_map<uint64_t, uint64_t> index;
+    index.reserve(LIVE_OBJECTS * 2);
+    run_index_churn(state, index);
+}
+BENCHMARK(BM_IndexDefaultAllocator);
+
+void BM_IndexPoolAllocator(benchmark::State& state) {
+    using Node = std::pair<const uint64_t, uint64_t>;
+    FixedBlockPool nodes(32, LIVE_OBJECTS * 2);
+    std::unordered_map<uint64_t, uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>, PoolAllocator<Node>> index(
+        0, std::hash<uint64_t>(), std::equal_to<uint64_t>(), PoolAllocator<Node>(nodes));
+    index.reserve(LIVE_OBJECTS * 2);
+    run_index_churn(state, index);
+}
+BENCHMARK(BM_IndexPoolAllocator);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,208 @@
+// Microbenchmarks for the compressed tick archive: encode speed and
+// compression ratio of each codec on two shapes of history, single and
+// block-parallel decode, and a time-range query that the block index
+// narrows down, against copying the same columns out of a .ticks store.
+//
+// Datasets (first arg): 0 = live ticks (irregular ns timestamps, OHLC equal
+// to price, whole volumes), 1 = one-minute bars (regular timestamps,
+// distinct OHLC, fractional volumes).
+//
+// Build: g++ -std=c++17 -O2 -o archive_benchmarks benchmarks/archive_benchmarks.cpp -lbenchmark -pthread
+// Usage: archive_benchmarks [--benchmark_filter=<regex>] --benchmark_out=run.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../include/load_generator.h"
+#include "../include/tick_archive.h"
+
+namespace {
+
+constexpr size_t RECORDS = 1 << 20;
+constexpr uint64_t NANOS_PER_MINUTE = 60'000'000'000ull;
+
+TickColumns make_dataset(int kind) {
+    TickColumns columns;
+    columns.resize(RECORDS);
+    Xoshiro256 rng(42 + kind);
+    uint64_t timestamp = 1'714'564'800'000'000'000ull;
+    double price = 173.50;
+    for (size_t i = 0; i < RECORDS; ++i) {
+        if (kind == 0) {
+            // Trade prints: bursts microseconds apart, gaps of tens of milliseconds
+            timestamp += rng.below(4) == 0 ? 20'000'000 + rng.below(50'000'000) : 1'000 + rng.below(200'000);
+            price = std::round((price + (static_cast<double>(rng.below(5)) - 2.0) * 0.01) * 100.0) / 100.0;
+            columns.open[i] = columns.high[i] = columns.low[i] = columns.close[i] = price;
+            columns.volume[i] = static_cast<double>(1 + rng.below(500) * 100);
+        } else {
+            timestamp += NANOS_PER_MINUTE;
+            const double open = price;
+            price = std::round((price + rng.uniform(-0.25, 0.25)) * 100.0) / 100.0;
+            columns.open[i] = open;
+            columns.close[i] = price;
+            columns.high[i] = std::max(open, price) + static_cast<double>(rng.below(10)) * 0.01;
+            columns.low[i] = std::min(open, price) - static_cast<double>(rng.below(10)) * 0.01;
+            columns.volume[i] = std::round(rng.uniform(1000.0, 50000.0) * 1000.0) / 1000.0;
+        }
+        columns.timestamp[i] = timestamp;
+        columns.price[i] = price;
+    }
+    return columns;
+}
+
+const TickColumns& dataset(int kind) {
+    static const TickColumns live = make_dataset(0);
+    static const TickColumns bars = make_dataset(1);
+    return kind == 0 ? live : bars;
+}
+
+// One archive per dataset, written on first use
+const std::string& archive_file(int kind) {
+    static std::string paths[2];
+    std::string& path = paths[kind];
+    if (path.empty()) {
+        path = "/tmp/bench_archive_" + std::to_string(getpid()) + "_" + std::to_string(kind) + ".tka";
+        TickArchiveWriter writer(path, kind == 0 ? "LIVE" : "BARS");
+        compress_tick_range(dataset(kind).range(), writer, 1);
+        writer.finish();
+    }
+    return path;
+}
+
+void BM_ArchiveEncode(benchmark::State& state) {
+    const int kind = static_cast<int>(state.range(0));
+    const TickColumns& columns = dataset(kind);
+    std::vector<uint8_t> encoded;
+    encoded.reserve(RECORDS * TICK_STORE_COLUMN_COUNT * sizeof(uint64_t));
+    for (auto _ : state) {
+        encoded.clear();
+        for (size_t first = 0; first < RECORDS; first += TICK_ARCHIVE_BLOCK_RECORDS) {
+            encode_tick_block(columns.range(first, first + TICK_ARCHIVE_BLOCK_RECORDS), encoded);
+        }
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    const double raw = static_cast<double>(RECORDS * TICK_STORE_COLUMN_COUNT * sizeof(uint64_t));
+    state.counters["ratio"] = raw / static_cast<double>(encoded.size());
+    state.counters["bytes_per_record"] = static_cast<double>(encoded.size()) / RECORDS;
+    state.SetLabel(kind == 0 ? "live" : "bars");
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RECORDS));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw));
+}
+BENCHMARK(BM_ArchiveEncode)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Per-column cost on the live dataset: args are column (0 = timestamp, 6 = price via XOR, 5 = volume varints)
+void BM_ArchiveColumnDecode(benchmark::State& state) {
+    const size_t column = static_cast<size_t>(state.range(0));
+    const TickColumns& columns = dataset(0);
+    const size_t n = TICK_ARCHIVE_BLOCK_RECORDS;
+    std::vector<uint8_t> encoded;
+    if (column == COLUMN_TIMESTAMP) {
+        archive_detail::encode_timestamps(columns.timestamp.data(), n, encoded);
+    } else if (column == COLUMN_VOLUME) {
+        archive_detail::encode_varints(columns.volume.data(), n, encoded);
+    } else {
+        archive_detail::encode_doubles(columns.price.data(), n, encoded);
+    }
+    std::vector<uint64_t> out(n);
+    for (auto _ : state) {
+        if (column == COLUMN_TIMESTAMP) {
+            archive_detail::decode_timestamps(encoded.data(), encoded.size(), n, out.data());
+        } else if (column == COLUMN_VOLUME) {
+            archive_detail::decode_varints(encoded.data(), encoded.size(), n, reinterpret_cast<double*>(out.data()));
+        } else {
+            archive_detail::decode_doubles(encoded.data(), encoded.size(), n, reinterpret_cast<double*>(out.data()));
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bits_per_value"] = static_cast<double>((encoded.size() - TICK_ARCHIVE_STREAM_PADDING) * 8) / n;
+    state.SetLabel(column == COLUMN_TIMESTAMP ? "delta-of-delta" : column == COLUMN_VOLUME ? "varint" : "xor");
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_ArchiveColumnDecode)->Arg(COLUMN_TIMESTAMP)->Arg(COLUMN_PRICE)->Arg(COLUMN_VOLUME);
+
+// Args: dataset, decode threads
+void BM_ArchiveDecode(benchmark::State& state) {
+    const int kind = static_cast<int>(state.range(0));
+    const unsigned threads = static_cast<unsigned>(state.range(1));
+    TickArchiveReader archive(archive_file(kind));
+    TickColumns columns;
+    archive.decode(0, archive.block_count(), columns);  // warmup: first touch of the output
+    for (auto _ : state) {
+        archive.decode(0, archive.block_count(), columns, threads);
+        benchmark::DoNotOptimize(columns.price.data());
+    }
+    state.counters["ratio"] = static_cast<double>(RECORDS * TICK_STORE_COLUMN_COUNT * sizeof(uint64_t)) /
+                              static_cast<double>(archive.file_size());
+    state.SetLabel(kind == 0 ? "live" : "bars");
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RECORDS));
+}
+BENCHMARK(BM_ArchiveDecode)->ArgsProduct({{0, 1}, {1, 2, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// One minute of the live dataset out of ~3 hours: the index limits decoding to a few blocks
+void BM_ArchiveTimeRange(benchmark::State& state) {
+    const TickColumns& columns = dataset(0);
+    TickArchiveReader archive(archive_file(0));
+    const uint64_t begin = columns.timestamp[RECORDS / 2];
+    const uint64_t end = begin + NANOS_PER_MINUTE;
+    size_t records = 0;
+    for (auto _ : state) {
+        const TickColumns range = archive.time_range(begin, end);
+        records = range.size();
+        benchmark::DoNotOptimize(range.price.data());
+    }
+    const auto [first, last] = archive.blocks_in_time(begin, end);
+    state.counters["records"] = static_cast<double>(records);
+    state.counters["blocks_decoded"] = static_cast<double>(last - first);
+    state.counters["blocks_total"] = static_cast<double>(archive.block_count());
+}
+BENCHMARK(BM_ArchiveTimeRange)->Unit(benchmark::kMicrosecond);
+
+// Baseline: the same minute copied out of an uncompressed store's columns
+void BM_StoreTimeRangeCopy(benchmark::State& state) {
+    const TickColumns& columns = dataset(0);
+    const std::string path = "/tmp/bench_store_" + std::to_string(getpid()) + ".ticks";
+    {
+        TickStoreWriter writer(path, "LIVE", RECORDS);
+        for (size_t i = 0; i < RECORDS; ++i) {
+            writer.append(tick_record_at(columns.range(), i));
+        }
+    }
+    TickStoreReader store(path);
+    const uint64_t begin = columns.timestamp[RECORDS / 2];
+    const uint64_t end = begin + NANOS_PER_MINUTE;
+    for (auto _ : state) {
+        const TickRange range = store.time_range(begin, end);
+        TickColumns copy;
+        copy.resize(range.size());
+        std::memcpy(copy.timestamp.data(), range.timestamp.data, range.size() * sizeof(uint64_t));
+        std::memcpy(copy.open.data(), range.open.data, range.size() * sizeof(double));
+        std::memcpy(copy.high.data(), range.high.data, range.size() * sizeof(double));
+        std::memcpy(copy.low.data(), range.low.data, range.size() * sizeof(double));
+        std::memcpy(copy.close.data(), range.close.data, range.size() * sizeof(double));
+        std::memcpy(copy.volume.data(), range.volume.data, range.size() * sizeof(double));
+        std::memcpy(copy.price.data(), range.price.data, range.size() * sizeof(double));
+        benchmark::DoNotOptimize(copy.price.data());
+    }
+    unlink(path.c_str());
+}
+BENCHMARK(BM_StoreTimeRangeCopy)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    for (int kind = 0; kind < 2; ++kind) {
+        unlink(("/tmp/bench_archive_" + std::to_string(getpid()) + "_" + std::to_string(kind) + ".tka").c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Benchmarks for the parameter-sweep backtester: how a sweep scales with
+// worker threads, and what evaluating a batch of parameter sets per pass
+// over the price column saves against one pass per parameter set.
+//
+// The data is three synthetic symbols of 1M ticks each, written as tick
+// stores under /tmp. Scaling is only meaningful up to the number of
+// physical cores in the machine; beyond that the threads share cores.
+//
+// Build: g++ -std=c++17 -O2 -o backtest_benchmarks benchmarks/backtest_benchmarks.cpp -lbenchmark -pthread
+// Usage: backtest_benchmarks [--benchmark_filter=<regex>] --benchmark_out=run.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../include/backtest.h"
+#include "../include/load_generator.h"
+
+namespace {
+
+constexpr size_t RECORDS = 1 << 20;
+const std::vector<std::string> SYMBOLS = {"BTC", "AAPL", "TSLA"};
+
+const std::string& data_dir() {
+    static std::string dir;
+    if (dir.empty()) {
+        dir = "/tmp/bench_backtest_" + std::to_string(getpid());
+        std::filesystem::create_directories(dir);
+        for (size_t s = 0; s < SYMBOLS.size(); ++s) {
+            TickStoreWriter writer(dir + "/" + SYMBOLS[s] + ".ticks", SYMBOLS[s].c_str(), RECORDS);
+            Xoshiro256 rng(7 + s);
+            TickRecord record;
+            record.timestamp = 1'714'564'800'000'000'000ull;
+            double price = 100.0 * (s + 1);
+            for (size_t i = 0; i < RECORDS; ++i) {
+                record.timestamp += 1'000'000 + rng.below(50'000'000);
+                price *= 1.0 + rng.uniform(-0.001, 0.001);
+                record.open = record.high = record.low = record.close = record.price = price;
+                record.volume = static_cast<double>(1 + rng.below(100));
+                writer.append(record);
+            }
+        }
+    }
+    return dir;
+}
+
+BacktestOptions sweep_options(unsigned threads, size_t per_job) {
+    BacktestOptions options;
+    options.data_dir = data_dir();
+    options.symbols = SYMBOLS;
+    options.params = sma_cross_grid(parse_window_range("5:40:5"), parse_window_range("50:400:50"));  // 64 sets
+    options.threads = threads;
+    options.params_per_job = per_job;
+    return options;
+}
+
+// Arg: worker threads
+void BM_BacktestSweep(benchmark::State& state) {
+    const BacktestOptions options = sweep_options(static_cast<unsigned>(state.range(0)), BACKTEST_PARAMS_PER_JOB);
+    uint64_t strategy_ticks = 0;
+    for (auto _ : state) {
+        const BacktestReport report = run_backtest(options);
+        strategy_ticks = report.strategy_ticks;
+        benchmark::DoNotOptimize(report.combined.data());
+    }
+    state.counters["hardware_threads"] = std::thread::hardware_concurrency();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * strategy_ticks));
+}
+BENCHMARK(BM_BacktestSweep)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Arg: parameter sets per job, single thread
+void BM_BacktestBatch(benchmark::State& state) {
+    const BacktestOptions options = sweep_options(1, static_cast<size_t>(state.range(0)));
+    uint64_t strategy_ticks = 0;
+    for (auto _ : state) {
+        const BacktestReport report = run_backtest(options);
+        strategy_ticks = report.strategy_ticks;
+        benchmark::DoNotOptimize(report.combined.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * strategy_ticks));
+}
+BENCHMARK(BM_BacktestBatch)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    std::filesystem::remove_all("/tmp/bench_backtest_" + std::to_string(getpid()));
+    return 0;
+}
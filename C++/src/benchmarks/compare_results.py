@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+Compare Results - diff two shm_benchmarks JSON runs (--benchmark_out_format=json)
+Prints time per iteration and every counter side by side, and exits 1 when any
+benchmark got slower than --threshold percent, so CI can gate on it.
+
+Usage: python3 compare_results.py baseline.json run.json [--threshold 10]
+"""
+import argparse
+import json
+import sys
+
+TIME_UNITS_NS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+BENCHMARK_KEYS = {'name', 'family_index', 'per_family_instance_index', 'run_name', 'run_type', 'repetitions',
+                  'repetition_index', 'threads', 'iterations', 'real_time', 'cpu_time', 'time_unit', 'label',
+                  'aggregate_name', 'aggregate_unit', 'error_occurred', 'error_message'}
+
+# Counters where a larger value is the regression
+LOWER_IS_BETTER = ('one_way', 'p50_ns', 'p99_ns', 'p999_ns', 'retries_per_read', 'dropped_pct')
+
+def load_run(path: str) -> dict:
+    """name -> {'time_ns': ..., counters...}, skipping aggregate rows"""
+    with open(path) as f:
+        report = json.load(f)
+    results = {}
+    for bench in report['benchmarks']:
+        if bench.get('run_type') == 'aggregate':
+            continue
+        entry = {'time_ns': bench['real_time'] * TIME_UNITS_NS[bench.get('time_unit', 'ns')]}
+        entry.update({key: value for key, value in bench.items()
+                      if key not in BENCHMARK_KEYS and isinstance(value, (int, float))})
+        results[bench['name']] = entry
+    return results
+
+def change_pct(before: float, after: float) -> float:
+    return (after - before) / before * 100.0 if before else 0.0
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline')
+    parser.add_argument('run')
+    parser.add_argument('--threshold', type=float, default=10.0, help='regression threshold in percent')
+    args = parser.parse_args()
+
+    baseline = load_run(args.baseline)
+    run = load_run(args.run)
+    regressions = []
+
+    print(f"{'benchmark':<44}{'metric':<18}{'baseline':>14}{'run':>14}{'change':>10}")
+    for name, after in run.items():
+        before = baseline.get(name)
+        if before is None:
+            print(f"{name:<44}{'(new)':<18}")
+            continue
+        for metric, value in after.items():
+            if metric not in before:
+                continue
+            delta = change_pct(before[metric], value)
+            worse = delta if metric == 'time_ns' or metric.startswith(LOWER_IS_BETTER) else -delta
+            flag = ' !' if worse > args.threshold else ''
+            if flag:
+                regressions.append(f"{name} {metric}")
+            print(f"{name:<44}{metric:<18}{before[metric]:>14.4g}{value:>14.4g}{delta:>+9.1f}%{flag}")
+    for name in baseline.keys() - run.keys():
+        print(f"{name:<44}{'(missing)':<18}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) over {args.threshold:.0f}%:")
+        for regression in regressions:
+            print(f"  {regression}")
+        sys.exit(1)
+    print(f"\nNo regressions over {args.threshold:.0f}%")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,105 @@
+// Microbenchmarks for the feed handler's JSON path: the structural
+// classifier per instruction set, and full parse plus field extraction
+// for a Coinbase ticker message and a Yahoo chart response.
+//
+// Build: g++ -std=c++17 -O2 -o feed_benchmarks benchmarks/feed_benchmarks.cpp -lbenchmark -pthread
+// Usage: feed_benchmarks [--benchmark_filter=<regex>] --benchmark_out=run.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "../include/json_scanner.h"
+
+namespace {
+
+const std::string TICKER =
+    R"({"type":"ticker","sequence":37475248783,"product_id":"BTC-USD","price":"64123.45","open_24h":"63010.00",)"
+    R"("volume_24h":"9876.54321","low_24h":"62800.01","high_24h":"64500.00","volume_30d":"312345.6789",)"
+    R"("best_bid":"64123.44","best_bid_size":"0.12","best_ask":"64123.46","best_ask_size":"0.5","side":"buy",)"
+    R"("time":"2024-05-01T12:00:01.123456Z","trade_id":560012345,"last_size":"0.0042"})";
+
+// A day of one-minute bars, the shape of /v8/finance/chart
+std::string make_chart() {
+    std::string closes;
+    std::string volumes;
+    for (int i = 0; i < 390; ++i) {
+        closes += (i ? "," : "") + std::to_string(170.0 + i * 0.01);
+        volumes += (i ? "," : "") + std::to_string(10000 + i);
+    }
+    return R"({"chart":{"result":[{"meta":{"currency":"USD","symbol":"AAPL","exchangeName":"NMS",)"
+           R"("regularMarketPrice":173.5,"regularMarketTime":1714564800,"regularMarketVolume":51234567},)"
+           R"("indicators":{"quote":[{"close":[)" + closes + R"(],"volume":[)" + volumes + R"(]}]}}],"error":null}})";
+}
+
+// Arg 0 = scalar, 1 = SSE2, 2 = AVX2
+void BM_JsonClassify(benchmark::State& state) {
+    const std::string chart = make_chart();
+    const size_t blocks = chart.size() / 64;
+    const int kernel = static_cast<int>(state.range(0));
+#if defined(__x86_64__)
+    if (kernel == 2 && !json_detail::cpu_has_avx2()) {
+        state.SkipWithError("no AVX2");
+        return;
+    }
+#else
+    if (kernel != 0) {
+        state.SkipWithError("x86-64 only");
+        return;
+    }
+#endif
+    for (auto _ : state) {
+        uint64_t structurals = 0;
+        for (size_t b = 0; b < blocks; ++b) {
+            json_detail::BlockMasks masks;
+            const char* block = chart.data() + b * 64;
+#if defined(__x86_64__)
+            if (kernel == 2) {
+                json_detail::classify_avx2(block, masks);
+            } else if (kernel == 1) {
+                json_detail::classify_sse2(block, masks);
+            } else
+#endif
+            {
+                json_detail::classify_scalar(block, masks);
+            }
+            structurals += masks.structural;
+        }
+        benchmark::DoNotOptimize(structurals);
+    }
+    state.SetLabel(kernel == 2 ? "avx2" : kernel == 1 ? "sse2" : "scalar");
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * blocks * 64));
+}
+BENCHMARK(BM_JsonClassify)->Arg(0)->Arg(1)->Arg(2);
+
+void BM_JsonParseTicker(benchmark::State& state) {
+    JsonParser parser;
+    for (auto _ : state) {
+        parser.parse(TICKER);
+        benchmark::DoNotOptimize(parser["type"] == "ticker");
+        benchmark::DoNotOptimize(parser["product_id"].text());
+        benchmark::DoNotOptimize(parser["price"].as_double());
+        benchmark::DoNotOptimize(parser["last_size"].as_double());
+        benchmark::DoNotOptimize(parse_iso8601_ns(parser["time"].text()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * TICKER.size()));
+}
+BENCHMARK(BM_JsonParseTicker);
+
+void BM_JsonParseChart(benchmark::State& state) {
+    const std::string chart = make_chart();
+    JsonParser parser;
+    for (auto _ : state) {
+        parser.parse(chart);
+        const JsonValue meta = parser["chart"]["result"][0]["meta"];
+        benchmark::DoNotOptimize(meta["regularMarketPrice"].as_double());
+        benchmark::DoNotOptimize(meta["regularMarketTime"].as_int64());
+    }
+    state.counters["tokens"] = static_cast<double>(parser.tape_size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * chart.size()));
+}
+BENCHMARK(BM_JsonParseChart);
+
+}  // namespace
+
+BENCHMARK_MAIN();
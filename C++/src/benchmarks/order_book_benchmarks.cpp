@@ -0,0 +1,107 @@
+// Microbenchmarks for the order book engine: delta application rate for
+// L3 and L2 books over synthetic order flow, and the cost of publishing
+// and reading one book's depth through its seqlock slot. BM_BookApply also
+// reports the heap allocations per delta in its timed loop.
+//
+// Build: g++ -std=c++17 -O2 -o order_book_benchmarks benchmarks/order_book_benchmarks.cpp -lbenchmark -pthread
+// Usage: order_book_benchmarks [--benchmark_filter=<regex>] --benchmark_out=run.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include "../include/order_book.h"
+#include "../include/memory_pool.h"
+
+TRADING_COUNT_ALLOCATIONS();
+
+namespace {
+
+constexpr size_t FLOW_SYMBOLS = 64;
+constexpr size_t FLOW_TICKS = 250000;
+
+// About a million deltas: FLOW_TICKS random-walk ticks spread over FLOW_SYMBOLS
+std::vector<OrderEvent> make_flow(bool l3) {
+    SyntheticOrderFlow flow(42, l3);
+    Xoshiro256 rng(7);
+    std::vector<double> prices(FLOW_SYMBOLS, 100.0);
+    std::vector<OrderEvent> events;
+    for (size_t i = 0; i < FLOW_TICKS; ++i) {
+        TradingTick tick;
+        tick.symbol_index = static_cast<uint16_t>(rng.below(FLOW_SYMBOLS));
+        prices[tick.symbol_index] += rng.uniform(-0.05, 0.05);
+        tick.price = prices[tick.symbol_index];
+        tick.timestamp = i;
+        tick.valid = true;
+        flow.on_tick(tick, [&events](const OrderEvent& event) { events.push_back(event); });
+    }
+    return events;
+}
+
+// Arg 1 = L3 books, 0 = L2. The flow is replayed from empty books each time it runs out.
+void BM_BookApply(benchmark::State& state) {
+    const bool l3 = state.range(0) != 0;
+    const std::vector<OrderEvent> events = make_flow(l3);
+    auto table = std::make_unique<OrderBooks>();
+    auto engine = std::make_unique<BookEngine>(table.get(), l3);
+    size_t next = 0;
+    uint64_t allocations = 0;
+    uint64_t allocations_before = thread_allocation_count();
+
+    for (auto _ : state) {
+        if (next == events.size()) {
+            state.PauseTiming();
+            allocations += thread_allocation_count() - allocations_before;
+            engine = std::make_unique<BookEngine>(table.get(), l3);
+            next = 0;
+            allocations_before = thread_allocation_count();
+            state.ResumeTiming();
+        }
+        engine->on_event(events[next++]);
+    }
+    allocations += thread_allocation_count() - allocations_before;
+    state.SetLabel(l3 ? "l3" : "l2");
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["rejected"] = static_cast<double>(engine->rejected());
+    state.counters["allocs_per_delta"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_BookApply)->Arg(1)->Arg(0);
+
+// Snapshot of a book about BOOK_DEPTH levels deep on each side plus the seqlock write
+void BM_BookPublish(benchmark::State& state) {
+    const std::vector<OrderEvent> events = make_flow(true);
+    auto table = std::make_unique<OrderBooks>();
+    BookEngine engine(table.get(), true);
+    for (const OrderEvent& event : events) {
+        engine.on_event(event);
+    }
+    engine.publish();
+    const OrderBook* book = engine.book(0);
+    BookSnapshot snapshot;
+
+    for (auto _ : state) {
+        book->snapshot(snapshot);
+        table->at(0).publish(snapshot);
+    }
+    state.counters["bid_depth"] = static_cast<double>(snapshot.bid_depth);
+    state.counters["ask_depth"] = static_cast<double>(snapshot.ask_depth);
+}
+BENCHMARK(BM_BookPublish);
+
+void BM_BookSnapshotRead(benchmark::State& state) {
+    const std::vector<OrderEvent> events = make_flow(true);
+    auto table = std::make_unique<OrderBooks>();
+    BookEngine engine(table.get(), true);
+    for (const OrderEvent& event : events) {
+        engine.on_event(event);
+    }
+    engine.publish();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table->at(0).snapshot());
+    }
+}
+BENCHMARK(BM_BookSnapshotRead);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,390 @@
+// Microbenchmarks for the shared memory transport: segment attach cost,
+// plain atomic stores against seqlock publish/snapshot, SPSC and broadcast
+// ring throughput and cross-core latency, and futex wakeup latency under
+// each WaitPolicy. Everything runs on real /dev/shm segments.
+//
+// Two-thread benchmarks put the benchmark thread on the first CPU of
+// TRADING_BENCH_CPUS (default "0,1") and its peer(s) on the following ones.
+// Save results as JSON and diff runs with benchmarks/compare_results.py.
+//
+// Build: g++ -std=c++17 -O2 -o shm_benchmarks benchmarks/shm_benchmarks.cpp -lbenchmark -pthread
+// Usage: shm_benchmarks [--benchmark_filter=<regex>] --benchmark_out=run.json --benchmark_out_format=json
+//        python3 benchmarks/compare_results.py baseline.json run.json
+
+#include <benchmark/benchmark.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/shared_code.h"
+#include "../include/market_data_table.h"
+#include "../include/latency.h"
+
+namespace {
+
+// SharedMemory keeps the name pointer, so callers hold the string for its lifetime
+std::string segment_name(const char* tag) {
+    return "/bench_" + std::to_string(getpid()) + "_" + tag;
+}
+
+std::vector<int> bench_cpus() {
+    const char* spec = std::getenv("TRADING_BENCH_CPUS");
+    std::stringstream list(spec ? spec : "0,1");
+    std::vector<int> cpus;
+    for (std::string cpu; std::getline(list, cpu, ',');) {
+        cpus.push_back(std::stoi(cpu));
+    }
+    return cpus;
+}
+
+// role 0 is the benchmark thread, 1.. its peers; wraps when there are fewer CPUs
+void pin_current_thread(size_t role) {
+    static const std::vector<int> cpus = bench_cpus();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[role % cpus.size()], &set);
+    sched_setaffinity(0, sizeof(set), &set);  // best effort: an offline CPU just leaves it unpinned
+}
+
+// Spin like a latency-critical consumer, but yield now and then so a peer
+// sharing the CPU (small VMs, CI runners) still makes progress
+template<typename Predicate>
+void spin_until(Predicate done) {
+    for (uint32_t spins = 0; !done(); ++spins) {
+        if ((spins & 1023) == 1023) {
+            std::this_thread::yield();
+        } else {
+            cpu_relax();
+        }
+    }
+}
+
+TradingTick make_tick(uint64_t i) {
+    TradingTick tick;
+    tick.price = 100.0 + static_cast<double>(i & 1023) * 0.01;
+    tick.timestamp = i;
+    tick.volume = static_cast<int32_t>(i);
+    tick.valid = true;
+    return tick;
+}
+
+// Peer thread that runs body until the benchmark stops it
+class Peer {
+private:
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+
+public:
+    template<typename Body>
+    Peer(size_t role, Body body)
+        : thread_([this, role, body]() mutable {
+              pin_current_thread(role);
+              body(running_);
+          }) {}
+
+    ~Peer() {
+        running_.store(false, std::memory_order_relaxed);
+        thread_.join();
+    }
+};
+
+// --- SharedMemory<T> attach --------------------------------------------------
+
+// shm_open + fstat + mmap + header validation + munmap
+template<typename T>
+void BM_Attach(benchmark::State& state) {
+    const std::string name = segment_name("attach");
+    SharedMemory<T> owner(name.c_str(), true);
+    MappingOptions options;
+    options.populate = state.range(0) != 0;
+
+    for (auto _ : state) {
+        SharedMemory<T> attached(name.c_str(), false, options);
+        benchmark::DoNotOptimize(attached.get());
+    }
+    state.SetLabel(options.populate ? "populate" : "lazy");
+    state.counters["segment_bytes"] = static_cast<double>(SharedMemory<T>::mapped_size());
+}
+BENCHMARK_TEMPLATE(BM_Attach, TradingData)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Attach, TickRing)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Attach, MarketData)->Arg(0)->Arg(1);
+
+// First touch of every page after a lazy attach: the faults populate saves
+void BM_FirstTouch(benchmark::State& state) {
+    const std::string name = segment_name("touch");
+    SharedMemory<MarketData> owner(name.c_str(), true);
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    for (auto _ : state) {
+        SharedMemory<MarketData> attached(name.c_str(), false);
+        const volatile char* bytes = reinterpret_cast<const char*>(attached.get());
+        for (size_t offset = 0; offset < sizeof(MarketData); offset += page) {
+            (void)bytes[offset];
+        }
+    }
+    state.counters["pages"] = static_cast<double>(sizeof(MarketData) / page);
+}
+BENCHMARK(BM_FirstTouch);
+
+// --- Atomic store vs seqlock -------------------------------------------------
+
+void BM_AtomicStoreRelaxed(benchmark::State& state) {
+    const std::string shm_name = segment_name("store");
+    SharedMemory<TradingData> shm(shm_name.c_str(), true);
+    double price = 100.0;
+    for (auto _ : state) {
+        shm->price.store(price, std::memory_order_relaxed);
+        price += 0.01;
+    }
+}
+BENCHMARK(BM_AtomicStoreRelaxed);
+
+void BM_AtomicStoreSeqCst(benchmark::State& state) {
+    const std::string shm_name = segment_name("store");
+    SharedMemory<TradingData> shm(shm_name.c_str(), true);
+    double price = 100.0;
+    for (auto _ : state) {
+        shm->price.store(price, std::memory_order_seq_cst);
+        price += 0.01;
+    }
+}
+BENCHMARK(BM_AtomicStoreSeqCst);
+
+void BM_SeqlockPublish(benchmark::State& state) {
+    const std::string shm_name = segment_name("publish");
+    SharedMemory<TradingData> shm(shm_name.c_str(), true);
+    uint64_t i = 0;
+    for (auto _ : state) {
+        shm->publish(make_tick(i++));
+    }
+}
+BENCHMARK(BM_SeqlockPublish);
+
+void BM_SeqlockSnapshot(benchmark::State& state) {
+    const std::string shm_name = segment_name("snapshot");
+    SharedMemory<TradingData> shm(shm_name.c_str(), true);
+    shm->publish(make_tick(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shm->snapshot());
+    }
+}
+BENCHMARK(BM_SeqlockSnapshot);
+
+// Reader on this core, writer publishing flat out on the peer core: every
+// snapshot misses in cache and some retry
+void BM_SeqlockSnapshotContended(benchmark::State& state) {
+    const std::string shm_name = segment_name("contended");
+    SharedMemory<TradingData> shm(shm_name.c_str(), true);
+    pin_current_thread(0);
+    Peer writer(1, [&shm](std::atomic<bool>& running) {
+        for (uint64_t i = 0; running.load(std::memory_order_relaxed); ++i) {
+            shm->publish(make_tick(i));
+        }
+    });
+
+    uint64_t retries = 0;
+    TradingTick tick;
+    for (auto _ : state) {
+        while (!shm->try_snapshot(tick)) {
+            ++retries;
+        }
+        benchmark::DoNotOptimize(tick);
+    }
+    state.counters["retries_per_read"] = benchmark::Counter(static_cast<double>(retries), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SeqlockSnapshotContended)->UseRealTime();
+
+// --- SPSC tick ring ----------------------------------------------------------
+
+// Producer here, consumer draining in batches on the peer core
+void BM_SpscThroughput(benchmark::State& state) {
+    const std::string shm_name = segment_name("spsc");
+    SharedMemory<TickRing> shm(shm_name.c_str(), true);
+    TickRing* ring = shm.get();
+    pin_current_thread(0);
+    Peer consumer(1, [ring](std::atomic<bool>& running) {
+        TradingTick batch[256];
+        while (running.load(std::memory_order_relaxed) || !ring->empty()) {
+            if (ring->pop_batch(batch, 256) == 0) {
+                cpu_relax();
+            }
+        }
+    });
+
+    uint64_t i = 0;
+    for (auto _ : state) {
+        const TradingTick tick = make_tick(i++);
+        spin_until([&] { return ring->try_push(tick); });
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SpscThroughput)->UseRealTime();
+
+// Ping-pong through two rings; one way is half the round trip
+void BM_SpscLatency(benchmark::State& state) {
+    const std::string ping_name = segment_name("ping");
+    SharedMemory<TickRing> ping(ping_name.c_str(), true);
+    const std::string pong_name = segment_name("pong");
+    SharedMemory<TickRing> pong(pong_name.c_str(), true);
+    TickRing* request = ping.get();
+    TickRing* reply = pong.get();
+    pin_current_thread(0);
+    Peer echo(1, [request, reply](std::atomic<bool>& running) {
+        TradingTick tick;
+        while (running.load(std::memory_order_relaxed)) {
+            if (request->try_pop(tick)) {
+                spin_until([&] { return reply->try_push(tick); });
+            } else {
+                cpu_relax();
+            }
+        }
+    });
+
+    uint64_t i = 0;
+    TradingTick answer;
+    for (auto _ : state) {
+        const TradingTick tick = make_tick(i++);
+        spin_until([&] { return request->try_push(tick); });
+        spin_until([&] { return reply->try_pop(answer); });
+    }
+    state.counters["one_way"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * 2, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_SpscLatency)->UseRealTime();
+
+// --- Broadcast ring ----------------------------------------------------------
+
+// Writer here, range(0) readers polling on the following cores. Readers
+// that can't keep up are lapped, which shows as dropped_pct.
+void BM_BroadcastThroughput(benchmark::State& state) {
+    const std::string shm_name = segment_name("broadcast");
+    SharedMemory<TickBroadcastRing> shm(shm_name.c_str(), true);
+    TickBroadcastRing* ring = shm.get();
+    const size_t readers = static_cast<size_t>(state.range(0));
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<size_t> attached{0};
+
+    pin_current_thread(0);
+    std::vector<std::unique_ptr<Peer>> peers;
+    for (size_t r = 0; r < readers; ++r) {
+        peers.push_back(std::make_unique<Peer>(1 + r, [&](std::atomic<bool>& running) {
+            TickBroadcastReader reader(shm, WaitPolicy::parse("busy-spin"));
+            attached.fetch_add(1);
+            TradingTick batch[256];
+            while (running.load(std::memory_order_relaxed)) {
+                if (reader.poll(batch, 256) == 0) {
+                    cpu_relax();
+                }
+            }
+            received.fetch_add(reader.received());
+            dropped.fetch_add(reader.dropped());
+        }));
+    }
+    spin_until([&] { return attached.load() == readers; });
+
+    uint64_t i = 0;
+    for (auto _ : state) {
+        ring->publish(make_tick(i++));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    peers.clear();
+
+    const double total = static_cast<double>(received.load() + dropped.load());
+    state.counters["dropped_pct"] = total > 0 ? 100.0 * static_cast<double>(dropped.load()) / total : 0.0;
+}
+BENCHMARK(BM_BroadcastThroughput)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+// Publish-to-poll latency of one reader on the peer core, from the ticks'
+// publish_ns stamps, recorded in the same histogram trading_app uses
+void BM_BroadcastLatency(benchmark::State& state) {
+    const std::string shm_name = segment_name("broadcast_latency");
+    SharedMemory<TickBroadcastRing> shm(shm_name.c_str(), true);
+    const std::string latency_shm_name = segment_name("latency");
+    SharedMemory<LatencyTable> latency_shm(latency_shm_name.c_str(), true);
+    TickBroadcastRing* ring = shm.get();
+    std::atomic<uint64_t> consumed{0};
+    std::atomic<bool> attached{false};
+
+    pin_current_thread(0);
+    {
+        Peer reader_thread(1, [&](std::atomic<bool>& running) {
+            TickBroadcastReader reader(shm, WaitPolicy::parse("busy-spin"));
+            auto local = std::make_unique<LatencyRecorder>(latency_shm, "bench-reader");
+            attached.store(true);
+            TradingTick tick;
+            while (running.load(std::memory_order_relaxed)) {
+                if (reader.poll(&tick, 1) == 1) {
+                    local->record(tick, monotonic_ns());
+                    consumed.fetch_add(1, std::memory_order_release);
+                } else {
+                    cpu_relax();
+                }
+            }
+            const LatencySummary summary = summarize_latency(local->histogram());
+            state.counters["p50_ns"] = static_cast<double>(summary.p50_ns);
+            state.counters["p99_ns"] = static_cast<double>(summary.p99_ns);
+            state.counters["p999_ns"] = static_cast<double>(summary.p999_ns);
+        });
+        spin_until([&] { return attached.load(); });
+
+        // One tick in flight at a time, so the stamp measures transport, not queueing
+        uint64_t i = 0;
+        for (auto _ : state) {
+            TradingTick tick = make_tick(i);
+            tick.publish_ns = monotonic_ns();
+            ring->publish(tick);
+            ++i;
+            spin_until([&] { return consumed.load(std::memory_order_acquire) == i; });
+        }
+    }
+}
+BENCHMARK(BM_BroadcastLatency)->UseRealTime();
+
+// --- Wakeup latency ----------------------------------------------------------
+
+const char* const WAIT_SPECS[] = {"busy-spin", "spin:20000", "yield", "block"};
+
+// notify() on one segment wakes the peer, which notifies back on a second
+// one: round trip / 2 is the wakeup latency of range(0)'s WaitPolicy
+void BM_WakeupLatency(benchmark::State& state) {
+    const std::string ping_name = segment_name("wake_ping");
+    SharedMemory<TradingData> ping(ping_name.c_str(), true);
+    const std::string pong_name = segment_name("wake_pong");
+    SharedMemory<TradingData> pong(pong_name.c_str(), true);
+    const WaitPolicy policy = WaitPolicy::parse(WAIT_SPECS[state.range(0)]);
+    std::atomic<bool> ready{false};
+
+    pin_current_thread(0);
+    Peer responder(1, [&](std::atomic<bool>& running) {
+        uint32_t epoch = ping.update_epoch();
+        ready.store(true);
+        while (running.load(std::memory_order_relaxed)) {
+            if (ping.wait_for_update(epoch, std::chrono::milliseconds(10), policy)) {
+                epoch = ping.update_epoch();
+                pong.notify();
+            }
+        }
+    });
+    spin_until([&] { return ready.load(); });
+
+    for (auto _ : state) {
+        const uint32_t epoch = pong.update_epoch();
+        ping.notify();
+        while (!pong.wait_for_update(epoch, std::chrono::seconds(1), policy)) {
+        }
+    }
+    state.SetLabel(WAIT_SPECS[state.range(0)]);
+    state.counters["one_way"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * 2, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_WakeupLatency)->DenseRange(0, 3)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
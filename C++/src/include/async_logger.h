@@ -0,0 +1,128 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include "shared_code.h"  // SharedRingBuffer
+
+// Log lines off the hot path. The logging thread formats a line into a
+// fixed-size record and pushes it onto an in-process SPSC ring; a
+// background thread writes whatever has queued up and flushes stdout once
+// per drain instead of once per line. A token bucket caps the line rate:
+// lines over it, or lines that find the queue full, are counted and
+// reported as suppressed, never waited for. printf() never allocates,
+// blocks or makes a system call.
+//
+// One logging thread per logger, like any SharedRingBuffer producer.
+
+constexpr size_t LOG_LINE_SIZE = 256;
+constexpr size_t LOG_QUEUE_CAPACITY = 1024;
+constexpr double LOG_DEFAULT_RATE = 20.0;    // lines per second
+constexpr double LOG_DEFAULT_BURST = 50.0;   // lines allowed at once after a quiet spell
+constexpr auto LOG_FLUSH_INTERVAL = std::chrono::milliseconds(20);
+
+struct LogLine {
+    uint32_t length = 0;
+    char text[LOG_LINE_SIZE - sizeof(uint32_t)];
+};
+
+class AsyncLogger {
+private:
+    using Queue = SharedRingBuffer<LogLine, LOG_QUEUE_CAPACITY>;
+
+    std::unique_ptr<Queue> queue_;
+    FILE* out_;
+    double rate_;
+    double burst_;
+    double tokens_;
+    std::chrono::steady_clock::time_point refilled_;
+    std::atomic<uint64_t> suppressed_{0};   // logging thread only
+    std::atomic<uint64_t> written_{0};      // writer thread only
+    std::atomic<bool> stopping_{false};
+    std::thread writer_;
+
+    void write_pending(uint64_t& reported_suppressed) {
+        LogLine batch[64];
+        size_t count;
+        bool wrote = false;
+        while ((count = queue_->pop_batch(batch, 64)) > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                std::fwrite(batch[i].text, 1, batch[i].length, out_);
+                std::fputc('\n', out_);
+            }
+            written_.store(written_.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+            wrote = true;
+        }
+        const uint64_t suppressed = suppressed_.load(std::memory_order_relaxed);
+        if (suppressed != reported_suppressed) {
+            std::fprintf(out_, "(%llu log lines suppressed)\n",
+                         static_cast<unsigned long long>(suppressed - reported_suppressed));
+            reported_suppressed = suppressed;
+            wrote = true;
+        }
+        if (wrote) {
+            std::fflush(out_);
+        }
+    }
+
+    void run() {
+        uint64_t reported_suppressed = 0;
+        while (!stopping_.load(std::memory_order_acquire)) {
+            write_pending(reported_suppressed);
+            std::this_thread::sleep_for(LOG_FLUSH_INTERVAL);
+        }
+        write_pending(reported_suppressed);
+    }
+
+public:
+    explicit AsyncLogger(double rate = LOG_DEFAULT_RATE, double burst = LOG_DEFAULT_BURST, FILE* out = stdout)
+        : queue_(std::make_unique<Queue>()), out_(out), rate_(rate), burst_(std::max(burst, 1.0)), tokens_(burst_),
+          refilled_(std::chrono::steady_clock::now()) {
+        writer_ = std::thread(&AsyncLogger::run, this);
+    }
+
+    // Writes out what is queued before returning
+    ~AsyncLogger() {
+        stopping_.store(true, std::memory_order_release);
+        writer_.join();
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // Queues one line (no trailing newline needed); false if it was suppressed.
+    // Lines longer than LOG_LINE_SIZE - 5 characters are truncated.
+    __attribute__((format(printf, 2, 3))) bool printf(const char* format, ...) {
+        const auto now = std::chrono::steady_clock::now();
+        tokens_ = std::min(burst_, tokens_ + rate_ * std::chrono::duration<double>(now - refilled_).count());
+        refilled_ = now;
+        if (tokens_ < 1.0) {
+            suppressed_.store(suppressed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        LogLine line;
+        va_list args;
+        va_start(args, format);
+        const int length = std::vsnprintf(line.text, sizeof(line.text), format, args);
+        va_end(args);
+        line.length = static_cast<uint32_t>(std::clamp<int>(length, 0, sizeof(line.text) - 1));
+        if (!queue_->try_push(line)) {
+            suppressed_.store(suppressed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        tokens_ -= 1.0;
+        return true;
+    }
+
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t suppressed() const { return suppressed_.load(std::memory_order_relaxed); }
+};
+
+#endif // ASYNC_LOGGER_H
@@ -0,0 +1,304 @@
+#ifndef BACKTEST_H
+#define BACKTEST_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "replay.h"             // find_tick_store
+#include "tick_store.h"
+#include "work_stealing_pool.h"
+
+// Parameter sweeps over recorded history: every (symbol, parameter set)
+// pair is backtested against the symbol's binary tick store. A job is one
+// symbol and a batch of parameter sets, run in a single pass over the
+// symbol's price column so the data is streamed once per batch instead of
+// once per strategy. Jobs run on a work-stealing pool; each worker maps
+// the stores itself and writes into result slots no other job touches, so
+// nothing mutable is shared until the reduction at the end.
+
+constexpr size_t BACKTEST_PARAMS_PER_JOB = 16;
+constexpr uint64_t BACKTEST_RESUM_INTERVAL = 65536;  // ticks between exact window sums
+
+// Moving-average crossover: long while the fast mean is above the slow
+// one, short (or flat when long_only) while it is below
+struct SmaCrossParams {
+    uint32_t fast = 0;
+    uint32_t slow = 0;
+};
+
+struct BacktestOptions {
+    std::string data_dir = "market_data";
+    std::vector<std::string> symbols;
+    std::vector<SmaCrossParams> params;
+    double cost_bps = 1.0;       // charged per unit of position change
+    bool long_only = false;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t params_per_job = BACKTEST_PARAMS_PER_JOB;
+};
+
+struct BacktestResult {
+    double total_return = 0.0;   // compounded, net of costs
+    double max_drawdown = 0.0;   // largest peak-to-trough fall of equity, as a fraction
+    uint64_t trades = 0;         // position changes
+    uint64_t exposed_ticks = 0;  // ticks held with a non-zero position
+    uint64_t ticks = 0;
+};
+
+struct BacktestReport {
+    std::vector<std::string> symbols;
+    std::vector<SmaCrossParams> params;
+    std::vector<BacktestResult> results;   // [symbol * params.size() + param]
+    std::vector<BacktestResult> combined;  // per param: mean return, worst drawdown, summed counts
+    uint64_t ticks = 0;                    // records read, summed over jobs
+    uint64_t strategy_ticks = 0;           // ticks × strategies evaluated
+    double seconds = 0.0;
+    std::vector<uint64_t> jobs_per_worker;
+    std::vector<uint64_t> steals_per_worker;
+
+    const BacktestResult& result(size_t symbol, size_t param) const { return results[symbol * params.size() + param]; }
+
+    // Parameter indices by combined return, best first
+    std::vector<size_t> ranking() const {
+        std::vector<size_t> order(params.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return combined[a].total_return > combined[b].total_return;
+        });
+        return order;
+    }
+};
+
+// "5:50:5" (first:last:step, inclusive) or a single value
+inline std::vector<uint32_t> parse_window_range(const std::string& spec) {
+    try {
+        size_t used = 0;
+        const unsigned long first = std::stoul(spec, &used);
+        unsigned long last = first;
+        unsigned long step = 1;
+        if (used < spec.size()) {
+            if (spec[used] != ':') {
+                throw std::invalid_argument(spec);
+            }
+            const std::string rest = spec.substr(used + 1);
+            last = std::stoul(rest, &used);
+            if (used < rest.size()) {
+                if (rest[used] != ':') {
+                    throw std::invalid_argument(spec);
+                }
+                step = std::stoul(rest.substr(used + 1));
+            }
+        }
+        if (first == 0 || last < first || step == 0) {
+            throw std::invalid_argument(spec);
+        }
+        std::vector<uint32_t> windows;
+        for (unsigned long w = first; w <= last; w += step) {
+            windows.push_back(static_cast<uint32_t>(w));
+        }
+        return windows;
+    } catch (const std::logic_error&) {
+        throw std::runtime_error("Invalid window range: " + spec + " (use first:last:step)");
+    }
+}
+
+// Every fast/slow pair with fast < slow
+inline std::vector<SmaCrossParams> sma_cross_grid(const std::vector<uint32_t>& fast, const std::vector<uint32_t>& slow) {
+    std::vector<SmaCrossParams> grid;
+    for (uint32_t s : slow) {
+        for (uint32_t f : fast) {
+            if (f < s) {
+                grid.push_back({f, s});
+            }
+        }
+    }
+    return grid;
+}
+
+namespace backtest_detail {
+
+// Running state of one strategy in a batch
+struct SmaCrossState {
+    double fast_sum = 0.0;
+    double slow_sum = 0.0;
+    double fast_scale = 0.0;  // 1 / window
+    double slow_scale = 0.0;
+    double equity = 1.0;
+    double peak = 1.0;
+    int position = 0;
+    BacktestResult result;
+};
+
+inline void resum(SmaCrossState& s, const SmaCrossParams& p, const double* prices, uint64_t t) {
+    s.fast_sum = 0.0;
+    for (uint64_t i = t + 1 - p.fast; i <= t; ++i) {
+        s.fast_sum += prices[i];
+    }
+    s.slow_sum = 0.0;
+    for (uint64_t i = t + 1 - p.slow; i <= t; ++i) {
+        s.slow_sum += prices[i];
+    }
+}
+
+// One pass over prices for every strategy in params; results in the same order
+inline void run_sma_cross_batch(const ColumnSpan<double>& prices, const SmaCrossParams* params, size_t count,
+                                double cost_bps, bool long_only, BacktestResult* out) {
+    const uint64_t n = prices.size;
+    const double cost = cost_bps * 1e-4;
+    const double* p = prices.data;
+    std::vector<SmaCrossState> states(count);
+    for (size_t k = 0; k < count; ++k) {
+        states[k].fast_scale = 1.0 / params[k].fast;
+        states[k].slow_scale = 1.0 / params[k].slow;
+    }
+
+    // Windows fill from the start of the data and each strategy begins
+    // trading once its slow window is full. Running sums are recomputed
+    // exactly at fixed ticks, so a result does not depend on which batch
+    // the parameter set landed in.
+    for (uint64_t t = 0; t < n; ++t) {
+        const double price = p[t];
+        const double change = t > 0 && p[t - 1] != 0.0 ? price / p[t - 1] - 1.0 : 0.0;
+        const bool resum_tick = t > 0 && t % BACKTEST_RESUM_INTERVAL == 0;
+        for (size_t k = 0; k < count; ++k) {
+            SmaCrossState& s = states[k];
+            const SmaCrossParams& prm = params[k];
+
+            if (s.position != 0) {
+                s.equity *= 1.0 + s.position * change;
+                ++s.result.exposed_ticks;
+            }
+
+            if (resum_tick && t >= prm.slow) {
+                resum(s, prm, p, t);
+            } else {
+                s.fast_sum += price - (t >= prm.fast ? p[t - prm.fast] : 0.0);
+                s.slow_sum += price - (t >= prm.slow ? p[t - prm.slow] : 0.0);
+            }
+            if (t + 1 < prm.slow) {
+                continue;
+            }
+
+            const double fast_mean = s.fast_sum * s.fast_scale;
+            const double slow_mean = s.slow_sum * s.slow_scale;
+            int target = s.position;
+            if (fast_mean > slow_mean) {
+                target = 1;
+            } else if (fast_mean < slow_mean) {
+                target = long_only ? 0 : -1;
+            }
+            if (target != s.position) {
+                s.equity *= 1.0 - cost * std::abs(target - s.position);
+                s.position = target;
+                ++s.result.trades;
+            }
+            s.peak = std::max(s.peak, s.equity);
+            s.result.max_drawdown = std::max(s.result.max_drawdown, 1.0 - s.equity / s.peak);
+        }
+    }
+
+    for (size_t k = 0; k < count; ++k) {
+        states[k].result.total_return = states[k].equity - 1.0;
+        states[k].result.ticks = n;
+        out[k] = states[k].result;
+    }
+}
+
+}  // namespace backtest_detail
+
+// Runs every symbol × parameter set; the pool is sized by options.threads
+inline BacktestReport run_backtest(const BacktestOptions& options) {
+    if (options.symbols.empty() || options.params.empty()) {
+        throw std::runtime_error("Backtest needs at least one symbol and one parameter set");
+    }
+    for (const SmaCrossParams& p : options.params) {
+        if (p.fast == 0 || p.slow == 0 || p.fast >= p.slow) {
+            throw std::runtime_error("Invalid SMA crossover windows " + std::to_string(p.fast) + "/" +
+                                     std::to_string(p.slow) + " (need 0 < fast < slow)");
+        }
+    }
+
+    BacktestReport report;
+    report.symbols = options.symbols;
+    report.params = options.params;
+    report.results.resize(report.symbols.size() * report.params.size());
+
+    // Resolve paths up front so a missing store fails before any work starts
+    std::vector<std::string> paths;
+    for (const std::string& symbol : options.symbols) {
+        paths.push_back(find_tick_store(options.data_dir, symbol));
+    }
+
+    const unsigned threads = std::max(1u, options.threads);
+    const size_t per_job = std::max<size_t>(1, options.params_per_job);
+    // Worker-local: each worker opens its own mapping of each store it is handed
+    std::vector<std::unordered_map<size_t, std::unique_ptr<TickStoreReader>>> stores(threads);
+    std::vector<uint64_t> ticks(threads, 0);
+    std::vector<std::string> errors(threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(threads);
+        for (size_t symbol = 0; symbol < paths.size(); ++symbol) {
+            for (size_t first = 0; first < report.params.size(); first += per_job) {
+                const size_t count = std::min(per_job, report.params.size() - first);
+                pool.submit([&, symbol, first, count](unsigned worker) {
+                    if (!errors[worker].empty()) {
+                        return;
+                    }
+                    try {
+                        auto& store = stores[worker][symbol];
+                        if (!store) {
+                            store = std::make_unique<TickStoreReader>(paths[symbol]);
+                        }
+                        backtest_detail::run_sma_cross_batch(
+                            store->prices(), &report.params[first], count, options.cost_bps, options.long_only,
+                            &report.results[symbol * report.params.size() + first]);
+                        ticks[worker] += store->size();
+                    } catch (const std::exception& e) {
+                        errors[worker] = paths[symbol] + ": " + e.what();
+                    }
+                });
+            }
+        }
+        pool.wait();
+        for (unsigned w = 0; w < threads; ++w) {
+            report.jobs_per_worker.push_back(pool.executed(w));
+            report.steals_per_worker.push_back(pool.stolen(w));
+        }
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (unsigned w = 0; w < threads; ++w) {
+        if (!errors[w].empty()) {
+            throw std::runtime_error("Backtest failed: " + errors[w]);
+        }
+        report.ticks += ticks[w];
+    }
+
+    // Reduce across symbols per parameter set
+    report.combined.resize(report.params.size());
+    const double weight = 1.0 / report.symbols.size();
+    for (size_t param = 0; param < report.params.size(); ++param) {
+        BacktestResult& total = report.combined[param];
+        for (size_t symbol = 0; symbol < report.symbols.size(); ++symbol) {
+            const BacktestResult& r = report.result(symbol, param);
+            total.total_return += weight * r.total_return;
+            total.max_drawdown = std::max(total.max_drawdown, r.max_drawdown);
+            total.trades += r.trades;
+            total.exposed_ticks += r.exposed_ticks;
+            total.ticks += r.ticks;
+        }
+        report.strategy_ticks += total.ticks;
+    }
+    return report;
+}
+
+#endif // BACKTEST_H
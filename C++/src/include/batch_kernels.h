@@ -0,0 +1,443 @@
+#ifndef BATCH_KERNELS_H
+#define BATCH_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include "tick_store.h"
+
+// Batch indicator kernels for backfilling over whole tick store columns.
+// Each kernel has a scalar, AVX2 and AVX-512 version; batch_kernels()
+// picks the widest one the CPU supports (TRADING_KERNEL_ISA=scalar|avx2|
+// avx512 overrides it). Output conventions follow pandas so results can be
+// compared with the DataFrame path: undefined leading values are NaN.
+//
+// Rolling sums are carried forward incrementally, which is a serial
+// dependency; the SIMD versions break it with an in-register prefix scan
+// over (x[i] - x[i-w]) so each vector produces 4 or 8 outputs. Values are
+// centered on a reference price that is reset (and the sums recomputed
+// exactly) every ROLLING_RESYNC_INTERVAL outputs, which keeps sums of
+// squares small and stops rounding error from accumulating.
+
+constexpr size_t ROLLING_RESYNC_INTERVAL = 4096;
+
+enum class KernelIsa { Scalar, Avx2, Avx512 };
+
+inline const char* kernel_isa_name(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::Avx512: return "avx512";
+        case KernelIsa::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+namespace kernel_detail {
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// Exact centered sums over x[end - window + 1, end]
+inline void window_sums(const double* x, size_t end, size_t window, double ref, double& sum, double& sum_sq) {
+    sum = 0.0;
+    sum_sq = 0.0;
+    for (size_t j = end + 1 - window; j <= end; ++j) {
+        const double a = x[j] - ref;
+        sum += a;
+        sum_sq += a * a;
+    }
+}
+
+inline void write_mean_var(double ref, double sum, double sum_sq, double window, double* mean, double* var) {
+    *mean = ref + sum / window;
+    const double v = (sum_sq - sum * sum / window) / (window - 1);
+    *var = window > 1 ? std::max(v, 0.0) : NaN;
+}
+
+inline void returns_scalar(const double* prices, size_t n, double* out) {
+    if (n == 0) {
+        return;
+    }
+    out[0] = NaN;
+    for (size_t i = 1; i < n; ++i) {
+        out[i] = prices[i] / prices[i - 1] - 1.0;
+    }
+}
+
+// Scalar tail of one resync block, also used by the SIMD versions for leftovers
+inline void rolling_block_scalar(const double* x, size_t begin, size_t end, size_t window, double ref,
+                                 double& sum, double& sum_sq, double* mean, double* var) {
+    for (size_t i = begin; i < end; ++i) {
+        const double a = x[i] - ref;
+        const double b = x[i - window] - ref;
+        sum += a - b;
+        sum_sq += a * a - b * b;
+        write_mean_var(ref, sum, sum_sq, static_cast<double>(window), mean + i, var + i);
+    }
+}
+
+// Drives the resync blocks; Block fills outputs (first, end) of one block
+template<typename Block>
+inline void rolling_mean_var_blocks(const double* x, size_t n, size_t window, double* mean, double* var, Block block) {
+    const size_t warmup = std::min(n, window == 0 ? n : window - 1);
+    std::fill(mean, mean + warmup, NaN);
+    std::fill(var, var + warmup, NaN);
+    if (window == 0) {
+        return;
+    }
+    for (size_t first = window - 1; first < n; first += ROLLING_RESYNC_INTERVAL) {
+        const size_t end = std::min(n, first + ROLLING_RESYNC_INTERVAL);
+        const double ref = x[first];
+        double sum, sum_sq;
+        window_sums(x, first, window, ref, sum, sum_sq);
+        write_mean_var(ref, sum, sum_sq, static_cast<double>(window), mean + first, var + first);
+        block(first + 1, end, ref, sum, sum_sq);
+    }
+}
+
+inline void rolling_mean_var_scalar(const double* x, size_t n, size_t window, double* mean, double* var) {
+    rolling_mean_var_blocks(x, n, window, mean, var, [&](size_t begin, size_t end, double ref, double sum, double sum_sq) {
+        rolling_block_scalar(x, begin, end, window, ref, sum, sum_sq, mean, var);
+    });
+}
+
+inline double reduce_sum_scalar(const double* x, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += x[i];
+    }
+    return sum;
+}
+
+inline double reduce_min_scalar(const double* x, size_t n) {
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+        best = std::min(best, x[i]);
+    }
+    return best;
+}
+
+inline double reduce_max_scalar(const double* x, size_t n) {
+    double best = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+        best = std::max(best, x[i]);
+    }
+    return best;
+}
+
+#if defined(__x86_64__)
+// ---- AVX2: 4 doubles per vector ----
+
+__attribute__((target("avx2")))
+inline __m256d prefix_sum_avx2(__m256d v) {
+    // [a b c d] -> [a a+b a+b+c a+b+c+d] in two shift-and-add steps
+    const __m256d shift1 = _mm256_blend_pd(_mm256_permute4x64_pd(v, 0x90), _mm256_setzero_pd(), 0x1);
+    v = _mm256_add_pd(v, shift1);
+    const __m256d shift2 = _mm256_permute2f128_pd(v, v, 0x08);
+    return _mm256_add_pd(v, shift2);
+}
+
+__attribute__((target("avx2")))
+inline void returns_avx2(const double* prices, size_t n, double* out) {
+    if (n == 0) {
+        return;
+    }
+    out[0] = NaN;
+    const __m256d one = _mm256_set1_pd(1.0);
+    size_t i = 1;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d current = _mm256_loadu_pd(prices + i);
+        const __m256d previous = _mm256_loadu_pd(prices + i - 1);
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_div_pd(current, previous), one));
+    }
+    for (; i < n; ++i) {
+        out[i] = prices[i] / prices[i - 1] - 1.0;
+    }
+}
+
+__attribute__((target("avx2")))
+inline void rolling_block_avx2(const double* x, size_t begin, size_t end, size_t window, double ref,
+                               double sum, double sum_sq, double* mean, double* var) {
+    const double w = static_cast<double>(window);
+    const __m256d vref = _mm256_set1_pd(ref);
+    const __m256d inv_w = _mm256_set1_pd(1.0 / w);
+    const __m256d inv_w1 = _mm256_set1_pd(1.0 / (w - 1));
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d carry = _mm256_set1_pd(sum);
+    __m256d carry_sq = _mm256_set1_pd(sum_sq);
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m256d a = _mm256_sub_pd(_mm256_loadu_pd(x + i), vref);
+        const __m256d b = _mm256_sub_pd(_mm256_loadu_pd(x + i - window), vref);
+        const __m256d s = _mm256_add_pd(carry, prefix_sum_avx2(_mm256_sub_pd(a, b)));
+        const __m256d q = _mm256_add_pd(carry_sq, prefix_sum_avx2(
+            _mm256_sub_pd(_mm256_mul_pd(a, a), _mm256_mul_pd(b, b))));
+        _mm256_storeu_pd(mean + i, _mm256_add_pd(vref, _mm256_mul_pd(s, inv_w)));
+        const __m256d v = _mm256_mul_pd(_mm256_sub_pd(q, _mm256_mul_pd(_mm256_mul_pd(s, s), inv_w)), inv_w1);
+        _mm256_storeu_pd(var + i, _mm256_max_pd(v, zero));
+        carry = _mm256_permute4x64_pd(s, 0xFF);
+        carry_sq = _mm256_permute4x64_pd(q, 0xFF);
+    }
+    sum = _mm256_cvtsd_f64(carry);
+    sum_sq = _mm256_cvtsd_f64(carry_sq);
+    rolling_block_scalar(x, i, end, window, ref, sum, sum_sq, mean, var);
+}
+
+inline void rolling_mean_var_avx2(const double* x, size_t n, size_t window, double* mean, double* var) {
+    rolling_mean_var_blocks(x, n, window, mean, var, [&](size_t begin, size_t end, double ref, double sum, double sum_sq) {
+        rolling_block_avx2(x, begin, end, window, ref, sum, sum_sq, mean, var);
+    });
+    if (window == 1) {
+        std::fill(var, var + n, NaN);
+    }
+}
+
+__attribute__((target("avx2")))
+inline double horizontal_sum_avx2(__m256d v) {
+    const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+__attribute__((target("avx2")))
+inline double reduce_sum_avx2(const double* x, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(x + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(x + i + 4));
+    }
+    return horizontal_sum_avx2(_mm256_add_pd(acc0, acc1)) + reduce_sum_scalar(x + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline double reduce_min_avx2(const double* x, size_t n) {
+    __m256d acc = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_min_pd(acc, _mm256_loadu_pd(x + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    return std::min({lanes[0], lanes[1], lanes[2], lanes[3], reduce_min_scalar(x + i, n - i)});
+}
+
+__attribute__((target("avx2")))
+inline double reduce_max_avx2(const double* x, size_t n) {
+    __m256d acc = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_max_pd(acc, _mm256_loadu_pd(x + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    return std::max({lanes[0], lanes[1], lanes[2], lanes[3], reduce_max_scalar(x + i, n - i)});
+}
+
+// ---- AVX-512: 8 doubles per vector ----
+// GCC 12's avx512fintrin.h trips -Wuninitialized on its own _mm512_undefined_pd() use
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f")))
+inline __m512d prefix_sum_avx512(__m512d v) {
+    v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xFE, _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0), v));
+    v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xFC, _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0), v));
+    return _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xF0, _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0), v));
+}
+
+__attribute__((target("avx512f")))
+inline void returns_avx512(const double* prices, size_t n, double* out) {
+    if (n == 0) {
+        return;
+    }
+    out[0] = NaN;
+    const __m512d one = _mm512_set1_pd(1.0);
+    size_t i = 1;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d current = _mm512_loadu_pd(prices + i);
+        const __m512d previous = _mm512_loadu_pd(prices + i - 1);
+        _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_div_pd(current, previous), one));
+    }
+    for (; i < n; ++i) {
+        out[i] = prices[i] / prices[i - 1] - 1.0;
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void rolling_block_avx512(const double* x, size_t begin, size_t end, size_t window, double ref,
+                                 double sum, double sum_sq, double* mean, double* var) {
+    const double w = static_cast<double>(window);
+    const __m512d vref = _mm512_set1_pd(ref);
+    const __m512d inv_w = _mm512_set1_pd(1.0 / w);
+    const __m512d inv_w1 = _mm512_set1_pd(1.0 / (w - 1));
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512i last_lane = _mm512_set1_epi64(7);
+    __m512d carry = _mm512_set1_pd(sum);
+    __m512d carry_sq = _mm512_set1_pd(sum_sq);
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m512d a = _mm512_sub_pd(_mm512_loadu_pd(x + i), vref);
+        const __m512d b = _mm512_sub_pd(_mm512_loadu_pd(x + i - window), vref);
+        const __m512d s = _mm512_add_pd(carry, prefix_sum_avx512(_mm512_sub_pd(a, b)));
+        const __m512d q = _mm512_add_pd(carry_sq, prefix_sum_avx512(
+            _mm512_sub_pd(_mm512_mul_pd(a, a), _mm512_mul_pd(b, b))));
+        _mm512_storeu_pd(mean + i, _mm512_add_pd(vref, _mm512_mul_pd(s, inv_w)));
+        const __m512d v = _mm512_mul_pd(_mm512_sub_pd(q, _mm512_mul_pd(_mm512_mul_pd(s, s), inv_w)), inv_w1);
+        _mm512_storeu_pd(var + i, _mm512_max_pd(v, zero));
+        carry = _mm512_permutexvar_pd(last_lane, s);
+        carry_sq = _mm512_permutexvar_pd(last_lane, q);
+    }
+    sum = _mm512_cvtsd_f64(carry);
+    sum_sq = _mm512_cvtsd_f64(carry_sq);
+    rolling_block_scalar(x, i, end, window, ref, sum, sum_sq, mean, var);
+}
+
+inline void rolling_mean_var_avx512(const double* x, size_t n, size_t window, double* mean, double* var) {
+    rolling_mean_var_blocks(x, n, window, mean, var, [&](size_t begin, size_t end, double ref, double sum, double sum_sq) {
+        rolling_block_avx512(x, begin, end, window, ref, sum, sum_sq, mean, var);
+    });
+    if (window == 1) {
+        std::fill(var, var + n, NaN);
+    }
+}
+
+__attribute__((target("avx512f")))
+inline double reduce_sum_avx512(const double* x, size_t n) {
+    __m512d acc = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm512_add_pd(acc, _mm512_loadu_pd(x + i));
+    }
+    return _mm512_reduce_add_pd(acc) + reduce_sum_scalar(x + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+inline double reduce_min_avx512(const double* x, size_t n) {
+    __m512d acc = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm512_min_pd(acc, _mm512_loadu_pd(x + i));
+    }
+    return std::min(_mm512_reduce_min_pd(acc), reduce_min_scalar(x + i, n - i));
+}
+
+__attribute__((target("avx512f")))
+inline double reduce_max_avx512(const double* x, size_t n) {
+    __m512d acc = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm512_max_pd(acc, _mm512_loadu_pd(x + i));
+    }
+    return std::max(_mm512_reduce_max_pd(acc), reduce_max_scalar(x + i, n - i));
+}
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace kernel_detail
+
+// One ISA's implementation of every kernel
+struct BatchKernels {
+    KernelIsa isa;
+    // out[i] = prices[i] / prices[i-1] - 1, out[0] = NaN (pandas pct_change)
+    void (*returns)(const double* prices, size_t n, double* out);
+    // Mean and sample variance of the window ending at i; NaN for i < window - 1
+    void (*rolling_mean_var)(const double* x, size_t n, size_t window, double* mean, double* var);
+    double (*reduce_sum)(const double* x, size_t n);
+    double (*reduce_min)(const double* x, size_t n);
+    double (*reduce_max)(const double* x, size_t n);
+};
+
+inline KernelIsa detect_kernel_isa() {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx512f")) {
+        return KernelIsa::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return KernelIsa::Avx2;
+    }
+#endif
+    return KernelIsa::Scalar;
+}
+
+// Widest supported ISA, capped by TRADING_KERNEL_ISA if set
+inline KernelIsa default_kernel_isa() {
+    static const KernelIsa isa = [] {
+        const KernelIsa detected = detect_kernel_isa();
+        const char* requested = std::getenv("TRADING_KERNEL_ISA");
+        if (requested && std::strcmp(requested, "scalar") == 0) {
+            return KernelIsa::Scalar;
+        }
+        if (requested && std::strcmp(requested, "avx2") == 0 && detected != KernelIsa::Scalar) {
+            return KernelIsa::Avx2;
+        }
+        return detected;
+    }();
+    return isa;
+}
+
+// Kernels for isa; falls back to the widest supported one if isa isn't available here
+inline const BatchKernels& batch_kernels(KernelIsa isa = default_kernel_isa()) {
+    using namespace kernel_detail;
+    static const BatchKernels scalar{KernelIsa::Scalar, returns_scalar, rolling_mean_var_scalar,
+                                     reduce_sum_scalar, reduce_min_scalar, reduce_max_scalar};
+#if defined(__x86_64__)
+    static const BatchKernels avx2{KernelIsa::Avx2, returns_avx2, rolling_mean_var_avx2,
+                                   reduce_sum_avx2, reduce_min_avx2, reduce_max_avx2};
+    static const BatchKernels avx512{KernelIsa::Avx512, returns_avx512, rolling_mean_var_avx512,
+                                     reduce_sum_avx512, reduce_min_avx512, reduce_max_avx512};
+    const KernelIsa supported = detect_kernel_isa();
+    if (isa == KernelIsa::Avx512 && supported == KernelIsa::Avx512) {
+        return avx512;
+    }
+    if (isa != KernelIsa::Scalar && supported != KernelIsa::Scalar) {
+        return avx2;
+    }
+#endif
+    return scalar;
+}
+
+// One resampled bar; timestamp is the start of its interval
+struct OhlcBar {
+    uint64_t timestamp = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double volume = 0.0;
+    uint64_t ticks = 0;
+};
+
+// Buckets sorted ticks into interval_ns bars (empty intervals produce no bar).
+// Bucket edges come from binary search; high/low/volume are SIMD reductions.
+inline size_t resample_ohlc(const TickRange& range, uint64_t interval_ns, std::vector<OhlcBar>& out,
+                            const BatchKernels& kernels = batch_kernels()) {
+    const size_t before = out.size();
+    const size_t n = range.size();
+    const uint64_t* timestamps = range.timestamp.data;
+    for (size_t first = 0; first < n;) {
+        const uint64_t bucket = timestamps[first] - timestamps[first] % interval_ns;
+        const size_t last = static_cast<size_t>(
+            std::lower_bound(timestamps + first, timestamps + n, bucket + interval_ns) - timestamps);
+
+        OhlcBar bar;
+        bar.timestamp = bucket;
+        bar.open = range.open[first];
+        bar.high = kernels.reduce_max(range.high.data + first, last - first);
+        bar.low = kernels.reduce_min(range.low.data + first, last - first);
+        bar.close = range.close[last - 1];
+        bar.volume = kernels.reduce_sum(range.volume.data + first, last - first);
+        bar.ticks = last - first;
+        out.push_back(bar);
+        first = last;
+    }
+    return out.size() - before;
+}
+
+#endif // BATCH_KERNELS_H
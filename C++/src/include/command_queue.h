@@ -0,0 +1,135 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "shared_code.h"
+#include "latency.h"      // monotonic_ns
+#include "order_book.h"   // Side
+
+// Control plane in the reverse direction: Python (or any other process)
+// produces fixed-size commands into the /trading_commands SPSC ring and
+// the producer loop drains it without blocking once per batch it
+// publishes, so a command takes effect before the next batch of ticks.
+// The sender bumps the segment's notifier epoch and always issues a futex
+// wake after pushing; the simulated loop waits on that epoch instead of
+// sleeping (as do the load and replay loops), so commands reach it between
+// ticks too.
+//
+// There is exactly one sender at a time: Python holds an exclusive flock
+// on the segment for as long as it is connected.
+
+constexpr size_t COMMAND_RING_CAPACITY = 1024;
+constexpr size_t COMMAND_BATCH = 64;                       // commands applied per poll
+constexpr uint64_t COMMAND_ORDER_ID_BIT = 1ull << 63;      // keeps sender order ids apart from synthetic ones
+// SetRate bounds; values outside them are rejected. The simulated cap keeps its
+// tick interval at 100 us or more, so the loop still sleeps between ticks.
+constexpr double COMMAND_MIN_RATE = 0.01;
+constexpr double COMMAND_MAX_SIMULATED_RATE = 10000.0;
+constexpr double COMMAND_MAX_LOAD_RATE = 1e8;
+
+enum class CommandType : uint16_t {
+    None = 0,
+    Subscribe = 1,     // symbol; value = start price for a new simulated symbol (0 = default)
+    Unsubscribe = 2,   // symbol; its ticks stop being published
+    SetRate = 3,       // value = ticks/s (load mode) or updates/s per symbol (simulated mode)
+    PlaceOrder = 4,    // symbol, side, value = price, quantity, order_id
+    CancelOrder = 5,   // symbol, side, value = price, quantity, order_id
+};
+
+struct Command {
+    uint64_t id = 0;                  // sender's sequence number
+    uint64_t sent_ns = 0;             // CLOCK_MONOTONIC, as TradingTick::publish_ns
+    double value = 0.0;
+    uint64_t order_id = 0;
+    uint32_t quantity = 0;
+    CommandType type = CommandType::None;
+    Side side = Side::Bid;
+    uint8_t reserved = 0;
+    char symbol[SYMBOL_NAME_SIZE] = {};
+    uint8_t padding[8] = {};
+};
+
+// Python COMMAND_FORMAT 'QQdQIHBx16s8x'
+static_assert(sizeof(Command) == CACHE_LINE_SIZE, "Command fills one cache line");
+static_assert(offsetof(Command, quantity) == 32 && offsetof(Command, type) == 36 && offsetof(Command, side) == 38 &&
+              offsetof(Command, symbol) == 40, "Command layout is mirrored by Python/data_bridge.py");
+
+using CommandRing = SharedRingBuffer<Command, COMMAND_RING_CAPACITY>;
+
+template<>
+struct SegmentLayout<CommandRing> {
+    static constexpr const char* type_name = "CommandRing";
+    static constexpr size_t record_size = sizeof(Command);
+    static constexpr size_t capacity = COMMAND_RING_CAPACITY;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "head", offsetof(CommandRing, head), sizeof(uint64_t));
+        add_segment_field(header, "tail", offsetof(CommandRing, tail), sizeof(uint64_t));
+        add_segment_field(header, "slots", offsetof(CommandRing, slots), sizeof(CommandRing::slots));
+        add_segment_field(header, "record.id", offsetof(Command, id), sizeof(uint64_t));
+        add_segment_field(header, "record.sent_ns", offsetof(Command, sent_ns), sizeof(uint64_t));
+        add_segment_field(header, "record.value", offsetof(Command, value), sizeof(double));
+        add_segment_field(header, "record.order_id", offsetof(Command, order_id), sizeof(uint64_t));
+        add_segment_field(header, "record.quantity", offsetof(Command, quantity), sizeof(uint32_t));
+        add_segment_field(header, "record.type", offsetof(Command, type), sizeof(CommandType));
+        add_segment_field(header, "record.side", offsetof(Command, side), sizeof(Side));
+        add_segment_field(header, "record.symbol", offsetof(Command, symbol), SYMBOL_NAME_SIZE);
+    }
+};
+
+inline const char* command_type_name(CommandType type) {
+    switch (type) {
+    case CommandType::Subscribe: return "subscribe";
+    case CommandType::Unsubscribe: return "unsubscribe";
+    case CommandType::SetRate: return "set-rate";
+    case CommandType::PlaceOrder: return "place-order";
+    case CommandType::CancelOrder: return "cancel-order";
+    default: return "unknown";
+    }
+}
+
+// NUL-terminated copy of the command's symbol, which the sender may fill to all 16 bytes
+inline std::string command_symbol(const Command& command) {
+    return std::string(command.symbol, strnlen(command.symbol, SYMBOL_NAME_SIZE));
+}
+
+// Owned and written by the thread that polls the ring
+struct CommandStats {
+    uint64_t applied = 0;
+    uint64_t rejected = 0;
+    uint64_t last_id = 0;
+    uint64_t last_latency_ns = 0;   // sent_ns to applied
+    uint64_t max_latency_ns = 0;
+};
+
+// Applies whatever is queued, at most COMMAND_BATCH commands, and returns
+// how many it took. apply(command) returns false to reject a command the
+// current mode can't carry out; either way the slot is released. Never
+// blocks, so it can sit on the publishing path.
+template<typename Apply>
+size_t poll_commands(CommandRing& ring, CommandStats& stats, Apply&& apply) {
+    // Usually empty: two loads, and the batch below is never initialized
+    if (ring.empty()) {
+        return 0;
+    }
+    Command batch[COMMAND_BATCH];
+    const size_t count = ring.pop_batch(batch, COMMAND_BATCH);
+    for (size_t i = 0; i < count; ++i) {
+        if (apply(batch[i])) {
+            ++stats.applied;
+        } else {
+            ++stats.rejected;
+        }
+        const uint64_t now = monotonic_ns();
+        stats.last_id = batch[i].id;
+        stats.last_latency_ns = now > batch[i].sent_ns ? now - batch[i].sent_ns : 0;
+        stats.max_latency_ns = std::max(stats.max_latency_ns, stats.last_latency_ns);
+    }
+    return count;
+}
+
+#endif // COMMAND_QUEUE_H
@@ -0,0 +1,1037 @@
+#ifndef FEED_HANDLER_H
+#define FEED_HANDLER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#if defined(TRADING_FEED_TLS)
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#endif
+#include "trading_system.h"
+#include "json_scanner.h"
+#include "load_generator.h"
+
+// Live market data from venue APIs, received inside the producer and
+// published through the same path as simulated ticks. One epoll loop on
+// the producer thread drives every venue connection without blocking:
+// WebSocket streams (Coinbase ticker, Binance trades) and HTTP keep-alive
+// polling (Yahoo chart quotes). Messages are parsed straight out of the
+// receive buffer by JsonParser and each trade or quote becomes a tick.
+//
+//   --feed coinbase:BTC-USD=BTC,ETH-USD=ETH --feed yahoo:AAPL,TSLA
+//   --feed binance@ws://127.0.0.1:9001/:btcusdt=BTC     (base URL override)
+//
+// wss:// and https:// need OpenSSL (TRADING_FEED_TLS, on in the CMake
+// build when OpenSSL is found). Name resolution is a blocking getaddrinfo
+// on each (re)connect, which only happens at startup and after failures;
+// each resolved address is tried in turn before the connection backs off.
+
+enum class FeedVenue : uint8_t { Coinbase, Binance, Yahoo };
+
+inline FeedVenue parse_feed_venue(const std::string& name) {
+    if (name == "coinbase") return FeedVenue::Coinbase;
+    if (name == "binance") return FeedVenue::Binance;
+    if (name == "yahoo") return FeedVenue::Yahoo;
+    throw std::runtime_error("Unknown feed venue: " + name + " (use coinbase, binance or yahoo)");
+}
+
+inline const char* feed_venue_name(FeedVenue venue) {
+    switch (venue) {
+    case FeedVenue::Coinbase: return "coinbase";
+    case FeedVenue::Binance: return "binance";
+    default: return "yahoo";
+    }
+}
+
+// Where a venue's API lives; --feed venue@url replaces it (tests, mirrors)
+inline const char* default_feed_url(FeedVenue venue) {
+    switch (venue) {
+    case FeedVenue::Coinbase: return "wss://ws-feed.exchange.coinbase.com/";
+    case FeedVenue::Binance: return "wss://stream.binance.com:9443/";
+    default: return "https://query1.finance.yahoo.com/";
+    }
+}
+
+struct FeedEndpoint {
+    bool tls = false;
+    bool websocket = false;
+    std::string host;
+    std::string port;
+    std::string path = "/";
+
+    // ws://, wss://, http:// or https://host[:port][/path]
+    static FeedEndpoint parse(const std::string& url) {
+        FeedEndpoint endpoint;
+        const auto scheme_end = url.find("://");
+        const std::string scheme = scheme_end == std::string::npos ? "" : url.substr(0, scheme_end);
+        if (scheme == "ws" || scheme == "wss") {
+            endpoint.websocket = true;
+        } else if (scheme != "http" && scheme != "https") {
+            throw std::runtime_error("Feed URL needs a ws, wss, http or https scheme: " + url);
+        }
+        endpoint.tls = scheme == "wss" || scheme == "https";
+        const std::string rest = url.substr(scheme_end + 3);
+        const auto slash = rest.find('/');
+        const std::string authority = rest.substr(0, slash);
+        endpoint.path = slash == std::string::npos ? "/" : rest.substr(slash);
+        const auto colon = authority.rfind(':');
+        endpoint.host = authority.substr(0, colon);
+        endpoint.port = colon == std::string::npos ? (endpoint.tls ? "443" : "80") : authority.substr(colon + 1);
+        if (endpoint.host.empty()) {
+            throw std::runtime_error("Feed URL has no host: " + url);
+        }
+        return endpoint;
+    }
+};
+
+struct FeedSymbol {
+    std::string venue_symbol;   // as the venue spells it, "BTC-USD"
+    std::string name;           // MarketDataTable symbol, "BTC"
+    int32_t index = -1;
+    uint64_t last_timestamp = 0;
+    double last_price = 0.0;
+};
+
+// One venue connection and the symbols it carries
+struct FeedSubscription {
+    FeedVenue venue = FeedVenue::Coinbase;
+    std::string url;
+    std::vector<FeedSymbol> symbols;
+};
+
+struct FeedOptions {
+    std::vector<FeedSubscription> feeds;
+    std::chrono::milliseconds poll_interval{1000};  // REST venues
+
+    bool enabled() const { return !feeds.empty(); }
+
+    // "venue[@base-url]:SYMBOL[=NAME],..."
+    void add(const std::string& spec) {
+        const auto venue_end = spec.find_first_of("@:");
+        const auto symbols_start = spec.rfind(':');
+        if (venue_end == std::string::npos || symbols_start == std::string::npos || symbols_start + 1 >= spec.size()) {
+            throw std::runtime_error("Invalid feed: " + spec + " (use venue[@url]:SYMBOL[=NAME],...)");
+        }
+        FeedSubscription feed;
+        feed.venue = parse_feed_venue(spec.substr(0, venue_end));
+        feed.url = spec[venue_end] == '@' ? spec.substr(venue_end + 1, symbols_start - venue_end - 1)
+                                          : default_feed_url(feed.venue);
+        FeedEndpoint::parse(feed.url);
+
+        size_t start = symbols_start + 1;
+        while (start <= spec.size()) {
+            const auto comma = std::min(spec.find(',', start), spec.size());
+            const std::string item = spec.substr(start, comma - start);
+            if (!item.empty()) {
+                const auto equals = item.find('=');
+                FeedSymbol symbol;
+                symbol.venue_symbol = item.substr(0, equals);
+                symbol.name = equals == std::string::npos ? symbol.venue_symbol : item.substr(equals + 1);
+                if (feed.venue == FeedVenue::Binance) {
+                    // Stream names are lower case, trade messages upper case
+                    std::transform(symbol.venue_symbol.begin(), symbol.venue_symbol.end(),
+                                   symbol.venue_symbol.begin(), [](unsigned char c) { return std::toupper(c); });
+                }
+                feed.symbols.push_back(symbol);
+            }
+            start = comma + 1;
+        }
+        if (feed.symbols.empty()) {
+            throw std::runtime_error("Feed has no symbols: " + spec);
+        }
+        feeds.push_back(std::move(feed));
+    }
+
+    size_t symbol_count() const {
+        size_t count = 0;
+        for (const auto& feed : feeds) {
+            count += feed.symbols.size();
+        }
+        return count;
+    }
+};
+
+struct FeedStats {
+    uint64_t messages = 0;
+    uint64_t ticks = 0;
+    uint64_t bytes = 0;
+    uint64_t parse_errors = 0;
+    uint64_t reconnects = 0;
+};
+
+namespace feed_detail {
+
+constexpr size_t READ_CHUNK = 16 * 1024;
+constexpr size_t MAX_MESSAGE = 16 * 1024 * 1024;  // one frame, buffered response or reassembled message
+constexpr uint16_t CLOSE_TOO_BIG = 1009;            // WebSocket close code for an oversized message
+constexpr auto CONNECT_TIMEOUT = std::chrono::seconds(10);
+constexpr auto STALE_AFTER = std::chrono::seconds(30);
+constexpr auto MIN_BACKOFF = std::chrono::milliseconds(500);
+constexpr auto MAX_BACKOFF = std::chrono::seconds(30);
+
+inline std::string base64(const uint8_t* data, size_t size) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < size; i += 3) {
+        const uint32_t chunk = (uint32_t{data[i]} << 16) | (i + 1 < size ? uint32_t{data[i + 1]} << 8 : 0) |
+                               (i + 2 < size ? uint32_t{data[i + 2]} : 0);
+        out += alphabet[(chunk >> 18) & 63];
+        out += alphabet[(chunk >> 12) & 63];
+        out += i + 1 < size ? alphabet[(chunk >> 6) & 63] : '=';
+        out += i + 2 < size ? alphabet[chunk & 63] : '=';
+    }
+    return out;
+}
+
+// Case-insensitive header lookup in a raw HTTP header block
+inline std::string_view header_value(std::string_view headers, std::string_view name) {
+    size_t line = headers.find("\r\n");
+    while (line != std::string_view::npos && line + 2 < headers.size()) {
+        const size_t start = line + 2;
+        const size_t end = headers.find("\r\n", start);
+        const std::string_view field = headers.substr(start, end == std::string_view::npos ? end : end - start);
+        if (field.size() > name.size() && field[name.size()] == ':' &&
+            std::equal(name.begin(), name.end(), field.begin(),
+                       [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+            std::string_view value = field.substr(name.size() + 1);
+            while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+            return value;
+        }
+        line = end;
+    }
+    return {};
+}
+
+inline bool contains_token(std::string_view value, std::string_view token) {
+    for (size_t i = 0; i + token.size() <= value.size(); ++i) {
+        if (std::equal(token.begin(), token.end(), value.begin() + static_cast<ptrdiff_t>(i),
+                       [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline uint64_t wall_clock_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace feed_detail
+
+// One venue connection: non-blocking connect, optional TLS, then either a
+// WebSocket stream or a keep-alive HTTP poll, reconnecting with backoff on
+// any failure. Owned and driven by FeedHandler on a single thread.
+class FeedConnection {
+public:
+    using clock = std::chrono::steady_clock;
+    enum class State { Idle, Connecting, Handshaking, Upgrading, Open };
+
+private:
+    FeedSubscription& feed_;
+    FeedEndpoint endpoint_;
+    FeedStats stats_;
+    int epoll_fd_;
+    int fd_ = -1;
+    State state_ = State::Idle;
+    uint32_t events_ = 0;
+#if defined(TRADING_FEED_TLS)
+    SSL_CTX* tls_context_;
+    SSL* tls_ = nullptr;
+#endif
+    Xoshiro256 rng_;
+    JsonParser parser_;
+
+    std::vector<char> in_;            // received bytes [in_begin_, in_end_)
+    size_t in_begin_ = 0;
+    size_t in_end_ = 0;
+    std::string out_;                 // bytes still to send from out_sent_
+    size_t out_sent_ = 0;
+    std::vector<char> message_;       // fragmented WebSocket message or de-chunked HTTP body
+    addrinfo* addresses_ = nullptr;   // resolved for the connect in progress
+    const addrinfo* next_address_ = nullptr;
+
+    clock::time_point deadline_;      // reconnect, connect timeout or next poll
+    clock::time_point last_receive_;
+    std::chrono::milliseconds backoff_ = feed_detail::MIN_BACKOFF;
+    std::chrono::milliseconds poll_interval_;
+    size_t next_poll_symbol_ = 0;
+    bool request_in_flight_ = false;
+
+    void set_events(uint32_t events) {
+        if (events == events_ || fd_ < 0) {
+            return;
+        }
+        epoll_event event{};
+        event.events = events;
+        event.data.ptr = this;
+        epoll_ctl(epoll_fd_, events_ == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd_, &event);
+        events_ = events;
+    }
+
+    void fail(const char* what) {
+        std::cout << "Feed " << feed_venue_name(feed_.venue) << " (" << endpoint_.host << "): " << what
+                  << ", reconnecting in " << backoff_.count() << " ms" << std::endl;
+        close_socket();
+        deadline_ = clock::now() + backoff_;
+        backoff_ = std::min<std::chrono::milliseconds>(backoff_ * 2, feed_detail::MAX_BACKOFF);
+        ++stats_.reconnects;
+    }
+
+    void close_fd() {
+        if (fd_ >= 0) {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd_, nullptr);
+            ::close(fd_);
+            fd_ = -1;
+        }
+        events_ = 0;
+    }
+
+    void free_addresses() {
+        if (addresses_) {
+            freeaddrinfo(addresses_);
+            addresses_ = nullptr;
+        }
+        next_address_ = nullptr;
+    }
+
+    void close_socket() {
+#if defined(TRADING_FEED_TLS)
+        if (tls_) {
+            SSL_free(tls_);
+            tls_ = nullptr;
+        }
+#endif
+        close_fd();
+        free_addresses();
+        state_ = State::Idle;
+        in_begin_ = in_end_ = 0;
+        out_.clear();
+        out_sent_ = 0;
+        message_.clear();
+        request_in_flight_ = false;
+    }
+
+    void start_connect() {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(endpoint_.host.c_str(), endpoint_.port.c_str(), &hints, &addresses_) != 0 || !addresses_) {
+            addresses_ = nullptr;
+            fail("cannot resolve host");
+            return;
+        }
+        next_address_ = addresses_;
+        connect_next("no usable address");
+    }
+
+    // Starts a connect to the next resolved address, skipping those that
+    // fail at once; `error` is why the previous one failed. Only when every
+    // address has failed does the connection back off and count a reconnect.
+    void connect_next(const char* error) {
+        while (next_address_) {
+            const addrinfo* address = next_address_;
+            next_address_ = address->ai_next;
+            close_fd();
+            fd_ = socket(address->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (fd_ < 0) {
+                error = "cannot create socket";
+                continue;
+            }
+            const int one = 1;
+            setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            if (connect(fd_, address->ai_addr, address->ai_addrlen) == 0 || errno == EINPROGRESS) {
+                state_ = State::Connecting;
+                deadline_ = clock::now() + feed_detail::CONNECT_TIMEOUT;
+                set_events(EPOLLOUT);
+                return;
+            }
+            error = std::strerror(errno);
+        }
+        fail(error);
+    }
+
+    // Socket is connected: start TLS or go straight to the protocol
+    bool on_connected() {
+        free_addresses();
+        if (endpoint_.tls) {
+#if defined(TRADING_FEED_TLS)
+            tls_ = SSL_new(tls_context_);
+            SSL_set_fd(tls_, fd_);
+            SSL_set_tlsext_host_name(tls_, endpoint_.host.c_str());
+            SSL_set1_host(tls_, endpoint_.host.c_str());
+            state_ = State::Handshaking;
+            return continue_handshake();
+#else
+            fail("wss/https feeds need a build with TRADING_FEED_TLS");
+            return false;
+#endif
+        }
+        return start_protocol();
+    }
+
+#if defined(TRADING_FEED_TLS)
+    bool continue_handshake() {
+        const int result = SSL_connect(tls_);
+        if (result == 1) {
+            return start_protocol();
+        }
+        const int error = SSL_get_error(tls_, result);
+        if (error == SSL_ERROR_WANT_READ) {
+            set_events(EPOLLIN);
+            return true;
+        }
+        if (error == SSL_ERROR_WANT_WRITE) {
+            set_events(EPOLLIN | EPOLLOUT);
+            return true;
+        }
+        fail("TLS handshake failed");
+        return false;
+    }
+#endif
+
+    bool start_protocol() {
+        last_receive_ = clock::now();
+        if (endpoint_.websocket) {
+            uint8_t key[16];
+            for (size_t i = 0; i < sizeof(key); i += 8) {
+                const uint64_t bits = rng_();
+                std::memcpy(key + i, &bits, 8);
+            }
+            std::string target = endpoint_.path;
+            if (feed_.venue == FeedVenue::Binance) {
+                target += "stream?streams=";
+                for (size_t i = 0; i < feed_.symbols.size(); ++i) {
+                    std::string stream = feed_.symbols[i].venue_symbol;
+                    std::transform(stream.begin(), stream.end(), stream.begin(), [](unsigned char c) { return std::tolower(c); });
+                    target += (i ? "/" : "") + stream + "@trade";
+                }
+            }
+            out_ = "GET " + target + " HTTP/1.1\r\nHost: " + endpoint_.host +
+                   "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: " +
+                   feed_detail::base64(key, sizeof(key)) + "\r\nSec-WebSocket-Version: 13\r\n"
+                   "User-Agent: TradingApp/1.0\r\n\r\n";
+            out_sent_ = 0;
+            state_ = State::Upgrading;
+            deadline_ = clock::now() + feed_detail::CONNECT_TIMEOUT;
+            return flush_output();
+        }
+        state_ = State::Open;
+        backoff_ = feed_detail::MIN_BACKOFF;
+        deadline_ = clock::now();
+        return send_poll();
+    }
+
+    // --- raw I/O -----------------------------------------------------------
+
+    // >0 bytes, 0 would block, <0 closed or failed
+    ssize_t read_some(char* buffer, size_t size) {
+#if defined(TRADING_FEED_TLS)
+        if (tls_) {
+            const int result = SSL_read(tls_, buffer, static_cast<int>(size));
+            if (result > 0) {
+                return result;
+            }
+            const int error = SSL_get_error(tls_, result);
+            return error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE ? 0 : -1;
+        }
+#endif
+        const ssize_t result = recv(fd_, buffer, size, 0);
+        if (result > 0) {
+            return result;
+        }
+        return result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+
+    ssize_t write_some(const char* buffer, size_t size) {
+#if defined(TRADING_FEED_TLS)
+        if (tls_) {
+            const int result = SSL_write(tls_, buffer, static_cast<int>(size));
+            if (result > 0) {
+                return result;
+            }
+            const int error = SSL_get_error(tls_, result);
+            return error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE ? 0 : -1;
+        }
+#endif
+        const ssize_t result = send(fd_, buffer, size, MSG_NOSIGNAL);
+        if (result >= 0) {
+            return result;
+        }
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+    }
+
+    bool flush_output() {
+        while (out_sent_ < out_.size()) {
+            const ssize_t sent = write_some(out_.data() + out_sent_, out_.size() - out_sent_);
+            if (sent < 0) {
+                fail("write failed");
+                return false;
+            }
+            if (sent == 0) {
+                set_events(EPOLLIN | EPOLLOUT);
+                return true;
+            }
+            out_sent_ += static_cast<size_t>(sent);
+        }
+        out_.clear();
+        out_sent_ = 0;
+        set_events(EPOLLIN);
+        return true;
+    }
+
+    // Drains the socket into in_; false once the connection is gone
+    bool fill_input() {
+        for (;;) {
+            if (in_.size() - in_end_ < feed_detail::READ_CHUNK) {
+                if (in_begin_ > 0) {
+                    std::memmove(in_.data(), in_.data() + in_begin_, in_end_ - in_begin_);
+                    in_end_ -= in_begin_;
+                    in_begin_ = 0;
+                }
+                if (in_.size() - in_end_ < feed_detail::READ_CHUNK) {
+                    if (in_.size() >= feed_detail::MAX_MESSAGE) {
+                        fail("message too large");
+                        return false;
+                    }
+                    in_.resize(in_.size() * 2);
+                }
+            }
+            const ssize_t received = read_some(in_.data() + in_end_, in_.size() - in_end_);
+            if (received == 0) {
+                return true;
+            }
+            if (received < 0) {
+                fail("connection closed");
+                return false;
+            }
+            in_end_ += static_cast<size_t>(received);
+            stats_.bytes += static_cast<uint64_t>(received);
+            last_receive_ = clock::now();
+        }
+    }
+
+    // --- WebSocket ---------------------------------------------------------
+
+    void send_frame(uint8_t opcode, const char* payload, size_t size) {
+        out_.push_back(static_cast<char>(0x80 | opcode));
+        if (size < 126) {
+            out_.push_back(static_cast<char>(0x80 | size));
+        } else if (size < 65536) {
+            out_.push_back(static_cast<char>(0x80 | 126));
+            out_.push_back(static_cast<char>(size >> 8));
+            out_.push_back(static_cast<char>(size));
+        } else {
+            out_.push_back(static_cast<char>(0x80 | 127));
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                out_.push_back(static_cast<char>(static_cast<uint64_t>(size) >> shift));
+            }
+        }
+        // Client frames are masked (RFC 6455 5.3)
+        const uint32_t mask = static_cast<uint32_t>(rng_());
+        char mask_bytes[4];
+        std::memcpy(mask_bytes, &mask, 4);
+        out_.append(mask_bytes, 4);
+        for (size_t i = 0; i < size; ++i) {
+            out_.push_back(static_cast<char>(payload[i] ^ mask_bytes[i & 3]));
+        }
+    }
+
+    bool finish_upgrade() {
+        const std::string_view buffered(in_.data() + in_begin_, in_end_ - in_begin_);
+        const auto header_end = buffered.find("\r\n\r\n");
+        if (header_end == std::string_view::npos) {
+            return true;
+        }
+        const std::string_view headers = buffered.substr(0, header_end + 2);
+        if (headers.substr(0, 12).find("101") == std::string_view::npos ||
+            !feed_detail::contains_token(feed_detail::header_value(headers, "Upgrade"), "websocket")) {
+            fail("WebSocket upgrade refused");
+            return false;
+        }
+        in_begin_ += header_end + 4;
+        state_ = State::Open;
+        backoff_ = feed_detail::MIN_BACKOFF;
+
+        if (feed_.venue == FeedVenue::Coinbase) {
+            std::string subscribe = "{\"type\":\"subscribe\",\"channels\":[\"ticker\"],\"product_ids\":[";
+            for (size_t i = 0; i < feed_.symbols.size(); ++i) {
+                subscribe += (i ? ",\"" : "\"") + feed_.symbols[i].venue_symbol + "\"";
+            }
+            subscribe += "]}";
+            send_frame(0x1, subscribe.data(), subscribe.size());
+        }
+        std::cout << "✓ Feed " << feed_venue_name(feed_.venue) << " connected to " << endpoint_.host << " ("
+                  << feed_.symbols.size() << " symbols)" << std::endl;
+        return flush_output();
+    }
+
+    // A frame or reassembled message over MAX_MESSAGE: close with 1009 and reconnect
+    bool close_too_big() {
+        const char code[2] = {static_cast<char>(feed_detail::CLOSE_TOO_BIG >> 8),
+                              static_cast<char>(feed_detail::CLOSE_TOO_BIG & 0xff)};
+        send_frame(0x8, code, sizeof(code));
+        if (flush_output()) {
+            fail("message too large");
+        }
+        return false;
+    }
+
+    template<typename Emit>
+    bool process_frames(Emit&& emit) {
+        for (;;) {
+            const size_t available = in_end_ - in_begin_;
+            const auto* frame = reinterpret_cast<const uint8_t*>(in_.data() + in_begin_);
+            if (available < 2) {
+                return true;
+            }
+            const bool final_fragment = (frame[0] & 0x80) != 0;
+            const uint8_t opcode = frame[0] & 0x0f;
+            const bool masked = (frame[1] & 0x80) != 0;
+            uint64_t length = frame[1] & 0x7f;
+            size_t header = 2;
+            if (length == 126) {
+                if (available < 4) return true;
+                length = (uint64_t{frame[2]} << 8) | frame[3];
+                header = 4;
+            } else if (length == 127) {
+                if (available < 10) return true;
+                length = 0;
+                for (size_t i = 0; i < 8; ++i) {
+                    length = (length << 8) | frame[2 + i];
+                }
+                header = 10;
+            }
+            if (length > feed_detail::MAX_MESSAGE) {
+                return close_too_big();
+            }
+            const size_t mask_size = masked ? 4 : 0;
+            if (available < header + mask_size + length) {
+                return true;
+            }
+            char* payload = in_.data() + in_begin_ + header + mask_size;
+            if (masked) {
+                const char* mask = in_.data() + in_begin_ + header;
+                for (size_t i = 0; i < length; ++i) {
+                    payload[i] ^= mask[i & 3];
+                }
+            }
+            const size_t size = static_cast<size_t>(length);
+
+            switch (opcode) {
+            case 0x0:  // continuation
+            case 0x1:  // text
+            case 0x2:  // binary
+                if (final_fragment && message_.empty() && opcode != 0x0) {
+                    on_message(payload, size, emit);
+                } else {
+                    if (message_.size() + size > feed_detail::MAX_MESSAGE) {
+                        return close_too_big();
+                    }
+                    message_.insert(message_.end(), payload, payload + size);
+                    if (final_fragment) {
+                        on_message(message_.data(), message_.size(), emit);
+                        message_.clear();
+                    }
+                }
+                break;
+            case 0x8:  // close
+                send_frame(0x8, payload, std::min<size_t>(size, 2));
+                flush_output();
+                fail("closed by venue");
+                return false;
+            case 0x9:  // ping
+                send_frame(0xA, payload, size);
+                if (!flush_output()) {
+                    return false;
+                }
+                break;
+            default:   // pong and reserved opcodes
+                break;
+            }
+            in_begin_ += header + mask_size + size;
+        }
+    }
+
+    // --- HTTP polling ------------------------------------------------------
+
+    bool send_poll() {
+        if (request_in_flight_ || feed_.symbols.empty()) {
+            return true;
+        }
+        const FeedSymbol& symbol = feed_.symbols[next_poll_symbol_];
+        out_ = "GET " + endpoint_.path + "v8/finance/chart/" + symbol.venue_symbol +
+               "?interval=1m&range=1d HTTP/1.1\r\nHost: " + endpoint_.host +
+               "\r\nUser-Agent: TradingApp/1.0\r\nAccept: application/json\r\nConnection: keep-alive\r\n\r\n";
+        out_sent_ = 0;
+        request_in_flight_ = true;
+        deadline_ = clock::now() + feed_detail::CONNECT_TIMEOUT;
+        return flush_output();
+    }
+
+    // Consumes one complete response if buffered; false on failure
+    template<typename Emit>
+    bool process_response(Emit&& emit) {
+        const std::string_view buffered(in_.data() + in_begin_, in_end_ - in_begin_);
+        const auto header_end = buffered.find("\r\n\r\n");
+        if (header_end == std::string_view::npos) {
+            return true;
+        }
+        const std::string_view headers = buffered.substr(0, header_end + 2);
+        const size_t body_start = header_end + 4;
+        const char* body = nullptr;
+        size_t body_size = 0;
+        size_t consumed = 0;
+
+        const std::string_view length_field = feed_detail::header_value(headers, "Content-Length");
+        if (feed_detail::contains_token(feed_detail::header_value(headers, "Transfer-Encoding"), "chunked")) {
+            message_.clear();
+            size_t at = body_start;
+            for (;;) {
+                const auto line_end = buffered.find("\r\n", at);
+                if (line_end == std::string_view::npos) {
+                    return true;
+                }
+                const size_t chunk = std::strtoul(std::string(buffered.substr(at, line_end - at)).c_str(), nullptr, 16);
+                if (chunk == 0) {
+                    const auto trailer_end = buffered.find("\r\n\r\n", line_end);
+                    if (trailer_end == std::string_view::npos) {
+                        return true;
+                    }
+                    consumed = trailer_end + 4;
+                    break;
+                }
+                if (line_end + 2 + chunk + 2 > buffered.size()) {
+                    return true;
+                }
+                message_.insert(message_.end(), buffered.data() + line_end + 2, buffered.data() + line_end + 2 + chunk);
+                at = line_end + 2 + chunk + 2;
+            }
+            body = message_.data();
+            body_size = message_.size();
+        } else if (!length_field.empty()) {
+            body_size = std::strtoul(std::string(length_field).c_str(), nullptr, 10);
+            if (buffered.size() < body_start + body_size) {
+                return true;
+            }
+            body = buffered.data() + body_start;
+            consumed = body_start + body_size;
+        } else {
+            fail("response without a length");
+            return false;
+        }
+
+        const bool ok = headers.substr(0, 16).find(" 200") != std::string_view::npos;
+        if (ok) {
+            on_message(body, body_size, emit);
+        } else {
+            ++stats_.parse_errors;
+        }
+        const bool keep_alive = !feed_detail::contains_token(feed_detail::header_value(headers, "Connection"), "close");
+        in_begin_ += consumed;
+        message_.clear();
+        request_in_flight_ = false;
+
+        // Walk the symbols one request at a time, then wait out the interval
+        next_poll_symbol_ = (next_poll_symbol_ + 1) % feed_.symbols.size();
+        deadline_ = next_poll_symbol_ == 0 ? clock::now() + poll_interval_ : clock::now();
+        if (!keep_alive) {
+            close_socket();
+            deadline_ = clock::now() + (next_poll_symbol_ == 0 ? poll_interval_ : std::chrono::milliseconds(0));
+        }
+        return true;
+    }
+
+    // --- Venue messages ----------------------------------------------------
+
+    FeedSymbol* find_symbol(std::string_view venue_symbol) {
+        for (FeedSymbol& symbol : feed_.symbols) {
+            if (symbol.venue_symbol == venue_symbol) {
+                return &symbol;
+            }
+        }
+        return nullptr;
+    }
+
+    template<typename Emit>
+    void emit_tick(FeedSymbol* symbol, double price, double size, uint64_t timestamp, Emit& emit) {
+        if (!symbol || symbol->index < 0 || !(price > 0.0)) {
+            return;
+        }
+        TradingTick tick;
+        tick.price = price;
+        tick.volume = static_cast<int32_t>(std::min<int64_t>(std::llround(std::max(size, 0.0)), INT32_MAX));
+        tick.timestamp = timestamp != 0 ? timestamp : feed_detail::wall_clock_ns();
+        tick.valid = true;
+        tick.symbol_index = static_cast<uint16_t>(symbol->index);
+        symbol->last_timestamp = tick.timestamp;
+        symbol->last_price = price;
+        ++stats_.ticks;
+        emit(tick);
+    }
+
+    template<typename Emit>
+    void on_message(const char* data, size_t size, Emit& emit) {
+        ++stats_.messages;
+        if (!parser_.parse(data, size)) {
+            ++stats_.parse_errors;
+            return;
+        }
+        switch (feed_.venue) {
+        case FeedVenue::Coinbase: {
+            // {"type":"ticker","product_id":"BTC-USD","price":"...","last_size":"...","time":"..."}
+            if (parser_["type"] != "ticker") {
+                return;
+            }
+            emit_tick(find_symbol(parser_["product_id"].text()), parser_["price"].as_double(),
+                      parser_["last_size"].as_double(), parse_iso8601_ns(parser_["time"].text()), emit);
+            break;
+        }
+        case FeedVenue::Binance: {
+            // {"stream":"btcusdt@trade","data":{"e":"trade","s":"BTCUSDT","p":"...","q":"...","T":ms}}
+            const JsonValue trade = parser_["data"].valid() ? parser_["data"] : parser_.root();
+            if (trade["e"] != "trade") {
+                return;
+            }
+            emit_tick(find_symbol(trade["s"].text()), trade["p"].as_double(), trade["q"].as_double(),
+                      static_cast<uint64_t>(trade["T"].as_int64()) * 1000000ull, emit);
+            break;
+        }
+        case FeedVenue::Yahoo: {
+            // {"chart":{"result":[{"meta":{"symbol":"AAPL","regularMarketPrice":..,"regularMarketTime":s}}]}}
+            const JsonValue meta = parser_["chart"]["result"][0]["meta"];
+            FeedSymbol* symbol = find_symbol(meta["symbol"].text());
+            const double price = meta["regularMarketPrice"].as_double();
+            const uint64_t timestamp = static_cast<uint64_t>(meta["regularMarketTime"].as_int64()) * 1000000000ull;
+            // Polling sees the same quote until the market moves
+            if (symbol && (timestamp != symbol->last_timestamp || price != symbol->last_price)) {
+                emit_tick(symbol, price, meta["regularMarketVolume"].as_double(), timestamp, emit);
+            }
+            break;
+        }
+        }
+    }
+
+public:
+#if defined(TRADING_FEED_TLS)
+    FeedConnection(FeedSubscription& feed, int epoll_fd, SSL_CTX* tls_context, std::chrono::milliseconds poll_interval)
+        : feed_(feed), endpoint_(FeedEndpoint::parse(feed.url)), epoll_fd_(epoll_fd), tls_context_(tls_context),
+#else
+    FeedConnection(FeedSubscription& feed, int epoll_fd, void*, std::chrono::milliseconds poll_interval)
+        : feed_(feed), endpoint_(FeedEndpoint::parse(feed.url)), epoll_fd_(epoll_fd),
+#endif
+          rng_(feed_detail::wall_clock_ns()), in_(4 * feed_detail::READ_CHUNK), deadline_(clock::now()),
+          poll_interval_(poll_interval) {
+        message_.reserve(feed_detail::READ_CHUNK);
+        out_.reserve(1024);
+    }
+
+    ~FeedConnection() { close_socket(); }
+
+    FeedConnection(const FeedConnection&) = delete;
+    FeedConnection& operator=(const FeedConnection&) = delete;
+
+    // Readiness on the socket; emit(const TradingTick&) per decoded tick
+    template<typename Emit>
+    void on_ready(uint32_t events, Emit&& emit) {
+        if (state_ == State::Connecting) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(fd_, SOL_SOCKET, SO_ERROR, &error, &length);
+            if (error != 0 || (events & (EPOLLERR | EPOLLHUP))) {
+                connect_next(error != 0 ? std::strerror(error) : "connect failed");
+                return;
+            }
+            on_connected();
+            return;
+        }
+#if defined(TRADING_FEED_TLS)
+        if (state_ == State::Handshaking) {
+            continue_handshake();
+            return;
+        }
+#endif
+        if ((events & EPOLLOUT) && !flush_output()) {
+            return;
+        }
+        if (!(events & (EPOLLIN | EPOLLERR | EPOLLHUP)) || !fill_input()) {
+            return;
+        }
+        if (state_ == State::Upgrading && !finish_upgrade()) {
+            return;
+        }
+        if (state_ != State::Open) {
+            return;
+        }
+        if (endpoint_.websocket) {
+            process_frames(emit);
+        } else {
+            process_response(emit);
+        }
+    }
+
+    // Timer work: reconnects, connect and staleness timeouts, the next poll
+    void on_timer(clock::time_point now) {
+        const bool stale = state_ == State::Open && endpoint_.websocket && now - last_receive_ > feed_detail::STALE_AFTER;
+        if (now < deadline_ && !stale) {
+            return;
+        }
+        switch (state_) {
+        case State::Idle:
+            start_connect();
+            break;
+        case State::Open:
+            if (stale) {
+                fail("no data for 30 s");
+            } else if (!endpoint_.websocket) {
+                if (request_in_flight_) {
+                    fail("request timed out");
+                } else {
+                    send_poll();
+                }
+            } else {
+                deadline_ = now + feed_detail::STALE_AFTER;
+            }
+            break;
+        case State::Connecting:
+            connect_next("connect timed out");
+            break;
+        default:
+            fail("connect timed out");
+            break;
+        }
+    }
+
+    clock::time_point deadline() const {
+        return state_ == State::Open && endpoint_.websocket ? last_receive_ + feed_detail::STALE_AFTER : deadline_;
+    }
+
+    const FeedSubscription& feed() const { return feed_; }
+    const FeedStats& stats() const { return stats_; }
+    State state() const { return state_; }
+};
+
+// The epoll loop over every configured feed connection
+class FeedHandler {
+private:
+    int epoll_fd_ = -1;
+#if defined(TRADING_FEED_TLS)
+    SSL_CTX* tls_context_ = nullptr;
+#else
+    void* tls_context_ = nullptr;
+#endif
+    std::vector<std::unique_ptr<FeedConnection>> connections_;
+
+public:
+    explicit FeedHandler(FeedOptions& options) {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ < 0) {
+            throw std::runtime_error("epoll_create1 failed: " + std::string(std::strerror(errno)));
+        }
+#if defined(TRADING_FEED_TLS)
+        tls_context_ = SSL_CTX_new(TLS_client_method());
+        if (!tls_context_) {
+            ::close(epoll_fd_);
+            throw std::runtime_error("Cannot create a TLS context");
+        }
+        SSL_CTX_set_default_verify_paths(tls_context_);
+        SSL_CTX_set_verify(tls_context_, SSL_VERIFY_PEER, nullptr);
+        SSL_CTX_set_min_proto_version(tls_context_, TLS1_2_VERSION);
+#endif
+        for (FeedSubscription& feed : options.feeds) {
+            connections_.push_back(std::make_unique<FeedConnection>(feed, epoll_fd_, tls_context_, options.poll_interval));
+        }
+    }
+
+    ~FeedHandler() {
+        connections_.clear();
+#if defined(TRADING_FEED_TLS)
+        SSL_CTX_free(tls_context_);
+#endif
+        ::close(epoll_fd_);
+    }
+
+    FeedHandler(const FeedHandler&) = delete;
+    FeedHandler& operator=(const FeedHandler&) = delete;
+
+    // One pass: wait up to max_wait (or the nearest timer) for readiness,
+    // handle it, run due timers. Returns the number of ticks emitted.
+    template<typename Emit>
+    size_t poll(std::chrono::milliseconds max_wait, Emit&& emit) {
+        const auto now = FeedConnection::clock::now();
+        auto wake = now + max_wait;
+        for (const auto& connection : connections_) {
+            wake = std::min(wake, connection->deadline());
+        }
+        const int timeout = static_cast<int>(std::max<int64_t>(
+            0, std::chrono::duration_cast<std::chrono::milliseconds>(wake - now).count()));
+
+        size_t ticks = 0;
+        auto counted = [&](const TradingTick& tick) {
+            ++ticks;
+            emit(tick);
+        };
+        epoll_event events[64];
+        const int ready = epoll_wait(epoll_fd_, events, 64, timeout);
+        for (int i = 0; i < ready; ++i) {
+            static_cast<FeedConnection*>(events[i].data.ptr)->on_ready(events[i].events, counted);
+        }
+        const auto after = FeedConnection::clock::now();
+        for (const auto& connection : connections_) {
+            connection->on_timer(after);
+        }
+        return ticks;
+    }
+
+    const std::vector<std::unique_ptr<FeedConnection>>& connections() const { return connections_; }
+};
+
+constexpr auto FEED_REPORT_INTERVAL = std::chrono::seconds(10);
+constexpr auto FEED_IDLE_WAIT = std::chrono::milliseconds(1);  // longest a pass without ticks blocks
+
+// Runs the feed loop until running clears: publish(TradingTick&) per tick,
+// flush() after every pass that produced ticks, idle() after every pass
+// that didn't, report(handler) every FEED_REPORT_INTERVAL. Passes block
+// for at most FEED_IDLE_WAIT, so idle() still runs every millisecond
+// while the venues are quiet, disconnected or reconnecting.
+template<typename Publish, typename Flush, typename Idle, typename Report>
+void run_feed(FeedHandler& handler, const std::atomic<bool>& running, Publish&& publish, Flush&& flush,
+              Idle&& idle, Report&& report) {
+    auto next_report = std::chrono::steady_clock::now() + FEED_REPORT_INTERVAL;
+    while (running) {
+        const size_t ticks = handler.poll(FEED_IDLE_WAIT, [&](const TradingTick& tick) {
+            TradingTick copy = tick;
+            publish(copy);
+        });
+        if (ticks > 0) {
+            flush();
+        } else {
+            idle();
+        }
+        if (std::chrono::steady_clock::now() >= next_report) {
+            report(handler);
+            next_report += FEED_REPORT_INTERVAL;
+        }
+    }
+}
+
+#endif // FEED_HANDLER_H
@@ -0,0 +1,304 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "trading_system.h"
+#include "shared_code.h"
+#include "market_data_table.h"
+
+// Streaming indicators over the last N ticks of each symbol: SMA, EMA,
+// VWAP, volatility of log returns and rolling min/max. Every update is
+// O(1) (min/max amortized) over fixed arrays, so nothing allocates once a
+// symbol has been seen. Results go to a shared segment indexed like the
+// MarketDataTable, so readers look a symbol up once and read finished values.
+
+constexpr size_t INDICATOR_WINDOW = 64;
+
+// Consistent copy of one symbol's indicators
+struct IndicatorSnapshot {
+    uint64_t timestamp = 0;
+    uint64_t samples = 0;      // ticks seen; the window is full once >= N
+    double last_price = 0.0;
+    double sma = 0.0;
+    double ema = 0.0;
+    double vwap = 0.0;
+    double volatility = 0.0;   // sample stddev of log returns in the window
+    double min = 0.0;
+    double max = 0.0;
+};
+
+// Shared slot, published under a seqlock exactly like TradingData
+struct alignas(CACHE_LINE_SIZE) IndicatorValues {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> timestamp{0};
+    std::atomic<uint64_t> samples{0};
+    std::atomic<double> last_price{0.0};
+    std::atomic<double> sma{0.0};
+    std::atomic<double> ema{0.0};
+    std::atomic<double> vwap{0.0};
+    std::atomic<double> volatility{0.0};
+    std::atomic<double> min{0.0};
+    std::atomic<double> max{0.0};
+
+    void publish(const IndicatorSnapshot& values) {
+        const uint64_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        timestamp.store(values.timestamp, std::memory_order_relaxed);
+        samples.store(values.samples, std::memory_order_relaxed);
+        last_price.store(values.last_price, std::memory_order_relaxed);
+        sma.store(values.sma, std::memory_order_relaxed);
+        ema.store(values.ema, std::memory_order_relaxed);
+        vwap.store(values.vwap, std::memory_order_relaxed);
+        volatility.store(values.volatility, std::memory_order_relaxed);
+        min.store(values.min, std::memory_order_relaxed);
+        max.store(values.max, std::memory_order_relaxed);
+
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    bool try_snapshot(IndicatorSnapshot& out) const {
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        out.timestamp = timestamp.load(std::memory_order_relaxed);
+        out.samples = samples.load(std::memory_order_relaxed);
+        out.last_price = last_price.load(std::memory_order_relaxed);
+        out.sma = sma.load(std::memory_order_relaxed);
+        out.ema = ema.load(std::memory_order_relaxed);
+        out.vwap = vwap.load(std::memory_order_relaxed);
+        out.volatility = volatility.load(std::memory_order_relaxed);
+        out.min = min.load(std::memory_order_relaxed);
+        out.max = max.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    IndicatorSnapshot snapshot() const {
+        IndicatorSnapshot values;
+        while (!try_snapshot(values)) {
+        }
+        return values;
+    }
+};
+
+// Slot i holds the indicators for MarketDataTable slot i
+template<size_t Capacity>
+struct IndicatorTable {
+    static constexpr size_t capacity = Capacity;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> count{0};  // highest published index + 1
+    IndicatorValues slots[Capacity];
+
+    IndicatorValues& at(int32_t index) { return slots[index]; }
+    const IndicatorValues& at(int32_t index) const { return slots[index]; }
+    uint32_t size() const { return count.load(std::memory_order_acquire); }
+};
+
+using Indicators = IndicatorTable<MARKET_TABLE_CAPACITY>;
+
+template<>
+struct SegmentLayout<Indicators> {
+    static constexpr const char* type_name = "Indicators";
+    static constexpr size_t record_size = sizeof(IndicatorValues);
+    static constexpr size_t capacity = MARKET_TABLE_CAPACITY;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "count", offsetof(Indicators, count), sizeof(uint32_t));
+        add_segment_field(header, "slots", offsetof(Indicators, slots), sizeof(Indicators::slots));
+        add_segment_field(header, "record.sequence", offsetof(IndicatorValues, sequence), sizeof(uint64_t));
+        add_segment_field(header, "record.timestamp", offsetof(IndicatorValues, timestamp), sizeof(uint64_t));
+        add_segment_field(header, "record.samples", offsetof(IndicatorValues, samples), sizeof(uint64_t));
+        add_segment_field(header, "record.last_price", offsetof(IndicatorValues, last_price), sizeof(double));
+        add_segment_field(header, "record.sma", offsetof(IndicatorValues, sma), sizeof(double));
+        add_segment_field(header, "record.ema", offsetof(IndicatorValues, ema), sizeof(double));
+        add_segment_field(header, "record.vwap", offsetof(IndicatorValues, vwap), sizeof(double));
+        add_segment_field(header, "record.volatility", offsetof(IndicatorValues, volatility), sizeof(double));
+        add_segment_field(header, "record.min", offsetof(IndicatorValues, min), sizeof(double));
+        add_segment_field(header, "record.max", offsetof(IndicatorValues, max), sizeof(double));
+    }
+};
+
+static_assert(offsetof(IndicatorValues, max) == 72 && sizeof(IndicatorValues) == 128, "Python INDICATOR_FORMAT");
+static_assert(offsetof(Indicators, slots) == 64, "Python INDICATOR_SLOTS_OFFSET");
+
+// Sliding min or max over the last N values (monotonic deque in a fixed ring).
+// Better(a, b) is true when a should evict b, e.g. a <= b for a minimum.
+template<size_t N, typename Better>
+class MonotonicWindow {
+private:
+    double values_[N];
+    uint64_t positions_[N];
+    uint64_t front_ = 0;
+    uint64_t back_ = 0;
+
+public:
+    void push(double value, uint64_t position) {
+        // Entries at or before position - N have left the window
+        while (front_ != back_ && positions_[front_ % N] + N <= position) {
+            ++front_;
+        }
+        while (back_ != front_ && Better{}(value, values_[(back_ - 1) % N])) {
+            --back_;
+        }
+        values_[back_ % N] = value;
+        positions_[back_ % N] = position;
+        ++back_;
+    }
+
+    double best() const { return values_[front_ % N]; }
+};
+
+struct LessEqual {
+    bool operator()(double a, double b) const { return a <= b; }
+};
+
+struct GreaterEqual {
+    bool operator()(double a, double b) const { return a >= b; }
+};
+
+// Running state for one symbol
+template<size_t N>
+class alignas(DESTRUCTIVE_INTERFERENCE_SIZE) IndicatorState {
+private:
+    static constexpr double ema_alpha = 2.0 / (N + 1);
+
+    double prices_[N];
+    double volumes_[N];
+    double returns_[N];
+    size_t next_ = 0;
+    uint64_t samples_ = 0;
+
+    double sum_price_ = 0.0;
+    double sum_volume_ = 0.0;
+    double sum_notional_ = 0.0;
+    double sum_return_ = 0.0;
+    double sum_return_sq_ = 0.0;
+    double ema_ = 0.0;
+    double last_price_ = 0.0;
+
+    MonotonicWindow<N, LessEqual> min_;
+    MonotonicWindow<N, GreaterEqual> max_;
+
+    size_t window_size() const { return samples_ < N ? static_cast<size_t>(samples_) : N; }
+
+    // Rebuild the running sums once per lap so add/subtract rounding can't accumulate
+    void resum() {
+        const size_t count = window_size();
+        sum_price_ = sum_volume_ = sum_notional_ = sum_return_ = sum_return_sq_ = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum_price_ += prices_[i];
+            sum_volume_ += volumes_[i];
+            sum_notional_ += prices_[i] * volumes_[i];
+            sum_return_ += returns_[i];
+            sum_return_sq_ += returns_[i] * returns_[i];
+        }
+    }
+
+public:
+    void update(double price, double volume) {
+        // The first tick has no previous price; its return slot is zero and
+        // excluded from the volatility count below
+        const double ret = samples_ > 0 && last_price_ > 0.0 && price > 0.0 ? std::log(price / last_price_) : 0.0;
+
+        if (samples_ >= N) {
+            const double old_price = prices_[next_];
+            const double old_volume = volumes_[next_];
+            const double old_return = returns_[next_];
+            sum_price_ -= old_price;
+            sum_volume_ -= old_volume;
+            sum_notional_ -= old_price * old_volume;
+            sum_return_ -= old_return;
+            sum_return_sq_ -= old_return * old_return;
+        }
+
+        prices_[next_] = price;
+        volumes_[next_] = volume;
+        returns_[next_] = ret;
+        sum_price_ += price;
+        sum_volume_ += volume;
+        sum_notional_ += price * volume;
+        sum_return_ += ret;
+        sum_return_sq_ += ret * ret;
+
+        min_.push(price, samples_);
+        max_.push(price, samples_);
+        ema_ = samples_ == 0 ? price : ema_ + ema_alpha * (price - ema_);
+        last_price_ = price;
+
+        ++samples_;
+        if (++next_ == N) {
+            next_ = 0;
+            resum();
+        }
+    }
+
+    IndicatorSnapshot snapshot(uint64_t timestamp) const {
+        IndicatorSnapshot values;
+        const size_t count = window_size();
+        values.timestamp = timestamp;
+        values.samples = samples_;
+        values.last_price = last_price_;
+        values.sma = count ? sum_price_ / count : 0.0;
+        values.ema = ema_;
+        values.vwap = sum_volume_ > 0.0 ? sum_notional_ / sum_volume_ : values.sma;
+
+        // Until the first tick leaves the window, its slot holds a placeholder return
+        const size_t returns = samples_ <= N ? count - 1 : count;
+        if (returns >= 2) {
+            const double mean = sum_return_ / returns;
+            const double variance = (sum_return_sq_ - mean * sum_return_) / (returns - 1);
+            values.volatility = variance > 0.0 ? std::sqrt(variance) : 0.0;
+        }
+        values.min = count ? min_.best() : 0.0;
+        values.max = count ? max_.best() : 0.0;
+        return values;
+    }
+};
+
+// Consumes ticks (any order across symbols) and publishes each symbol's
+// indicators to the shared table. Single writer, like the table it fills.
+template<size_t N, size_t Capacity>
+class IndicatorEngine {
+private:
+    IndicatorTable<Capacity>* table_;
+    // Each symbol's state is allocated on its first tick and never again
+    std::unique_ptr<std::unique_ptr<IndicatorState<N>>[]> states_;
+
+public:
+    explicit IndicatorEngine(IndicatorTable<Capacity>* table)
+        : table_(table), states_(new std::unique_ptr<IndicatorState<N>>[Capacity]) {}
+
+    void on_tick(const TradingTick& tick) {
+        const size_t index = tick.symbol_index;
+        if (index >= Capacity || !tick.valid) {
+            return;
+        }
+        if (!states_[index]) {
+            states_[index].reset(new IndicatorState<N>());
+        }
+
+        IndicatorState<N>& state = *states_[index];
+        state.update(tick.price, static_cast<double>(tick.volume));
+        table_->at(static_cast<int32_t>(index)).publish(state.snapshot(tick.timestamp));
+
+        if (index >= table_->count.load(std::memory_order_relaxed)) {
+            table_->count.store(static_cast<uint32_t>(index + 1), std::memory_order_release);
+        }
+    }
+
+    const IndicatorState<N>* state(size_t index) const {
+        return index < Capacity ? states_[index].get() : nullptr;
+    }
+};
+
+using TickIndicatorEngine = IndicatorEngine<INDICATOR_WINDOW, MARKET_TABLE_CAPACITY>;
+
+#endif // INDICATORS_H
@@ -0,0 +1,499 @@
+#ifndef JSON_SCANNER_H
+#define JSON_SCANNER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// JSON parsing for feed messages in two passes, the way simdjson does it:
+//
+// 1. Structural scan: 64 bytes at a time, compare against '"', '\\' and
+//    the six structural characters ({}[]:,) in 32- or 16-byte vectors,
+//    drop escaped quotes, turn the quote mask into an in-string mask with
+//    a prefix XOR and keep the structurals outside strings. AVX2 is picked
+//    at runtime, SSE2 is the x86-64 baseline, other targets scan scalar.
+// 2. A walk over the structural offsets builds a flat tape of tokens;
+//    objects and arrays record where their subtree ends so lookups skip
+//    siblings without descending.
+//
+// Strings are views into the message with escapes left as they are, and
+// numbers (quoted or not, venues send both) are parsed on access, so the
+// parser never copies and reuses its buffers from message to message.
+
+namespace json_detail {
+
+struct BlockMasks {
+    uint64_t quote = 0;
+    uint64_t backslash = 0;
+    uint64_t structural = 0;
+};
+
+inline void classify_scalar(const char* block, BlockMasks& masks) {
+    for (size_t i = 0; i < 64; ++i) {
+        const uint64_t bit = uint64_t{1} << i;
+        switch (block[i]) {
+        case '"': masks.quote |= bit; break;
+        case '\\': masks.backslash |= bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',': masks.structural |= bit; break;
+        default: break;
+        }
+    }
+}
+
+#if defined(__x86_64__)
+inline uint64_t movemask16(__m128i hits) { return static_cast<uint16_t>(_mm_movemask_epi8(hits)); }
+
+inline void classify_sse2(const char* block, BlockMasks& masks) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    // Setting bit 0x20 folds '[' ']' onto '{' '}'
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i open = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+    for (size_t i = 0; i < 64; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        const __m128i folded = _mm_or_si128(bytes, case_bit);
+        const __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close));
+        const __m128i structural = _mm_or_si128(brackets, _mm_or_si128(_mm_cmpeq_epi8(bytes, colon),
+                                                                       _mm_cmpeq_epi8(bytes, comma)));
+        masks.quote |= movemask16(_mm_cmpeq_epi8(bytes, quote)) << i;
+        masks.backslash |= movemask16(_mm_cmpeq_epi8(bytes, backslash)) << i;
+        masks.structural |= movemask16(structural) << i;
+    }
+}
+
+__attribute__((target("avx2")))
+inline void classify_avx2(const char* block, BlockMasks& masks) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i open = _mm256_set1_epi8('{');
+    const __m256i close = _mm256_set1_epi8('}');
+    for (size_t i = 0; i < 64; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        const __m256i folded = _mm256_or_si256(bytes, case_bit);
+        const __m256i brackets = _mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close));
+        const __m256i structural = _mm256_or_si256(brackets, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, colon),
+                                                                            _mm256_cmpeq_epi8(bytes, comma)));
+        masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote)))) << i;
+        masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, backslash)))) << i;
+        masks.structural |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(structural))) << i;
+    }
+}
+
+inline bool cpu_has_avx2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+#endif
+
+inline void classify(const char* block, BlockMasks& masks) {
+#if defined(__x86_64__)
+    if (cpu_has_avx2()) {
+        classify_avx2(block, masks);
+    } else {
+        classify_sse2(block, masks);
+    }
+#else
+    classify_scalar(block, masks);
+#endif
+}
+
+// Bit i set if byte i follows an odd-length run of backslashes. Escapes
+// are rare in market data, so walking the backslash bits is cheaper than
+// the branch-free carry trick.
+inline uint64_t escaped_mask(uint64_t backslash, bool& carry) {
+    uint64_t escaped = 0;
+    if (carry) {
+        escaped |= 1;
+        backslash &= ~uint64_t{1};
+        carry = false;
+    }
+    while (backslash) {
+        const int i = __builtin_ctzll(backslash);
+        backslash &= backslash - 1;
+        if (i == 63) {
+            carry = true;
+        } else {
+            escaped |= uint64_t{1} << (i + 1);
+            backslash &= ~(uint64_t{1} << (i + 1));
+        }
+    }
+    return escaped;
+}
+
+// Bit i = XOR of bits 0..i: 1 from an opening quote up to its closing quote
+inline uint64_t prefix_xor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+} // namespace json_detail
+
+// Appends the offset of every structural character outside strings, plus
+// every unescaped quote, to out. Returns false if a string is unterminated.
+inline bool scan_json_structurals(const char* data, size_t size, std::vector<uint32_t>& out) {
+    bool escape_carry = false;
+    uint64_t in_string_carry = 0;
+    alignas(64) char tail[64];
+
+    for (size_t base = 0; base < size; base += 64) {
+        const char* block = data + base;
+        if (size - base < 64) {
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, block, size - base);
+            block = tail;
+        }
+        json_detail::BlockMasks masks;
+        json_detail::classify(block, masks);
+
+        uint64_t quotes = masks.quote;
+        if (masks.backslash != 0 || escape_carry) {
+            quotes &= ~json_detail::escaped_mask(masks.backslash, escape_carry);
+        }
+        const uint64_t in_string = json_detail::prefix_xor(quotes) ^ in_string_carry;
+        in_string_carry = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+        uint64_t structurals = (masks.structural & ~in_string) | quotes;
+        while (structurals) {
+            out.push_back(static_cast<uint32_t>(base + static_cast<size_t>(__builtin_ctzll(structurals))));
+            structurals &= structurals - 1;
+        }
+    }
+    return in_string_carry == 0;
+}
+
+enum class JsonType : uint8_t { Object, Array, String, Scalar };
+
+struct JsonToken {
+    JsonType type;
+    uint32_t begin;   // String: first byte after the opening quote; Scalar: first byte
+    uint32_t end;     // String: the closing quote; Scalar: one past the last byte
+    uint32_t next;    // index of the token after this value and its children
+};
+
+class JsonParser;
+
+// Read-only view of one value on a parser's tape; a missing key or index
+// gives an invalid view, and every accessor on it returns its fallback
+class JsonValue {
+private:
+    const JsonParser* parser_ = nullptr;
+    uint32_t index_ = 0;
+
+public:
+    JsonValue() = default;
+    JsonValue(const JsonParser* parser, uint32_t index) : parser_(parser), index_(index) {}
+
+    bool valid() const { return parser_ != nullptr; }
+    inline const JsonToken* token() const;
+    bool is(JsonType type) const { return valid() && token()->type == type; }
+
+    inline JsonValue operator[](std::string_view key) const;
+    inline JsonValue operator[](size_t position) const;
+    inline size_t size() const;
+
+    // fn(JsonValue key, JsonValue value) per object member / fn(JsonValue) per array element
+    template<typename Fn>
+    void for_each_member(Fn&& fn) const;
+    template<typename Fn>
+    void for_each_element(Fn&& fn) const;
+
+    // Raw text: string contents without quotes (escapes kept), or the scalar literal
+    inline std::string_view text() const;
+    inline double as_double(double fallback = 0.0) const;
+    inline int64_t as_int64(int64_t fallback = 0) const;
+    bool operator==(std::string_view other) const { return valid() && text() == other; }
+    bool operator!=(std::string_view other) const { return !(*this == other); }
+};
+
+class JsonParser {
+private:
+    static constexpr size_t MAX_DEPTH = 64;
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint32_t> structurals_;
+    std::vector<JsonToken> tape_;
+    size_t cursor_ = 0;
+
+    friend class JsonValue;
+
+    static bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+    // Scalars sit between two structurals: from `from` up to the next one
+    bool parse_scalar(size_t from) {
+        const uint32_t stop = cursor_ < structurals_.size() ? structurals_[cursor_] : static_cast<uint32_t>(size_);
+        size_t begin = from;
+        size_t end = stop;
+        while (begin < end && is_space(data_[begin])) ++begin;
+        while (end > begin && is_space(data_[end - 1])) --end;
+        for (size_t i = begin; i < end; ++i) {
+            if (is_space(data_[i])) {
+                return false;
+            }
+        }
+        if (begin == end) {
+            return false;
+        }
+        const uint32_t index = static_cast<uint32_t>(tape_.size());
+        tape_.push_back(JsonToken{JsonType::Scalar, static_cast<uint32_t>(begin), static_cast<uint32_t>(end), index + 1});
+        return true;
+    }
+
+    bool parse_value(size_t from, size_t depth) {
+        size_t at = from;
+        while (at < size_ && is_space(data_[at])) ++at;
+        if (at >= size_) {
+            return false;
+        }
+        if (cursor_ >= structurals_.size() || structurals_[cursor_] != at) {
+            return parse_scalar(at);
+        }
+        const char c = data_[at];
+        if (c == '"') {
+            if (cursor_ + 1 >= structurals_.size()) {
+                return false;
+            }
+            const uint32_t index = static_cast<uint32_t>(tape_.size());
+            tape_.push_back(JsonToken{JsonType::String, static_cast<uint32_t>(at + 1), structurals_[cursor_ + 1], index + 1});
+            cursor_ += 2;
+            return true;
+        }
+        if ((c != '{' && c != '[') || depth >= MAX_DEPTH) {
+            return false;
+        }
+        const bool object = c == '{';
+        const char close = object ? '}' : ']';
+        const size_t index = tape_.size();
+        tape_.push_back(JsonToken{object ? JsonType::Object : JsonType::Array, static_cast<uint32_t>(at), 0, 0});
+        ++cursor_;
+
+        if (cursor_ < structurals_.size() && data_[structurals_[cursor_]] == close) {
+            bool empty = true;
+            for (size_t i = at + 1; i < structurals_[cursor_]; ++i) {
+                empty = empty && is_space(data_[i]);
+            }
+            if (empty) {
+                tape_[index].end = structurals_[cursor_];
+                tape_[index].next = static_cast<uint32_t>(tape_.size());
+                ++cursor_;
+                return true;
+            }
+        }
+        for (;;) {
+            if (object) {
+                if (cursor_ + 2 >= structurals_.size() || data_[structurals_[cursor_]] != '"') {
+                    return false;
+                }
+                const uint32_t key = static_cast<uint32_t>(tape_.size());
+                tape_.push_back(JsonToken{JsonType::String, structurals_[cursor_] + 1, structurals_[cursor_ + 1], key + 1});
+                cursor_ += 2;
+                if (data_[structurals_[cursor_]] != ':') {
+                    return false;
+                }
+            }
+            const size_t value_from = structurals_[cursor_ - (object ? 0 : 1)] + 1;
+            if (object) {
+                ++cursor_;
+            }
+            if (!parse_value(value_from, depth + 1) || cursor_ >= structurals_.size()) {
+                return false;
+            }
+            const char separator = data_[structurals_[cursor_]];
+            ++cursor_;
+            if (separator == close) {
+                break;
+            }
+            if (separator != ',') {
+                return false;
+            }
+        }
+        tape_[index].end = structurals_[cursor_ - 1];
+        tape_[index].next = static_cast<uint32_t>(tape_.size());
+        return true;
+    }
+
+public:
+    JsonParser() {
+        structurals_.reserve(1024);
+        tape_.reserve(512);
+    }
+
+    // Parses data[0, size); the buffer must outlive the values read from it.
+    // Only single top-level objects or arrays are accepted.
+    bool parse(const char* data, size_t size) {
+        data_ = data;
+        size_ = size;
+        structurals_.clear();
+        tape_.clear();
+        cursor_ = 0;
+        if (size > UINT32_MAX || !scan_json_structurals(data, size, structurals_) || structurals_.empty()) {
+            return false;
+        }
+        size_t first = 0;
+        while (first < size && is_space(data[first])) ++first;
+        if (first >= size || (data[first] != '{' && data[first] != '[')) {
+            return false;
+        }
+        if (!parse_value(first, 0) || cursor_ != structurals_.size()) {
+            tape_.clear();
+            return false;
+        }
+        for (size_t i = tape_[0].end + 1; i < size; ++i) {
+            if (!is_space(data[i])) {
+                tape_.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parse(std::string_view text) { return parse(text.data(), text.size()); }
+
+    JsonValue root() const { return tape_.empty() ? JsonValue() : JsonValue(this, 0); }
+    JsonValue operator[](std::string_view key) const { return root()[key]; }
+    size_t tape_size() const { return tape_.size(); }
+};
+
+inline const JsonToken* JsonValue::token() const { return &parser_->tape_[index_]; }
+
+inline JsonValue JsonValue::operator[](std::string_view key) const {
+    if (!is(JsonType::Object)) {
+        return JsonValue();
+    }
+    const auto& tape = parser_->tape_;
+    const uint32_t end = tape[index_].next;
+    for (uint32_t i = index_ + 1; i < end; i = tape[i + 1].next) {
+        const JsonToken& name = tape[i];
+        if (name.end - name.begin == key.size() &&
+            std::memcmp(parser_->data_ + name.begin, key.data(), key.size()) == 0) {
+            return JsonValue(parser_, i + 1);
+        }
+    }
+    return JsonValue();
+}
+
+inline JsonValue JsonValue::operator[](size_t position) const {
+    if (!is(JsonType::Array)) {
+        return JsonValue();
+    }
+    const auto& tape = parser_->tape_;
+    const uint32_t end = tape[index_].next;
+    for (uint32_t i = index_ + 1; i < end; i = tape[i].next) {
+        if (position-- == 0) {
+            return JsonValue(parser_, i);
+        }
+    }
+    return JsonValue();
+}
+
+template<typename Fn>
+void JsonValue::for_each_member(Fn&& fn) const {
+    if (!is(JsonType::Object)) {
+        return;
+    }
+    const auto& tape = parser_->tape_;
+    for (uint32_t i = index_ + 1; i < tape[index_].next; i = tape[i + 1].next) {
+        fn(JsonValue(parser_, i), JsonValue(parser_, i + 1));
+    }
+}
+
+template<typename Fn>
+void JsonValue::for_each_element(Fn&& fn) const {
+    if (!is(JsonType::Array)) {
+        return;
+    }
+    const auto& tape = parser_->tape_;
+    for (uint32_t i = index_ + 1; i < tape[index_].next; i = tape[i].next) {
+        fn(JsonValue(parser_, i));
+    }
+}
+
+inline size_t JsonValue::size() const {
+    if (!is(JsonType::Array) && !is(JsonType::Object)) {
+        return 0;
+    }
+    const auto& tape = parser_->tape_;
+    size_t count = 0;
+    for (uint32_t i = index_ + 1; i < tape[index_].next; i = tape[i].next) {
+        ++count;
+    }
+    return token()->type == JsonType::Object ? count / 2 : count;
+}
+
+inline std::string_view JsonValue::text() const {
+    if (!is(JsonType::String) && !is(JsonType::Scalar)) {
+        return {};
+    }
+    const JsonToken* t = token();
+    return std::string_view(parser_->data_ + t->begin, t->end - t->begin);
+}
+
+inline double JsonValue::as_double(double fallback) const {
+    const std::string_view digits = text();
+    double value = fallback;
+    if (digits.empty() || std::from_chars(digits.data(), digits.data() + digits.size(), value).ec != std::errc()) {
+        return fallback;
+    }
+    return value;
+}
+
+inline int64_t JsonValue::as_int64(int64_t fallback) const {
+    const std::string_view digits = text();
+    int64_t value = fallback;
+    if (digits.empty() || std::from_chars(digits.data(), digits.data() + digits.size(), value).ec != std::errc()) {
+        return fallback;
+    }
+    return value;
+}
+
+// "2024-01-02T15:04:05.123456Z" (UTC, fraction optional) to nanoseconds
+// since the Unix epoch, 0 if malformed
+inline uint64_t parse_iso8601_ns(std::string_view text) {
+    auto number = [&text](size_t at, size_t digits, int64_t& out) {
+        if (at + digits > text.size()) {
+            return false;
+        }
+        return std::from_chars(text.data() + at, text.data() + at + digits, out).ec == std::errc();
+    };
+    int64_t year, month, day, hour, minute, second;
+    if (!number(0, 4, year) || !number(5, 2, month) || !number(8, 2, day) || !number(11, 2, hour) ||
+        !number(14, 2, minute) || !number(17, 2, second) || month < 1 || month > 12) {
+        return 0;
+    }
+    // Days from civil (Howard Hinnant)
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t year_of_era = year - era * 400;
+    const int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    const int64_t days = era * 146097 + day_of_era - 719468;
+
+    int64_t nanos = 0;
+    if (text.size() > 19 && text[19] == '.') {
+        int64_t scale = 100000000;
+        for (size_t i = 20; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i, scale /= 10) {
+            nanos += (text[i] - '0') * scale;
+        }
+    }
+    const int64_t seconds = ((days * 24 + hour) * 60 + minute) * 60 + second;
+    return seconds < 0 ? 0 : static_cast<uint64_t>(seconds) * 1000000000ull + static_cast<uint64_t>(nanos);
+}
+
+#endif // JSON_SCANNER_H
@@ -0,0 +1,221 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "shared_code.h"
+
+// Publish-to-consume latency, measured on every tick a consumer takes off
+// a ring. The producer stamps TradingTick::publish_ns from CLOCK_MONOTONIC
+// right before publishing; each consumer subtracts it from its own
+// CLOCK_MONOTONIC receive time and records the difference in its slot of
+// /trading_latency. CLOCK_MONOTONIC is system-wide, so C++ and Python
+// consumers (time.monotonic_ns()) share one time base.
+//
+// Histograms are HDR-style log-linear: values below 16 ns get a bucket
+// each, then every power of two is split into 16 sub-buckets, so a
+// recorded value is off by at most 1/16 (6.25%). Values from 2^40 ns
+// (~18 minutes) up land in the last bucket.
+
+constexpr size_t LATENCY_SUB_BUCKET_BITS = 4;
+constexpr size_t LATENCY_SUB_BUCKETS = size_t{1} << LATENCY_SUB_BUCKET_BITS;
+constexpr size_t LATENCY_MAX_BITS = 40;
+constexpr size_t LATENCY_BUCKET_COUNT = (LATENCY_MAX_BITS - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKETS;
+constexpr size_t LATENCY_MAX_CONSUMERS = 16;
+constexpr size_t LATENCY_NAME_SIZE = 24;
+
+inline uint64_t monotonic_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+inline size_t latency_bucket(uint64_t ns) {
+    if (ns < LATENCY_SUB_BUCKETS) {
+        return static_cast<size_t>(ns);
+    }
+    if (ns >= (uint64_t{1} << LATENCY_MAX_BITS)) {
+        return LATENCY_BUCKET_COUNT - 1;
+    }
+    const size_t shift = 63 - __builtin_clzll(ns) - LATENCY_SUB_BUCKET_BITS;
+    return (shift + 1) * LATENCY_SUB_BUCKETS + ((ns >> shift) & (LATENCY_SUB_BUCKETS - 1));
+}
+
+// Largest value that maps to bucket, i.e. what percentiles report
+inline uint64_t latency_bucket_upper(size_t bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS) {
+        return bucket;
+    }
+    const size_t shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    const uint64_t low = (LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) << shift;
+    return low + (uint64_t{1} << shift) - 1;
+}
+
+// One consumer's histogram. The owning consumer is its only writer, so
+// updates are plain relaxed load/store pairs; reporters read them racily
+// and may see a tick in `count` before its bucket, which doesn't matter
+// for percentiles over thousands of samples.
+struct alignas(CACHE_LINE_SIZE) LatencyHistogram {
+    std::atomic<int32_t> pid{0};         // 0 when the slot is free
+    char name[LATENCY_NAME_SIZE];
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> buckets[LATENCY_BUCKET_COUNT];
+
+    void record(uint64_t ns) {
+        auto& bucket = buckets[latency_bucket(ns)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total_ns.store(total_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(ns, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct LatencyTable {
+    LatencyHistogram consumers[LATENCY_MAX_CONSUMERS];
+};
+
+// Python LATENCY_HEADER_FORMAT 'i24s4xQQQ8x' + LATENCY_BUCKET_COUNT 'Q'
+static_assert(offsetof(LatencyHistogram, name) == 4 && offsetof(LatencyHistogram, count) == 32 &&
+              offsetof(LatencyHistogram, max_ns) == 48 && offsetof(LatencyHistogram, buckets) == 64 &&
+              sizeof(LatencyHistogram) == 64 + LATENCY_BUCKET_COUNT * 8,
+              "LatencyHistogram layout is mirrored by Python LATENCY_HEADER_FORMAT");
+
+template<>
+struct SegmentLayout<LatencyTable> {
+    static constexpr const char* type_name = "LatencyTable";
+    static constexpr size_t record_size = sizeof(LatencyHistogram);
+    static constexpr size_t capacity = LATENCY_MAX_CONSUMERS;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "consumers", offsetof(LatencyTable, consumers), sizeof(LatencyTable::consumers));
+        add_segment_field(header, "record.pid", offsetof(LatencyHistogram, pid), sizeof(int32_t));
+        add_segment_field(header, "record.name", offsetof(LatencyHistogram, name), LATENCY_NAME_SIZE);
+        add_segment_field(header, "record.count", offsetof(LatencyHistogram, count), sizeof(uint64_t));
+        add_segment_field(header, "record.total_ns", offsetof(LatencyHistogram, total_ns), sizeof(uint64_t));
+        add_segment_field(header, "record.max_ns", offsetof(LatencyHistogram, max_ns), sizeof(uint64_t));
+        add_segment_field(header, "record.buckets", offsetof(LatencyHistogram, buckets), sizeof(LatencyHistogram::buckets));
+    }
+};
+
+struct LatencySummary {
+    uint64_t count = 0;
+    double mean_ns = 0.0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+inline LatencySummary summarize_latency(const LatencyHistogram& histogram) {
+    uint64_t counts[LATENCY_BUCKET_COUNT];
+    LatencySummary summary;
+    for (size_t i = 0; i < LATENCY_BUCKET_COUNT; ++i) {
+        counts[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        summary.count += counts[i];
+    }
+    if (summary.count == 0) {
+        return summary;
+    }
+    summary.mean_ns = static_cast<double>(histogram.total_ns.load(std::memory_order_relaxed)) /
+                      static_cast<double>(histogram.count.load(std::memory_order_relaxed));
+    summary.max_ns = histogram.max_ns.load(std::memory_order_relaxed);
+
+    // Rank of the sample each percentile names, 1-based like HdrHistogram
+    auto rank = [&summary](double q) { return static_cast<uint64_t>(q * static_cast<double>(summary.count) + 0.5); };
+    const uint64_t targets[4] = {rank(0.50), rank(0.90), rank(0.99), rank(0.999)};
+    uint64_t* outputs[4] = {&summary.p50_ns, &summary.p90_ns, &summary.p99_ns, &summary.p999_ns};
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < LATENCY_BUCKET_COUNT && next < 4; ++i) {
+        seen += counts[i];
+        while (next < 4 && seen >= std::max<uint64_t>(targets[next], 1)) {
+            *outputs[next++] = std::min(latency_bucket_upper(i), summary.max_ns);
+        }
+    }
+    return summary;
+}
+
+// Claims a histogram slot in /trading_latency for one consumer and
+// records into it. Registration is serialized with flock on the segment,
+// like the broadcast reader table; slots of dead processes are reclaimed.
+class LatencyRecorder {
+private:
+    LatencyHistogram* slot_;
+
+public:
+    LatencyRecorder(SharedMemory<LatencyTable>& shm, const char* name) : slot_(nullptr) {
+        const int shm_fd = open_memory_block(shm.name(), shm.options());
+        if (shm_fd == -1) {
+            throw std::runtime_error("Failed to open latency table for consumer registration");
+        }
+        flock(shm_fd, LOCK_EX);
+        for (auto& candidate : shm->consumers) {
+            const int32_t pid = candidate.pid.load(std::memory_order_acquire);
+            if (pid == 0 || (kill(pid, 0) == -1 && errno == ESRCH)) {
+                for (auto& bucket : candidate.buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+                candidate.count.store(0, std::memory_order_relaxed);
+                candidate.total_ns.store(0, std::memory_order_relaxed);
+                candidate.max_ns.store(0, std::memory_order_relaxed);
+                std::memset(candidate.name, 0, LATENCY_NAME_SIZE);
+                std::strncpy(candidate.name, name, LATENCY_NAME_SIZE - 1);
+                candidate.pid.store(getpid(), std::memory_order_release);
+                slot_ = &candidate;
+                break;
+            }
+        }
+        flock(shm_fd, LOCK_UN);
+        close(shm_fd);
+        if (!slot_) {
+            throw std::runtime_error("Latency table is full");
+        }
+    }
+
+    ~LatencyRecorder() {
+        slot_->pid.store(0, std::memory_order_release);
+    }
+
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    // Ticks without a publish stamp (snapshots, replays) are skipped
+    void record(const TradingTick& tick, uint64_t receive_ns) {
+        if (tick.publish_ns != 0 && receive_ns >= tick.publish_ns) {
+            slot_->record(receive_ns - tick.publish_ns);
+        }
+    }
+
+    const LatencyHistogram& histogram() const { return *slot_; }
+};
+
+// One line per registered consumer, for the producer's periodic log
+inline void report_latency(const LatencyTable& table) {
+    for (const auto& histogram : table.consumers) {
+        if (histogram.pid.load(std::memory_order_acquire) == 0) {
+            continue;
+        }
+        const LatencySummary summary = summarize_latency(histogram);
+        if (summary.count == 0) {
+            continue;
+        }
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Latency " << std::string(histogram.name, strnlen(histogram.name, LATENCY_NAME_SIZE))
+                  << " (" << summary.count << " ticks, us): p50 " << summary.p50_ns / 1000.0
+                  << " | p99 " << summary.p99_ns / 1000.0 << " | p99.9 " << summary.p999_ns / 1000.0
+                  << " | max " << summary.max_ns / 1000.0 << std::endl;
+    }
+}
+
+#endif // LATENCY_H
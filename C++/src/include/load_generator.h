@@ -0,0 +1,267 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "trading_system.h"
+
+// Synthetic load: thousands of random-walk symbols published at a target
+// tick rate, optionally with periodic bursts, for capacity planning of
+// the rings and consumers.
+
+// xoshiro256++ (Blackman & Vigna): 32 bytes of state and about a
+// nanosecond per draw, against mt19937's 2.5 KB. Seeded through
+// splitmix64 as its authors recommend. Also usable as a standard
+// UniformRandomBitGenerator.
+class Xoshiro256 {
+private:
+    uint64_t state_[4];
+    double spare_normal_ = 0.0;
+    bool has_spare_ = false;
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+    explicit Xoshiro256(uint64_t seed) {
+        for (auto& word : state_) {
+            seed += 0x9e3779b97f4a7c15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    result_type operator()() { return next(); }
+
+    // [0, 1) from the top 53 bits
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+    double uniform(double low, double high) { return low + (high - low) * uniform(); }
+
+    // [0, n) by multiply-shift (Lemire); the bias is below 2^-64 * n
+    uint64_t below(uint64_t n) { return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64); }
+
+    // Standard normal, Marsaglia polar method; every other call is free
+    double normal() {
+        if (has_spare_) {
+            has_spare_ = false;
+            return spare_normal_;
+        }
+        double u, v, s;
+        do {
+            u = uniform(-1.0, 1.0);
+            v = uniform(-1.0, 1.0);
+            s = u * u + v * v;
+        } while (s >= 1.0 || s == 0.0);
+        const double factor = std::sqrt(-2.0 * std::log(s) / s);
+        spare_normal_ = v * factor;
+        has_spare_ = true;
+        return u * factor;
+    }
+};
+
+struct LoadOptions {
+    size_t symbols = 0;            // synthetic symbols, 0 = load mode off
+    double rate = 100000.0;        // baseline ticks per second over all symbols
+    double burst_factor = 1.0;     // rate multiplier inside a burst
+    uint32_t burst_ms = 0;         // burst length, 0 = steady rate
+    uint32_t burst_period_ms = 1000;
+    double volatility = 0.001;     // largest per-tick log-return stddev a symbol gets
+    uint64_t seed = 0;             // 0 = from std::random_device
+
+    bool enabled() const { return symbols > 0; }
+
+    // "4x:50/1000" = 4x the rate for 50 ms of every 1000 ms
+    void set_burst(const std::string& value) {
+        double factor = 0.0;
+        unsigned on = 0, period = 0;
+        char tail = 0;
+        if (std::sscanf(value.c_str(), "%lfx:%u/%u%c", &factor, &on, &period, &tail) != 3 ||
+            factor <= 0.0 || period == 0 || on > period) {
+            throw std::runtime_error("Invalid load burst: " + value + " (use <factor>x:<on_ms>/<period_ms>, e.g. 4x:50/1000)");
+        }
+        burst_factor = factor;
+        burst_ms = on;
+        burst_period_ms = period;
+    }
+
+    // Ticks a generator at this rate and burst pattern has sent after `elapsed`
+    double expected_ticks(std::chrono::nanoseconds elapsed) const {
+        const double seconds = elapsed.count() / 1e9;
+        if (burst_ms == 0 || burst_factor == 1.0) {
+            return rate * seconds;
+        }
+        const uint64_t ms = static_cast<uint64_t>(elapsed.count() / 1'000'000);
+        const double burst_seconds = (ms / burst_period_ms * burst_ms +
+                                      std::min<uint64_t>(ms % burst_period_ms, burst_ms)) / 1e3;
+        return rate * (seconds + (burst_factor - 1.0) * burst_seconds);
+    }
+
+    double rate_at(std::chrono::nanoseconds elapsed) const {
+        const uint64_t ms = static_cast<uint64_t>(elapsed.count() / 1'000'000);
+        return burst_ms > 0 && ms % burst_period_ms < burst_ms ? rate * burst_factor : rate;
+    }
+};
+
+// Geometric random walk per symbol: log price moves by drift + volatility * N(0,1)
+// each tick the symbol gets; volume is lognormal around the symbol's own mean.
+struct SymbolModel {
+    double price;
+    double drift;
+    double volatility;
+    double mean_volume;
+    uint16_t symbol_index;
+};
+
+class LoadGenerator {
+private:
+    Xoshiro256 rng_;
+    std::vector<SymbolModel> models_;
+
+public:
+    // symbol_indices[i] is the /market_data slot of synthetic symbol i
+    LoadGenerator(const LoadOptions& options, const std::vector<int32_t>& symbol_indices)
+        : rng_(options.seed != 0 ? options.seed : (uint64_t{std::random_device{}()} << 32) | std::random_device{}()) {
+        models_.reserve(symbol_indices.size());
+        for (const int32_t index : symbol_indices) {
+            SymbolModel model;
+            model.price = std::exp(rng_.uniform(std::log(5.0), std::log(500.0)));
+            model.volatility = options.volatility * rng_.uniform(0.1, 1.0);
+            model.drift = model.volatility * 0.01 * rng_.normal();
+            model.mean_volume = std::exp(rng_.uniform(std::log(1e3), std::log(1e6)));
+            model.symbol_index = static_cast<uint16_t>(index);
+            models_.push_back(model);
+        }
+    }
+
+    // "SYM0000".."SYM4095", the names load mode registers in /market_data
+    static std::string symbol_name(size_t i) {
+        char name[24];  // "SYM" + up to 20 digits + NUL
+        std::snprintf(name, sizeof(name), "SYM%04zu", i);
+        return name;
+    }
+
+    void next(TradingTick& tick, uint64_t timestamp) {
+        SymbolModel& model = models_[rng_.below(models_.size())];
+        model.price *= std::exp(model.drift + model.volatility * rng_.normal());
+        tick.price = model.price;
+        tick.volume = static_cast<int32_t>(std::min(model.mean_volume * std::exp(0.5 * rng_.normal()), 2e9));
+        tick.timestamp = timestamp;
+        tick.valid = true;
+        tick.symbol_index = model.symbol_index;
+    }
+};
+
+// One reporting window of run_load
+struct LoadReport {
+    double seconds = 0.0;
+    uint64_t target_ticks = 0;
+    uint64_t sent_ticks = 0;
+    uint64_t backlog = 0;     // ticks due but not yet sent at the end of the window
+
+    double shortfall_pct() const {
+        return target_ticks > sent_ticks ? 100.0 * (target_ticks - sent_ticks) / target_ticks : 0.0;
+    }
+};
+
+constexpr size_t LOAD_MAX_BATCH = 1024;                   // ticks per notify
+constexpr auto LOAD_REPORT_INTERVAL = std::chrono::seconds(1);
+constexpr auto LOAD_MIN_SLEEP = std::chrono::microseconds(20);
+constexpr auto LOAD_MAX_SLEEP = std::chrono::milliseconds(10);
+
+// Sends ticks so the running total tracks options.expected_ticks(elapsed):
+// whatever is due goes out in batches of up to LOAD_MAX_BATCH with a
+// flush() after each, then the loop waits roughly one tick interval in
+// wait_until(deadline), which may return early. A generator that can't
+// keep up carries at most one second of backlog; ticks due beyond that
+// are abandoned and show up as shortfall.
+//
+// options.rate may change between iterations (a SetRate command applied
+// from flush() or wait_until()); the schedule then restarts from that moment at the new
+// rate, carrying over the ticks already due.
+template<typename Publish, typename Flush, typename WaitUntil, typename Report>
+void run_load(LoadGenerator& generator, const LoadOptions& options, const std::atomic<bool>& running,
+              Publish&& publish, Flush&& flush, WaitUntil&& wait_until, Report&& report) {
+    using clock = std::chrono::steady_clock;
+    LoadOptions schedule = options;
+    auto start = clock::now();
+    uint64_t max_backlog = static_cast<uint64_t>(std::max(schedule.rate * schedule.burst_factor, 1.0));
+    double scheduled = 0.0;  // ticks due under earlier rates
+    uint64_t sent = 0;
+    uint64_t abandoned = 0;
+    auto window_start = start;
+    uint64_t window_target_start = 0;
+    uint64_t window_sent_start = 0;
+    TradingTick tick;
+
+    while (running) {
+        const auto now = clock::now();
+        if (options.rate != schedule.rate) {
+            scheduled += schedule.expected_ticks(now - start);
+            schedule.rate = options.rate;
+            start = now;
+            max_backlog = static_cast<uint64_t>(std::max(schedule.rate * schedule.burst_factor, 1.0));
+        }
+        const uint64_t due = static_cast<uint64_t>(scheduled + schedule.expected_ticks(now - start)) - abandoned;
+        if (due > sent + max_backlog) {
+            abandoned += due - sent - max_backlog;
+        }
+        const uint64_t pending = std::min<uint64_t>(due - std::min(due, sent), max_backlog);
+
+        if (pending > 0) {
+            const uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            const size_t batch = static_cast<size_t>(std::min<uint64_t>(pending, LOAD_MAX_BATCH));
+            for (size_t i = 0; i < batch; ++i) {
+                generator.next(tick, timestamp);
+                publish(tick);
+            }
+            flush();
+            sent += batch;
+        } else {
+            const auto interval = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / schedule.rate_at(now - start)));
+            wait_until(now + std::clamp<std::chrono::nanoseconds>(interval, LOAD_MIN_SLEEP, LOAD_MAX_SLEEP));
+        }
+
+        if (now - window_start >= LOAD_REPORT_INTERVAL) {
+            const uint64_t target = static_cast<uint64_t>(scheduled + schedule.expected_ticks(now - start));
+            LoadReport window;
+            window.seconds = std::chrono::duration<double>(now - window_start).count();
+            window.target_ticks = target - window_target_start;
+            window.sent_ticks = sent - window_sent_start;
+            window.backlog = target - abandoned > sent ? target - abandoned - sent : 0;
+            report(window);
+            window_start = now;
+            window_target_start = target;
+            window_sent_start = sent;
+        }
+    }
+}
+
+#endif // LOAD_GENERATOR_H
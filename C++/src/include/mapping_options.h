@@ -0,0 +1,181 @@
+#ifndef MAPPING_OPTIONS_H
+#define MAPPING_OPTIONS_H
+
+#include <sys/mman.h>    // mmap, madvise, mlock
+#include <sys/syscall.h> // SYS_mbind
+#include <sys/vfs.h>     // statfs, for the hugetlbfs page size
+#include <linux/mempolicy.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// How a segment is backed and placed. Every option degrades to a plain
+// 4 KiB tmpfs mapping with a log line when the system can't provide it,
+// so the same binary runs on a laptop and on a tuned box.
+//
+//   thp            madvise(MADV_HUGEPAGE) on the /dev/shm mapping; needs
+//                  /sys/kernel/mm/transparent_hugepage/shmem_enabled = advise
+//   hugetlbfs[:d]  back the segment by a file in hugetlbfs mount d
+//                  (default /dev/hugepages) from the reserved huge page pool.
+//                  Such segments are not in /dev/shm and hugetlbfs only maps
+//                  at huge page offsets, so Python readers can't attach:
+//                  use it for segments only C++ consumers read
+//   populate       prefault every page at map time (MAP_POPULATE)
+//   lock           mlock the mapping so it is never paged out (RLIMIT_MEMLOCK)
+//   numa:<n>       mbind the segment's pages to NUMA node n
+enum class HugePageMode {
+    None,
+    Transparent,
+    HugeTlbfs
+};
+
+struct MappingOptions {
+    HugePageMode huge_pages = HugePageMode::None;
+    std::string hugetlbfs_dir = "/dev/hugepages";
+    bool populate = false;
+    bool lock = false;
+    int numa_node = -1;
+
+    // Comma-separated options from the table above, e.g. "thp,populate,lock,numa:0"
+    static MappingOptions parse(const std::string& spec) {
+        MappingOptions options;
+        size_t start = 0;
+        while (start <= spec.size()) {
+            const size_t comma = std::min(spec.find(',', start), spec.size());
+            const std::string token = spec.substr(start, comma - start);
+            start = comma + 1;
+            if (token.empty()) {
+                continue;
+            }
+            const auto colon = token.find(':');
+            const std::string kind = token.substr(0, colon);
+            const std::string arg = colon == std::string::npos ? "" : token.substr(colon + 1);
+
+            if (kind == "thp") {
+                options.huge_pages = HugePageMode::Transparent;
+            } else if (kind == "hugetlbfs") {
+                options.huge_pages = HugePageMode::HugeTlbfs;
+                if (!arg.empty()) {
+                    options.hugetlbfs_dir = arg;
+                }
+            } else if (kind == "populate") {
+                options.populate = true;
+            } else if (kind == "lock") {
+                options.lock = true;
+            } else if (kind == "numa" && !arg.empty()) {
+                options.numa_node = std::stoi(arg);
+            } else {
+                throw std::runtime_error("Unknown shared memory option: " + token);
+            }
+        }
+        return options;
+    }
+
+    static MappingOptions from_env(const char* variable = "TRADING_SHM_OPTIONS") {
+        const char* spec = std::getenv(variable);
+        return spec ? parse(spec) : MappingOptions{};
+    }
+
+    // Path of the hugetlbfs file standing in for shm object `filename` ("/name")
+    std::string hugetlbfs_path(const char* filename) const {
+        return hugetlbfs_dir + filename;
+    }
+};
+
+// Page size of the filesystem behind fd (the huge page size on hugetlbfs)
+inline size_t backing_page_size(int fd) {
+    struct statfs fs{};
+    if (fstatfs(fd, &fs) == -1 || fs.f_bsize <= 0) {
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+    return static_cast<size_t>(fs.f_bsize);
+}
+
+inline size_t round_up_to(size_t size, size_t granularity) {
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+inline void advise_transparent_huge_pages(char* memory, size_t size, const char* filename) {
+    std::ifstream setting("/sys/kernel/mm/transparent_hugepage/shmem_enabled");
+    std::string line;
+    std::getline(setting, line);
+    if (line.find("[never]") != std::string::npos || line.find("[deny]") != std::string::npos) {
+        std::cout << "Huge pages: shmem THP disabled (shmem_enabled: " << line << "), "
+                  << filename << " stays on 4 KiB pages" << std::endl;
+        return;
+    }
+    if (madvise(memory, size, MADV_HUGEPAGE) == -1) {
+        std::cout << "Huge pages: madvise(MADV_HUGEPAGE) failed for " << filename << " ("
+                  << strerror(errno) << "), staying on 4 KiB pages" << std::endl;
+    }
+}
+
+// Allocation policy for the segment's pages. Only pages faulted in after
+// the call follow it (MPOL_MF_MOVE migrates the ones we already own), so
+// this runs before prefaulting.
+inline void bind_to_numa_node(char* memory, size_t size, int node, const char* filename) {
+    constexpr int MAX_NODES = 1024;
+    const std::string node_dir = "/sys/devices/system/node/node" + std::to_string(node);
+    if (node < 0 || node >= MAX_NODES || access(node_dir.c_str(), F_OK) != 0) {
+        std::cout << "NUMA: node " << node << " not present, " << filename
+                  << " uses the default allocation policy" << std::endl;
+        return;
+    }
+    unsigned long mask[MAX_NODES / (8 * sizeof(unsigned long))] = {};
+    mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+    if (syscall(SYS_mbind, memory, size, MPOL_BIND, mask, MAX_NODES, MPOL_MF_MOVE) == -1) {
+        std::cout << "NUMA: mbind to node " << node << " failed for " << filename << " ("
+                  << strerror(errno) << "), using the default allocation policy" << std::endl;
+    }
+}
+
+// Fault every page in without changing its contents
+inline void prefault_pages(char* memory, size_t size) {
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(memory, size, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    // Read faults on shmem allocate the page too, and never race a writer
+    const volatile char* pages = memory;
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t offset = 0; offset < size; offset += page) {
+        (void)pages[offset];
+    }
+}
+
+// mmap an open segment fd and apply the options. Huge page, NUMA, populate
+// and lock failures only log; the mapping itself failing returns MAP_FAILED.
+inline char* map_with_options(int fd, size_t size, const MappingOptions& options, const char* filename) {
+    // MAP_POPULATE would fault pages before mbind could place them
+    const int flags = MAP_SHARED | (options.populate && options.numa_node < 0 ? MAP_POPULATE : 0);
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (mapped == MAP_FAILED) {
+        return static_cast<char*>(MAP_FAILED);
+    }
+    char* memory = static_cast<char*>(mapped);
+
+    if (options.huge_pages == HugePageMode::Transparent) {
+        advise_transparent_huge_pages(memory, size, filename);
+    }
+    if (options.numa_node >= 0) {
+        bind_to_numa_node(memory, size, options.numa_node, filename);
+        if (options.populate) {
+            prefault_pages(memory, size);
+        }
+    }
+    if (options.lock && mlock(memory, size) == -1) {
+        std::cout << "mlock failed for " << filename << " (" << strerror(errno)
+                  << "), pages may be swapped out; raise ulimit -l" << std::endl;
+    }
+    return memory;
+}
+
+#endif // MAPPING_OPTIONS_H
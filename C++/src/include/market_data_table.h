@@ -0,0 +1,141 @@
+#ifndef MARKET_DATA_TABLE_H
+#define MARKET_DATA_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "shared_code.h"
+
+// Multi-symbol market data segment: one cache-line slot per symbol plus an
+// open-addressing directory mapping symbol -> slot index. The directory
+// hash is FNV-1a over the symbol bytes so Python can probe it identically.
+// Single writer: only the producer adds symbols and publishes ticks.
+
+constexpr size_t SYMBOL_NAME_SIZE = 16;
+constexpr size_t MARKET_TABLE_CAPACITY = 4096;
+constexpr size_t MARKET_DIRECTORY_SIZE = 2 * MARKET_TABLE_CAPACITY;
+
+inline uint64_t symbol_hash(const char* symbol) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < SYMBOL_NAME_SIZE && symbol[i] != '\0'; ++i) {
+        hash ^= static_cast<uint8_t>(symbol[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+inline bool symbol_equals(const char (&stored)[SYMBOL_NAME_SIZE], const char* symbol) {
+    return std::strncmp(stored, symbol, SYMBOL_NAME_SIZE) == 0;
+}
+
+struct alignas(CACHE_LINE_SIZE) SymbolSlot {
+    TradingData data;
+    char symbol[SYMBOL_NAME_SIZE];
+};
+
+struct DirectoryEntry {
+    std::atomic<uint32_t> slot_plus_one{0};  // 0 marks an empty entry
+    uint32_t hash_tag = 0;                   // low 32 bits of symbol_hash
+    char symbol[SYMBOL_NAME_SIZE];
+};
+
+template<size_t Capacity, size_t DirectorySize>
+struct MarketDataTable {
+    static_assert(DirectorySize >= 2 * Capacity, "Directory must stay at most half full");
+    static_assert((DirectorySize & (DirectorySize - 1)) == 0, "Directory size must be a power of two");
+
+    static constexpr size_t capacity = Capacity;
+    static constexpr size_t directory_size = DirectorySize;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> count{0};
+    alignas(CACHE_LINE_SIZE) DirectoryEntry directory[DirectorySize];
+    SymbolSlot slots[Capacity];
+
+    // Slot index for symbol, or -1 if it has not been added
+    int32_t find(const char* symbol) const {
+        const uint64_t hash = symbol_hash(symbol);
+        for (size_t probe = 0; probe < DirectorySize; ++probe) {
+            const DirectoryEntry& entry = directory[(hash + probe) & (DirectorySize - 1)];
+            const uint32_t slot = entry.slot_plus_one.load(std::memory_order_acquire);
+            if (slot == 0) {
+                return -1;
+            }
+            if (entry.hash_tag == static_cast<uint32_t>(hash) && symbol_equals(entry.symbol, symbol)) {
+                return static_cast<int32_t>(slot - 1);
+            }
+        }
+        return -1;
+    }
+
+    // Writer only. Returns the existing index if the symbol is already present.
+    int32_t add_symbol(const char* symbol) {
+        if (std::strlen(symbol) >= SYMBOL_NAME_SIZE) {
+            throw std::runtime_error("Symbol name too long: " + std::string(symbol));
+        }
+        const int32_t existing = find(symbol);
+        if (existing >= 0) {
+            return existing;
+        }
+
+        const uint32_t index = count.load(std::memory_order_relaxed);
+        if (index >= Capacity) {
+            throw std::runtime_error("Market data table is full");
+        }
+
+        SymbolSlot& slot = slots[index];
+        std::strncpy(slot.symbol, symbol, SYMBOL_NAME_SIZE);
+
+        const uint64_t hash = symbol_hash(symbol);
+        for (size_t probe = 0; probe < DirectorySize; ++probe) {
+            DirectoryEntry& entry = directory[(hash + probe) & (DirectorySize - 1)];
+            if (entry.slot_plus_one.load(std::memory_order_relaxed) == 0) {
+                entry.hash_tag = static_cast<uint32_t>(hash);
+                std::strncpy(entry.symbol, symbol, SYMBOL_NAME_SIZE);
+                entry.slot_plus_one.store(index + 1, std::memory_order_release);
+                break;
+            }
+        }
+
+        count.store(index + 1, std::memory_order_release);
+        return static_cast<int32_t>(index);
+    }
+
+    TradingData& at(int32_t index) { return slots[index].data; }
+    const TradingData& at(int32_t index) const { return slots[index].data; }
+    const char* symbol_at(int32_t index) const { return slots[index].symbol; }
+
+    uint32_t size() const { return count.load(std::memory_order_acquire); }
+};
+
+using MarketData = MarketDataTable<MARKET_TABLE_CAPACITY, MARKET_DIRECTORY_SIZE>;
+
+template<>
+struct SegmentLayout<MarketData> {
+    static constexpr const char* type_name = "MarketData";
+    static constexpr size_t record_size = sizeof(SymbolSlot);
+    static constexpr size_t capacity = MARKET_TABLE_CAPACITY;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "count", offsetof(MarketData, count), sizeof(uint32_t));
+        add_segment_field(header, "directory", offsetof(MarketData, directory), sizeof(MarketData::directory));
+        add_segment_field(header, "entry.slot_plus_one", offsetof(DirectoryEntry, slot_plus_one), sizeof(uint32_t));
+        add_segment_field(header, "entry.hash_tag", offsetof(DirectoryEntry, hash_tag), sizeof(uint32_t));
+        add_segment_field(header, "entry.symbol", offsetof(DirectoryEntry, symbol), SYMBOL_NAME_SIZE);
+        add_segment_field(header, "slots", offsetof(MarketData, slots), sizeof(MarketData::slots));
+        add_segment_field(header, "record.sequence", offsetof(TradingData, sequence), sizeof(uint64_t));
+        add_segment_field(header, "record.price", offsetof(TradingData, price), sizeof(double));
+        add_segment_field(header, "record.timestamp", offsetof(TradingData, timestamp), sizeof(uint64_t));
+        add_segment_field(header, "record.volume", offsetof(TradingData, volume), sizeof(int32_t));
+        add_segment_field(header, "record.valid", offsetof(TradingData, valid), sizeof(bool));
+        add_segment_field(header, "record.symbol", offsetof(SymbolSlot, symbol), SYMBOL_NAME_SIZE);
+    }
+};
+
+static_assert(sizeof(DirectoryEntry) == 24, "Python MARKET_ENTRY_FORMAT");
+static_assert(offsetof(SymbolSlot, symbol) == 32 && sizeof(SymbolSlot) == 64, "Python MARKET_SLOT_FORMAT");
+static_assert(offsetof(MarketData, directory) == 64, "Python MARKET_DIRECTORY_OFFSET");
+static_assert(offsetof(MarketData, slots) == 64 + MARKET_DIRECTORY_SIZE * 24, "Python MARKET_SLOTS_OFFSET");
+
+#endif // MARKET_DATA_TABLE_H
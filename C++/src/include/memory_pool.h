@@ -0,0 +1,433 @@
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "segment_header.h"
+
+// Allocation for hot paths, so steady-state processing never reaches the
+// heap:
+//   FixedBlockPool / ObjectPool<T>   fixed-size blocks on an intrusive free list
+//   BumpArena / thread_arena()       per-thread bump allocation, freed all at once
+//   PoolAllocator / ArenaAllocator   the two above as standard allocators
+//   SharedObjectPool<T, N>           index-based pool inside a SharedMemory segment
+//   HotPathAllocations               heap allocations made inside a hot path after warmup
+
+// --- Allocation counting ---------------------------------------------------
+
+// Heap allocations the calling thread made through operator new. Only
+// counted in programs that expand TRADING_COUNT_ALLOCATIONS() once at
+// namespace scope; nothrow overloads are not counted.
+inline uint64_t& thread_allocation_count() {
+    thread_local uint64_t count = 0;
+    return count;
+}
+
+inline bool& allocation_counting_enabled() {
+    static bool enabled = false;
+    return enabled;
+}
+
+inline void* counted_allocation(std::size_t size, std::size_t alignment) {
+    ++thread_allocation_count();
+    void* memory = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        memory = std::malloc(size != 0 ? size : 1);
+    } else if (posix_memalign(&memory, alignment, size != 0 ? size : 1) != 0) {
+        memory = nullptr;
+    }
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+// The whole replaceable set, scalar, array and aligned, so every delete
+// frees what a counted new malloc'd. noinline keeps GCC from pairing an
+// inlined std::free with the builtin new (-Wmismatched-new-delete).
+#define TRADING_COUNT_ALLOCATIONS()                                                                    \
+    __attribute__((noinline)) void* operator new(std::size_t size) {                                   \
+        return counted_allocation(size, alignof(std::max_align_t));                                    \
+    }                                                                                                  \
+    __attribute__((noinline)) void* operator new[](std::size_t size) {                                 \
+        return counted_allocation(size, alignof(std::max_align_t));                                    \
+    }                                                                                                  \
+    __attribute__((noinline)) void* operator new(std::size_t size, std::align_val_t alignment) {       \
+        return counted_allocation(size, static_cast<std::size_t>(alignment));                          \
+    }                                                                                                  \
+    __attribute__((noinline)) void* operator new[](std::size_t size, std::align_val_t alignment) {     \
+        return counted_allocation(size, static_cast<std::size_t>(alignment));                          \
+    }                                                                                                  \
+    __attribute__((noinline)) void operator delete(void* memory) noexcept { std::free(memory); }       \
+    __attribute__((noinline)) void operator delete[](void* memory) noexcept { std::free(memory); }     \
+    __attribute__((noinline)) void operator delete(void* memory, std::size_t) noexcept { std::free(memory); } \
+    __attribute__((noinline)) void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); } \
+    __attribute__((noinline)) void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); } \
+    __attribute__((noinline)) void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); } \
+    __attribute__((noinline)) void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { \
+        std::free(memory);                                                                             \
+    }                                                                                                  \
+    __attribute__((noinline)) void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { \
+        std::free(memory);                                                                             \
+    }                                                                                                  \
+    static const bool trading_allocation_counting = (allocation_counting_enabled() = true)
+
+// Allocations made inside a thread's hot path once its warmup is over.
+// Wrap each pass through the hot path in a Section; the owning thread
+// adds, any thread may read. A section costs two thread-local reads and
+// only looks at the clock when something was allocated.
+class HotPathAllocations {
+private:
+    std::atomic<uint64_t> count_{0};
+    std::chrono::steady_clock::time_point warm_after_;
+
+public:
+    explicit HotPathAllocations(std::chrono::steady_clock::duration warmup = std::chrono::seconds(2))
+        : warm_after_(std::chrono::steady_clock::now() + warmup) {}
+
+    class Section {
+    private:
+        HotPathAllocations& owner_;
+        uint64_t start_;
+
+    public:
+        explicit Section(HotPathAllocations& owner) : owner_(owner), start_(thread_allocation_count()) {}
+        ~Section() {
+            const uint64_t made = thread_allocation_count() - start_;
+            if (made != 0 && std::chrono::steady_clock::now() >= owner_.warm_after_) {
+                owner_.count_.fetch_add(made, std::memory_order_relaxed);
+            }
+        }
+        Section(const Section&) = delete;
+        Section& operator=(const Section&) = delete;
+    };
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+};
+
+// --- Fixed-size blocks -----------------------------------------------------
+
+// Blocks of one size carved from chunks that are only returned when the
+// pool is destroyed. Free blocks hold the free-list link themselves.
+// Single-threaded, like the engines that own them.
+class FixedBlockPool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    size_t block_size_;
+    size_t blocks_per_chunk_;
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    FreeBlock* free_ = nullptr;
+    size_t capacity_ = 0;
+    size_t in_use_ = 0;
+
+    void grow(size_t blocks) {
+        auto chunk = std::make_unique<std::byte[]>(blocks * block_size_);
+        // Thread the new blocks onto the free list in address order
+        for (size_t i = blocks; i > 0; --i) {
+            auto* block = reinterpret_cast<FreeBlock*>(chunk.get() + (i - 1) * block_size_);
+            block->next = free_;
+            free_ = block;
+        }
+        chunks_.push_back(std::move(chunk));
+        capacity_ += blocks;
+    }
+
+public:
+    explicit FixedBlockPool(size_t block_size, size_t blocks_per_chunk = 1024)
+        : block_size_((std::max(block_size, sizeof(FreeBlock)) + alignof(std::max_align_t) - 1) /
+                      alignof(std::max_align_t) * alignof(std::max_align_t)),
+          blocks_per_chunk_(blocks_per_chunk) {
+        chunks_.reserve(64);
+    }
+
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    void* allocate() {
+        if (!free_) {
+            grow(blocks_per_chunk_);
+        }
+        FreeBlock* block = free_;
+        free_ = block->next;
+        ++in_use_;
+        return block;
+    }
+
+    void deallocate(void* memory) {
+        auto* block = static_cast<FreeBlock*>(memory);
+        block->next = free_;
+        free_ = block;
+        --in_use_;
+    }
+
+    // Grow ahead of time so the first `blocks` allocations never reach the heap
+    void reserve(size_t blocks) {
+        if (blocks > capacity_) {
+            grow(blocks - capacity_);
+        }
+    }
+
+    size_t block_size() const { return block_size_; }
+    size_t capacity() const { return capacity_; }
+    size_t in_use() const { return in_use_; }
+    size_t chunks() const { return chunks_.size(); }
+};
+
+// Typed objects from a FixedBlockPool; pointers stay valid until destroy()
+template<typename T>
+class ObjectPool {
+private:
+    FixedBlockPool blocks_;
+
+public:
+    explicit ObjectPool(size_t objects_per_chunk = 1024) : blocks_(sizeof(T), objects_per_chunk) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "ObjectPool blocks are max_align_t aligned");
+    }
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        void* memory = blocks_.allocate();
+        try {
+            return new (memory) T{std::forward<Args>(args)...};
+        } catch (...) {
+            blocks_.deallocate(memory);
+            throw;
+        }
+    }
+
+    void destroy(T* object) {
+        object->~T();
+        blocks_.deallocate(object);
+    }
+
+    void reserve(size_t objects) { blocks_.reserve(objects); }
+    size_t capacity() const { return blocks_.capacity(); }
+    size_t in_use() const { return blocks_.in_use(); }
+};
+
+// Standard allocator over a shared FixedBlockPool, for node containers
+// (std::list, std::map, std::unordered_map). Single-object requests that
+// fit a block come from the pool; arrays (hash buckets) and larger nodes
+// go to operator new, so reserve() bucket counts up front.
+template<typename T>
+class PoolAllocator {
+private:
+    FixedBlockPool* pool_;
+
+    template<typename U> friend class PoolAllocator;
+
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(FixedBlockPool& pool) noexcept : pool_(&pool) {}
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+    T* allocate(size_t n) {
+        if (n == 1 && sizeof(T) <= pool_->block_size() && alignof(T) <= alignof(std::max_align_t)) {
+            return static_cast<T*>(pool_->allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* memory, size_t n) noexcept {
+        if (n == 1 && sizeof(T) <= pool_->block_size() && alignof(T) <= alignof(std::max_align_t)) {
+            pool_->deallocate(memory);
+        } else {
+            ::operator delete(memory);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return pool_ == other.pool_; }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept { return pool_ != other.pool_; }
+};
+
+// --- Bump arena ------------------------------------------------------------
+
+// Allocation is a pointer bump inside the current chunk; nothing is freed
+// individually. reset() rewinds to the first chunk and keeps every chunk
+// for reuse, so a per-message or per-batch arena stops allocating once it
+// has seen its largest batch.
+class BumpArena {
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size;
+    };
+
+    size_t chunk_size_;
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;   // chunk being bumped
+    size_t offset_ = 0;    // bytes used in it
+    size_t used_ = 0;      // bytes handed out since the last reset
+
+public:
+    explicit BumpArena(size_t chunk_size = 64 * 1024) : chunk_size_(chunk_size) {
+        chunks_.reserve(16);
+    }
+
+    BumpArena(const BumpArena&) = delete;
+    BumpArena& operator=(const BumpArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        for (;;) {
+            if (current_ < chunks_.size()) {
+                Chunk& chunk = chunks_[current_];
+                const auto base = reinterpret_cast<uintptr_t>(chunk.memory.get());
+                const size_t aligned = ((base + offset_ + alignment - 1) & ~(uintptr_t{alignment} - 1)) - base;
+                if (aligned + size <= chunk.size) {
+                    offset_ = aligned + size;
+                    used_ += size;
+                    return chunk.memory.get() + aligned;
+                }
+                if (current_ + 1 < chunks_.size()) {
+                    ++current_;
+                    offset_ = 0;
+                    continue;
+                }
+            }
+            const size_t bytes = std::max(chunk_size_, size + alignment);
+            chunks_.push_back(Chunk{std::make_unique<std::byte[]>(bytes), bytes});
+            current_ = chunks_.size() - 1;
+            offset_ = 0;
+        }
+    }
+
+    template<typename T>
+    T* allocate_array(size_t n) {
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void reset() {
+        current_ = 0;
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    size_t used() const { return used_; }
+    size_t chunks() const { return chunks_.size(); }
+};
+
+// One arena per thread, for scratch space that dies with the current batch
+inline BumpArena& thread_arena() {
+    thread_local BumpArena arena;
+    return arena;
+}
+
+// Standard allocator over a BumpArena; deallocate is a no-op, memory comes
+// back on the arena's reset()
+template<typename T>
+class ArenaAllocator {
+private:
+    BumpArena* arena_;
+
+    template<typename U> friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(BumpArena& arena = thread_arena()) noexcept : arena_(&arena) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+    T* allocate(size_t n) { return arena_->allocate_array<T>(n); }
+    void deallocate(T*, size_t) noexcept {}
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena_ == other.arena_; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena_ != other.arena_; }
+};
+
+// --- Shared memory pool ----------------------------------------------------
+
+// Fixed pool of N records shared by several processes through
+// SharedMemory<SharedObjectPool<T, N>>. Records are named by index, since
+// every process maps the segment at a different address. Free records sit
+// on a lock-free stack whose head carries a tag against ABA; records never
+// handed out are taken from `bump`, so a zero-filled segment is a valid
+// empty pool. A process that dies holding records leaks them.
+template<typename T, size_t N>
+struct SharedObjectPool {
+    static_assert(std::is_trivially_copyable_v<T>, "Shared pool records must be trivially copyable");
+    static_assert(N < UINT32_MAX, "Shared pool indices are 32-bit");
+
+    static constexpr size_t capacity = N;
+    static constexpr uint32_t none = UINT32_MAX;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> free_head{0};  // tag << 32 | (index + 1), 0 = empty
+    std::atomic<uint32_t> bump{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> in_use{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> next[N];         // free-stack links, index + 1
+    alignas(CACHE_LINE_SIZE) T records[N];
+
+    // Index of a free record, or `none` when all N are taken
+    uint32_t allocate() {
+        uint64_t head = free_head.load(std::memory_order_acquire);
+        while ((head & 0xffffffffu) != 0) {
+            const uint32_t index = static_cast<uint32_t>(head & 0xffffffffu) - 1;
+            const uint64_t replacement = ((head >> 32) + 1) << 32 | next[index].load(std::memory_order_relaxed);
+            if (free_head.compare_exchange_weak(head, replacement, std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+                in_use.fetch_add(1, std::memory_order_relaxed);
+                return index;
+            }
+        }
+        uint32_t fresh = bump.load(std::memory_order_relaxed);
+        while (fresh < N) {
+            if (bump.compare_exchange_weak(fresh, fresh + 1, std::memory_order_relaxed)) {
+                in_use.fetch_add(1, std::memory_order_relaxed);
+                return fresh;
+            }
+        }
+        // Another process may have freed a record meanwhile; callers retry if they must
+        return none;
+    }
+
+    void release(uint32_t index) {
+        uint64_t head = free_head.load(std::memory_order_relaxed);
+        uint64_t replacement;
+        do {
+            next[index].store(static_cast<uint32_t>(head & 0xffffffffu), std::memory_order_relaxed);
+            replacement = ((head >> 32) + 1) << 32 | (index + 1);
+        } while (!free_head.compare_exchange_weak(head, replacement, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+        in_use.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    T& at(uint32_t index) { return records[index]; }
+    const T& at(uint32_t index) const { return records[index]; }
+    uint32_t size() const { return in_use.load(std::memory_order_relaxed); }
+};
+
+template<typename T, size_t N>
+struct SegmentLayout<SharedObjectPool<T, N>> {
+    using Pool = SharedObjectPool<T, N>;
+    static constexpr const char* type_name = "SharedObjectPool";
+    static constexpr size_t record_size = sizeof(T);
+    static constexpr size_t capacity = N;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "free_head", offsetof(Pool, free_head), sizeof(uint64_t));
+        add_segment_field(header, "bump", offsetof(Pool, bump), sizeof(uint32_t));
+        add_segment_field(header, "in_use", offsetof(Pool, in_use), sizeof(uint32_t));
+        add_segment_field(header, "next", offsetof(Pool, next), sizeof(Pool::next));
+        add_segment_field(header, "records", offsetof(Pool, records), sizeof(Pool::records));
+    }
+};
+
+#endif // MEMORY_POOL_H
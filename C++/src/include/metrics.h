@@ -0,0 +1,196 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <sys/file.h>
+#include <signal.h>
+#include <unistd.h>
+#include "shared_code.h"
+#include "latency.h"   // LatencyHistogram
+
+// Live telemetry in /trading_metrics. Every thread that reports claims a
+// slot of its own and is that slot's only writer, so a counter increment
+// is a relaxed load and store on a line no other thread writes: no atomic
+// read-modify-write and no false sharing, cheap enough for the per-tick
+// path. Readers such as tools/metrics_exporter.cpp read the slots racily;
+// a value may be one update stale, never torn.
+//
+// The metric set is fixed at compile time (MetricId below, with names and
+// help text in METRIC_INFO), so a slot is a flat value array plus one
+// histogram of the thread's batch processing times.
+
+constexpr size_t METRICS_MAX_THREADS = 16;
+constexpr size_t METRICS_NAME_SIZE = 24;
+
+enum MetricId : uint32_t {
+    // Counters
+    METRIC_TICKS_PUBLISHED,
+    METRIC_TICKS_DROPPED,          // tick ring full
+    METRIC_ORDERS_DROPPED,         // order ring full
+    METRIC_BATCHES,
+    METRIC_COMMANDS_APPLIED,
+    METRIC_COMMANDS_REJECTED,
+    METRIC_TICKS_CONSUMED,
+    METRIC_READER_DROPPED,         // broadcast ticks overwritten before this reader got them
+    METRIC_DELTAS_APPLIED,
+    METRIC_DELTAS_REJECTED,
+    METRIC_TICKS_PERSISTED,
+    METRIC_COMMITS,
+    METRIC_PERSIST_ERRORS,
+    METRIC_LOG_LINES,
+    METRIC_LOG_SUPPRESSED,
+    // Gauges
+    METRIC_TICK_RING_DEPTH,
+    METRIC_ORDER_RING_DEPTH,
+    METRIC_COMMAND_RING_DEPTH,
+    METRIC_READER_LAG,             // broadcast ticks published but not yet read by this reader
+    METRIC_PERSIST_PENDING,
+    METRIC_COUNT
+};
+
+enum class MetricKind : uint8_t { Counter, Gauge };
+
+struct MetricInfo {
+    const char* name;   // Prometheus name; counters end in _total
+    MetricKind kind;
+    const char* help;
+};
+
+constexpr MetricInfo METRIC_INFO[METRIC_COUNT] = {
+    {"trading_ticks_published_total", MetricKind::Counter, "Ticks published to the shared segments"},
+    {"trading_ticks_dropped_total", MetricKind::Counter, "Ticks not pushed because the tick ring was full"},
+    {"trading_orders_dropped_total", MetricKind::Counter, "Order deltas not pushed because the order ring was full"},
+    {"trading_batches_total", MetricKind::Counter, "Batches processed"},
+    {"trading_commands_applied_total", MetricKind::Counter, "Commands from /trading_commands applied"},
+    {"trading_commands_rejected_total", MetricKind::Counter, "Commands from /trading_commands rejected"},
+    {"trading_ticks_consumed_total", MetricKind::Counter, "Ticks taken off the broadcast ring"},
+    {"trading_reader_dropped_total", MetricKind::Counter, "Broadcast ticks overwritten before this reader read them"},
+    {"trading_deltas_applied_total", MetricKind::Counter, "Order book deltas applied"},
+    {"trading_deltas_rejected_total", MetricKind::Counter, "Order book deltas rejected"},
+    {"trading_ticks_persisted_total", MetricKind::Counter, "Ticks written to the tick stores"},
+    {"trading_commits_total", MetricKind::Counter, "Tick store commits"},
+    {"trading_persist_errors_total", MetricKind::Counter, "Tick store write errors"},
+    {"trading_log_lines_total", MetricKind::Counter, "Log lines written"},
+    {"trading_log_suppressed_total", MetricKind::Counter, "Log lines dropped by the rate limit or a full log queue"},
+    {"trading_tick_ring_depth", MetricKind::Gauge, "Ticks waiting in /trading_ticks"},
+    {"trading_order_ring_depth", MetricKind::Gauge, "Deltas waiting in /trading_orders"},
+    {"trading_command_ring_depth", MetricKind::Gauge, "Commands waiting in /trading_commands"},
+    {"trading_reader_lag", MetricKind::Gauge, "Broadcast ticks published but not yet read by this reader"},
+    {"trading_persist_pending", MetricKind::Gauge, "Ticks appended but not yet committed"},
+};
+
+static_assert(METRIC_COUNT <= 64, "MetricsSlot::used has a bit per metric");
+
+// One thread's metrics; `batch` holds its batch processing times (its
+// pid and name fields are unused, the slot's own identify the thread)
+struct alignas(CACHE_LINE_SIZE) MetricsSlot {
+    std::atomic<int32_t> pid{0};          // 0 when the slot is free
+    char name[METRICS_NAME_SIZE];
+    std::atomic<uint64_t> used{0};        // bit i set once metric i has been written
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> values[METRIC_COUNT];
+    LatencyHistogram batch;
+};
+
+struct MetricsTable {
+    MetricsSlot threads[METRICS_MAX_THREADS];
+};
+
+template<>
+struct SegmentLayout<MetricsTable> {
+    static constexpr const char* type_name = "MetricsTable";
+    static constexpr size_t record_size = sizeof(MetricsSlot);
+    static constexpr size_t capacity = METRICS_MAX_THREADS;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "threads", offsetof(MetricsTable, threads), sizeof(MetricsTable::threads));
+        add_segment_field(header, "record.pid", offsetof(MetricsSlot, pid), sizeof(int32_t));
+        add_segment_field(header, "record.name", offsetof(MetricsSlot, name), METRICS_NAME_SIZE);
+        add_segment_field(header, "record.used", offsetof(MetricsSlot, used), sizeof(uint64_t));
+        add_segment_field(header, "record.values", offsetof(MetricsSlot, values), sizeof(MetricsSlot::values));
+        add_segment_field(header, "record.batch.count", offsetof(MetricsSlot, batch) + offsetof(LatencyHistogram, count),
+                          sizeof(uint64_t));
+        add_segment_field(header, "record.batch.buckets",
+                          offsetof(MetricsSlot, batch) + offsetof(LatencyHistogram, buckets),
+                          sizeof(LatencyHistogram::buckets));
+    }
+};
+
+// Claims a slot in /trading_metrics for the calling thread, under flock
+// like LatencyRecorder; slots of dead processes are reclaimed. Only the
+// thread that uses a recorder may write through it.
+class MetricsRecorder {
+private:
+    MetricsSlot* slot_;
+    uint64_t used_ = 0;   // private copy of slot_->used, so marking a metric is a local test
+
+    void mark(MetricId id) {
+        const uint64_t bit = uint64_t{1} << id;
+        if (!(used_ & bit)) {
+            used_ |= bit;
+            slot_->used.store(used_, std::memory_order_release);
+        }
+    }
+
+public:
+    MetricsRecorder(SharedMemory<MetricsTable>& shm, const char* name) : slot_(nullptr) {
+        const int shm_fd = open_memory_block(shm.name(), shm.options());
+        if (shm_fd == -1) {
+            throw std::runtime_error("Failed to open metrics table for registration");
+        }
+        flock(shm_fd, LOCK_EX);
+        for (auto& candidate : shm->threads) {
+            const int32_t pid = candidate.pid.load(std::memory_order_acquire);
+            if (pid == 0 || (kill(pid, 0) == -1 && errno == ESRCH)) {
+                candidate.used.store(0, std::memory_order_relaxed);
+                for (auto& value : candidate.values) {
+                    value.store(0, std::memory_order_relaxed);
+                }
+                for (auto& bucket : candidate.batch.buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+                candidate.batch.count.store(0, std::memory_order_relaxed);
+                candidate.batch.total_ns.store(0, std::memory_order_relaxed);
+                candidate.batch.max_ns.store(0, std::memory_order_relaxed);
+                std::memset(candidate.name, 0, METRICS_NAME_SIZE);
+                std::strncpy(candidate.name, name, METRICS_NAME_SIZE - 1);
+                candidate.pid.store(getpid(), std::memory_order_release);
+                slot_ = &candidate;
+                break;
+            }
+        }
+        flock(shm_fd, LOCK_UN);
+        close(shm_fd);
+        if (!slot_) {
+            throw std::runtime_error("Metrics table is full");
+        }
+    }
+
+    ~MetricsRecorder() {
+        slot_->pid.store(0, std::memory_order_release);
+    }
+
+    MetricsRecorder(const MetricsRecorder&) = delete;
+    MetricsRecorder& operator=(const MetricsRecorder&) = delete;
+
+    void add(MetricId id, int64_t amount = 1) {
+        auto& value = slot_->values[id];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        mark(id);
+    }
+
+    // Gauges, and counters mirrored from a cumulative count kept elsewhere
+    void set(MetricId id, int64_t value) {
+        slot_->values[id].store(value, std::memory_order_relaxed);
+        mark(id);
+    }
+
+    void record_batch(uint64_t ns) { slot_->batch.record(ns); }
+
+    int64_t value(MetricId id) const { return slot_->values[id].load(std::memory_order_relaxed); }
+};
+
+#endif // METRICS_H
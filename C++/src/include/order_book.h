@@ -0,0 +1,658 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "shared_code.h"
+#include "market_data_table.h"
+#include "load_generator.h"
+#include "memory_pool.h"
+
+// Limit order books rebuilt from add/modify/cancel/trade deltas. Deltas
+// arrive on the /trading_orders SPSC ring; the book engine applies them
+// and publishes the top BOOK_DEPTH levels of every book it touched into
+// /trading_book, one seqlock slot per MarketDataTable slot.
+//
+// Inside a book prices are integer ticks, so levels compare exactly. Each
+// side is a flat vector of levels sorted with the best level at the back:
+// activity clusters at the touch, so lookups scan a few entries from the
+// back and inserting or erasing a level moves only the levels better than
+// it. L3 books keep every resting order as a pooled node on an intrusive
+// FIFO list per level; L2 books only keep the aggregated quantities.
+//
+// Order nodes and order-id index entries come from pools the engine shares
+// between its books (BookMemory), and level vectors and hash buckets are
+// reserved up front, so once the books reach their working size applying
+// a delta never allocates.
+
+constexpr size_t BOOK_DEPTH = 10;
+constexpr size_t ORDER_RING_CAPACITY = 65536;
+constexpr double BOOK_TICKS_PER_UNIT = 100.0;  // tick size 0.01
+
+enum class Side : uint8_t { Bid = 0, Ask = 1 };
+enum class BookAction : uint8_t { Add = 0, Modify = 1, Cancel = 2, Trade = 3 };
+
+// One book delta. L3 books key everything by order_id, L2 books ignore it
+// and apply quantity to the level at price:
+//   Add      L3: new resting order                L2: level += quantity
+//   Modify   L3: new quantity and/or price        L2: level  = quantity
+//   Cancel   L3: remove the order                 L2: level -= quantity
+//   Trade    L3: order executed for quantity      L2: level -= quantity
+struct OrderEvent {
+    uint64_t order_id = 0;
+    int64_t price = 0;          // in ticks, price * BOOK_TICKS_PER_UNIT
+    uint64_t timestamp = 0;     // source time, nanoseconds since the Unix epoch
+    uint32_t quantity = 0;
+    uint16_t symbol_index = 0;  // slot in the MarketDataTable
+    Side side = Side::Bid;
+    BookAction action = BookAction::Add;
+};
+
+static_assert(sizeof(OrderEvent) == 32, "OrderEvent fills half a cache line");
+
+inline int64_t to_book_ticks(double price) { return std::llround(price * BOOK_TICKS_PER_UNIT); }
+// Dividing (not multiplying by 0.01) gives the double nearest the decimal price
+inline double from_book_ticks(int64_t ticks) { return static_cast<double>(ticks) / BOOK_TICKS_PER_UNIT; }
+
+using OrderRing = SharedRingBuffer<OrderEvent, ORDER_RING_CAPACITY>;
+
+template<>
+struct SegmentLayout<OrderRing> {
+    static constexpr const char* type_name = "OrderRing";
+    static constexpr size_t record_size = sizeof(OrderEvent);
+    static constexpr size_t capacity = ORDER_RING_CAPACITY;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "head", offsetof(OrderRing, head), sizeof(uint64_t));
+        add_segment_field(header, "tail", offsetof(OrderRing, tail), sizeof(uint64_t));
+        add_segment_field(header, "slots", offsetof(OrderRing, slots), sizeof(OrderRing::slots));
+        add_segment_field(header, "record.order_id", offsetof(OrderEvent, order_id), sizeof(uint64_t));
+        add_segment_field(header, "record.price", offsetof(OrderEvent, price), sizeof(int64_t));
+        add_segment_field(header, "record.timestamp", offsetof(OrderEvent, timestamp), sizeof(uint64_t));
+        add_segment_field(header, "record.quantity", offsetof(OrderEvent, quantity), sizeof(uint32_t));
+        add_segment_field(header, "record.symbol_index", offsetof(OrderEvent, symbol_index), sizeof(uint16_t));
+        add_segment_field(header, "record.side", offsetof(OrderEvent, side), sizeof(Side));
+        add_segment_field(header, "record.action", offsetof(OrderEvent, action), sizeof(BookAction));
+    }
+};
+
+// Plain copy of one level and of a book's published depth
+struct BookLevel {
+    double price = 0.0;
+    uint64_t quantity = 0;
+    uint32_t orders = 0;
+};
+
+struct BookSnapshot {
+    uint64_t timestamp = 0;
+    uint64_t updates = 0;            // deltas applied to this book so far
+    double last_trade_price = 0.0;
+    uint64_t last_trade_quantity = 0;
+    uint32_t bid_depth = 0;          // filled entries of bids/asks, at most BOOK_DEPTH
+    uint32_t ask_depth = 0;
+    BookLevel bids[BOOK_DEPTH];      // best first
+    BookLevel asks[BOOK_DEPTH];
+};
+
+struct SharedBookLevel {
+    std::atomic<double> price{0.0};
+    std::atomic<uint64_t> quantity{0};
+    std::atomic<uint32_t> orders{0};
+    uint32_t reserved = 0;
+};
+
+// Shared slot, published under a seqlock exactly like TradingData. Level 0
+// of each side is the top of book.
+struct alignas(CACHE_LINE_SIZE) BookSlot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> timestamp{0};
+    std::atomic<uint64_t> updates{0};
+    std::atomic<double> last_trade_price{0.0};
+    std::atomic<uint64_t> last_trade_quantity{0};
+    std::atomic<uint32_t> bid_depth{0};
+    std::atomic<uint32_t> ask_depth{0};
+    SharedBookLevel bids[BOOK_DEPTH];
+    SharedBookLevel asks[BOOK_DEPTH];
+
+    void publish(const BookSnapshot& book) {
+        const uint64_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        timestamp.store(book.timestamp, std::memory_order_relaxed);
+        updates.store(book.updates, std::memory_order_relaxed);
+        last_trade_price.store(book.last_trade_price, std::memory_order_relaxed);
+        last_trade_quantity.store(book.last_trade_quantity, std::memory_order_relaxed);
+        bid_depth.store(book.bid_depth, std::memory_order_relaxed);
+        ask_depth.store(book.ask_depth, std::memory_order_relaxed);
+        store_levels(bids, book.bids, book.bid_depth);
+        store_levels(asks, book.asks, book.ask_depth);
+
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    bool try_snapshot(BookSnapshot& out) const {
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        out.timestamp = timestamp.load(std::memory_order_relaxed);
+        out.updates = updates.load(std::memory_order_relaxed);
+        out.last_trade_price = last_trade_price.load(std::memory_order_relaxed);
+        out.last_trade_quantity = last_trade_quantity.load(std::memory_order_relaxed);
+        out.bid_depth = std::min<uint32_t>(bid_depth.load(std::memory_order_relaxed), BOOK_DEPTH);
+        out.ask_depth = std::min<uint32_t>(ask_depth.load(std::memory_order_relaxed), BOOK_DEPTH);
+        load_levels(bids, out.bids, out.bid_depth);
+        load_levels(asks, out.asks, out.ask_depth);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    BookSnapshot snapshot() const {
+        BookSnapshot book;
+        while (!try_snapshot(book)) {
+        }
+        return book;
+    }
+
+private:
+    static void store_levels(SharedBookLevel* target, const BookLevel* source, uint32_t depth) {
+        for (uint32_t i = 0; i < depth; ++i) {
+            target[i].price.store(source[i].price, std::memory_order_relaxed);
+            target[i].quantity.store(source[i].quantity, std::memory_order_relaxed);
+            target[i].orders.store(source[i].orders, std::memory_order_relaxed);
+        }
+    }
+
+    static void load_levels(const SharedBookLevel* source, BookLevel* target, uint32_t depth) {
+        for (uint32_t i = 0; i < depth; ++i) {
+            target[i].price = source[i].price.load(std::memory_order_relaxed);
+            target[i].quantity = source[i].quantity.load(std::memory_order_relaxed);
+            target[i].orders = source[i].orders.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+// Slot i holds the book for MarketDataTable slot i
+template<size_t Capacity>
+struct OrderBookTable {
+    static constexpr size_t capacity = Capacity;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> count{0};  // highest published index + 1
+    BookSlot slots[Capacity];
+
+    BookSlot& at(int32_t index) { return slots[index]; }
+    const BookSlot& at(int32_t index) const { return slots[index]; }
+    uint32_t size() const { return count.load(std::memory_order_acquire); }
+};
+
+using OrderBooks = OrderBookTable<MARKET_TABLE_CAPACITY>;
+
+template<>
+struct SegmentLayout<OrderBooks> {
+    static constexpr const char* type_name = "OrderBooks";
+    static constexpr size_t record_size = sizeof(BookSlot);
+    static constexpr size_t capacity = MARKET_TABLE_CAPACITY;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "count", offsetof(OrderBooks, count), sizeof(uint32_t));
+        add_segment_field(header, "slots", offsetof(OrderBooks, slots), sizeof(OrderBooks::slots));
+        add_segment_field(header, "record.sequence", offsetof(BookSlot, sequence), sizeof(uint64_t));
+        add_segment_field(header, "record.timestamp", offsetof(BookSlot, timestamp), sizeof(uint64_t));
+        add_segment_field(header, "record.updates", offsetof(BookSlot, updates), sizeof(uint64_t));
+        add_segment_field(header, "record.last_price", offsetof(BookSlot, last_trade_price), sizeof(double));
+        add_segment_field(header, "record.last_quantity", offsetof(BookSlot, last_trade_quantity), sizeof(uint64_t));
+        add_segment_field(header, "record.bid_depth", offsetof(BookSlot, bid_depth), sizeof(uint32_t));
+        add_segment_field(header, "record.ask_depth", offsetof(BookSlot, ask_depth), sizeof(uint32_t));
+        add_segment_field(header, "record.bids", offsetof(BookSlot, bids), sizeof(BookSlot::bids));
+        add_segment_field(header, "record.asks", offsetof(BookSlot, asks), sizeof(BookSlot::asks));
+        add_segment_field(header, "level.price", offsetof(SharedBookLevel, price), sizeof(double));
+        add_segment_field(header, "level.quantity", offsetof(SharedBookLevel, quantity), sizeof(uint64_t));
+        add_segment_field(header, "level.orders", offsetof(SharedBookLevel, orders), sizeof(uint32_t));
+    }
+};
+
+// Python BOOK_HEADER_FORMAT 'QQQdQII' + 2 * BOOK_DEPTH BOOK_LEVEL_FORMAT 'dQI4x'
+static_assert(offsetof(BookSlot, bid_depth) == 40 && offsetof(BookSlot, bids) == 48 &&
+              sizeof(SharedBookLevel) == 24 && offsetof(BookSlot, asks) == 48 + BOOK_DEPTH * 24 &&
+              sizeof(BookSlot) == 576, "BookSlot layout is mirrored by Python BOOK_HEADER_FORMAT");
+static_assert(offsetof(OrderBooks, slots) == 64, "Python BOOK_SLOTS_OFFSET");
+
+struct RestingOrder {
+    uint64_t id;
+    int64_t price;
+    uint32_t quantity;
+    Side side;
+    RestingOrder* prev;  // neighbours on the level's FIFO
+    RestingOrder* next;
+};
+
+struct PriceLevel {
+    int64_t key;         // price for bids, -price for asks: the best level has the largest key
+    uint64_t quantity;
+    uint32_t orders;
+    RestingOrder* head;  // L3 FIFO of resting orders, oldest first; nullptr when empty
+    RestingOrder* tail;
+};
+
+// Pools shared by all books of one engine thread
+struct BookMemory {
+    static constexpr size_t ORDER_INDEX_NODE_SIZE = 32;  // covers an unordered_map<uint64_t, RestingOrder*> node
+
+    ObjectPool<RestingOrder> orders{4096};
+    FixedBlockPool index_nodes{ORDER_INDEX_NODE_SIZE, 4096};
+};
+
+// One symbol's book. Single-threaded: the engine thread owns it.
+class OrderBook {
+private:
+    static constexpr size_t RESERVED_LEVELS = 64;
+    static constexpr size_t RESERVED_ORDERS = 256;
+
+    using OrderIndex = std::unordered_map<uint64_t, RestingOrder*, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                                          PoolAllocator<std::pair<const uint64_t, RestingOrder*>>>;
+
+    BookMemory& memory_;
+    std::vector<PriceLevel> levels_[2];
+    OrderIndex order_index_;
+    bool l3_;
+    uint64_t timestamp_ = 0;
+    uint64_t updates_ = 0;
+    int64_t last_trade_price_ = 0;
+    uint64_t last_trade_quantity_ = 0;
+
+    static int64_t level_key(Side side, int64_t price) { return side == Side::Bid ? price : -price; }
+    std::vector<PriceLevel>& side_levels(Side side) { return levels_[static_cast<size_t>(side)]; }
+
+    static size_t find_level(const std::vector<PriceLevel>& levels, int64_t key) {
+        for (size_t i = levels.size(); i > 0; --i) {
+            if (levels[i - 1].key == key) {
+                return i - 1;
+            }
+            if (levels[i - 1].key < key) {
+                break;
+            }
+        }
+        return levels.size();
+    }
+
+    static size_t find_or_insert_level(std::vector<PriceLevel>& levels, int64_t key) {
+        size_t i = levels.size();
+        while (i > 0 && levels[i - 1].key > key) {
+            --i;
+        }
+        if (i > 0 && levels[i - 1].key == key) {
+            return i - 1;
+        }
+        levels.insert(levels.begin() + static_cast<ptrdiff_t>(i), PriceLevel{key, 0, 0, nullptr, nullptr});
+        return i;
+    }
+
+    void add_order(uint64_t id, Side side, int64_t price, uint32_t quantity) {
+        std::vector<PriceLevel>& levels = side_levels(side);
+        PriceLevel& level = levels[find_or_insert_level(levels, level_key(side, price))];
+        RestingOrder* node = memory_.orders.create(RestingOrder{id, price, quantity, side, level.tail, nullptr});
+
+        if (level.tail) {
+            level.tail->next = node;
+        } else {
+            level.head = node;
+        }
+        level.tail = node;
+        level.quantity += quantity;
+        level.orders++;
+        order_index_.emplace(id, node);
+    }
+
+    void remove_order(RestingOrder* node) {
+        std::vector<PriceLevel>& levels = side_levels(node->side);
+        const size_t index = find_level(levels, level_key(node->side, node->price));
+        PriceLevel& level = levels[index];
+
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            level.head = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        } else {
+            level.tail = node->prev;
+        }
+        level.quantity -= node->quantity;
+        if (--level.orders == 0) {
+            levels.erase(levels.begin() + static_cast<ptrdiff_t>(index));
+        }
+        order_index_.erase(node->id);
+        memory_.orders.destroy(node);
+    }
+
+    bool apply_l3(const OrderEvent& event) {
+        if (event.action == BookAction::Add) {
+            if (event.quantity == 0 || order_index_.count(event.order_id) != 0) {
+                return false;
+            }
+            add_order(event.order_id, event.side, event.price, event.quantity);
+            return true;
+        }
+
+        const auto found = order_index_.find(event.order_id);
+        if (found == order_index_.end()) {
+            return false;
+        }
+        RestingOrder* node = found->second;
+        RestingOrder& order = *node;
+
+        switch (event.action) {
+        case BookAction::Modify:
+            // Shrinking in place keeps queue priority; a new price or a larger size loses it
+            if (event.quantity == 0) {
+                remove_order(node);
+            } else if (event.price == order.price && event.quantity <= order.quantity) {
+                std::vector<PriceLevel>& levels = side_levels(order.side);
+                levels[find_level(levels, level_key(order.side, order.price))].quantity -= order.quantity - event.quantity;
+                order.quantity = event.quantity;
+            } else {
+                const Side side = order.side;
+                remove_order(node);
+                add_order(event.order_id, side, event.price, event.quantity);
+            }
+            return true;
+        case BookAction::Cancel:
+            remove_order(node);
+            return true;
+        case BookAction::Trade: {
+            const uint32_t executed = std::min(event.quantity, order.quantity);
+            last_trade_price_ = order.price;
+            last_trade_quantity_ = executed;
+            if (executed == order.quantity) {
+                remove_order(node);
+            } else {
+                std::vector<PriceLevel>& levels = side_levels(order.side);
+                levels[find_level(levels, level_key(order.side, order.price))].quantity -= executed;
+                order.quantity -= executed;
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    bool apply_l2(const OrderEvent& event) {
+        std::vector<PriceLevel>& levels = side_levels(event.side);
+        const int64_t key = level_key(event.side, event.price);
+
+        if (event.action == BookAction::Add || event.action == BookAction::Modify) {
+            if (event.action == BookAction::Modify && event.quantity == 0) {
+                const size_t index = find_level(levels, key);
+                if (index != levels.size()) {
+                    levels.erase(levels.begin() + static_cast<ptrdiff_t>(index));
+                }
+                return true;
+            }
+            PriceLevel& level = levels[find_or_insert_level(levels, key)];
+            if (event.action == BookAction::Add) {
+                level.quantity += event.quantity;
+                level.orders++;
+            } else {
+                level.quantity = event.quantity;
+                level.orders = std::max<uint32_t>(level.orders, 1);
+            }
+            return true;
+        }
+
+        const size_t index = find_level(levels, key);
+        if (index == levels.size()) {
+            return false;
+        }
+        PriceLevel& level = levels[index];
+        const uint64_t removed = std::min<uint64_t>(event.quantity, level.quantity);
+        level.quantity -= removed;
+        if (event.action == BookAction::Trade) {
+            last_trade_price_ = event.price;
+            last_trade_quantity_ = removed;
+        } else if (level.orders > 1) {
+            level.orders--;
+        }
+        if (level.quantity == 0) {
+            levels.erase(levels.begin() + static_cast<ptrdiff_t>(index));
+        }
+        return true;
+    }
+
+public:
+    explicit OrderBook(BookMemory& memory, bool l3 = true)
+        : memory_(memory), order_index_(0, std::hash<uint64_t>(), std::equal_to<uint64_t>(),
+                                        PoolAllocator<std::pair<const uint64_t, RestingOrder*>>(memory.index_nodes)),
+          l3_(l3) {
+        levels_[0].reserve(RESERVED_LEVELS);
+        levels_[1].reserve(RESERVED_LEVELS);
+        if (l3_) {
+            order_index_.reserve(RESERVED_ORDERS);
+        }
+    }
+
+    ~OrderBook() {
+        for (const auto& entry : order_index_) {
+            memory_.orders.destroy(entry.second);
+        }
+    }
+
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+
+    // False for deltas the book cannot apply (unknown or duplicate order
+    // id, cancel of an empty level); those leave the book unchanged
+    bool apply(const OrderEvent& event) {
+        timestamp_ = event.timestamp;
+        ++updates_;
+        return l3_ ? apply_l3(event) : apply_l2(event);
+    }
+
+    bool is_l3() const { return l3_; }
+    size_t depth(Side side) const { return levels_[static_cast<size_t>(side)].size(); }
+    size_t order_count() const { return order_index_.size(); }
+
+    // i-th best level of side (0 = top of book), nullptr past the depth
+    const PriceLevel* level(Side side, size_t i) const {
+        const std::vector<PriceLevel>& levels = levels_[static_cast<size_t>(side)];
+        return i < levels.size() ? &levels[levels.size() - 1 - i] : nullptr;
+    }
+
+    static int64_t level_price(Side side, const PriceLevel& level) { return side == Side::Bid ? level.key : -level.key; }
+
+    void snapshot(BookSnapshot& out) const {
+        out.timestamp = timestamp_;
+        out.updates = updates_;
+        out.last_trade_price = from_book_ticks(last_trade_price_);
+        out.last_trade_quantity = last_trade_quantity_;
+        out.bid_depth = copy_levels(Side::Bid, out.bids);
+        out.ask_depth = copy_levels(Side::Ask, out.asks);
+    }
+
+private:
+    uint32_t copy_levels(Side side, BookLevel* out) const {
+        uint32_t depth = 0;
+        for (const PriceLevel* l = level(side, 0); l && depth < BOOK_DEPTH; l = level(side, depth)) {
+            out[depth].price = from_book_ticks(level_price(side, *l));
+            out[depth].quantity = l->quantity;
+            out[depth].orders = l->orders;
+            ++depth;
+        }
+        return depth;
+    }
+};
+
+// Books for every symbol index, created on their first delta. Books
+// touched since the last publish() are republished, so a batch of deltas
+// costs one seqlock write per book rather than one per delta.
+template<size_t Capacity>
+class OrderBookEngine {
+private:
+    OrderBookTable<Capacity>* table_;
+    bool l3_;
+    BookMemory memory_;  // outlives books_, whose destructors return nodes to it
+    std::unique_ptr<std::unique_ptr<OrderBook>[]> books_;
+    std::vector<uint16_t> dirty_;
+    std::vector<bool> is_dirty_;
+    uint64_t applied_ = 0;
+    uint64_t rejected_ = 0;
+
+public:
+    OrderBookEngine(OrderBookTable<Capacity>* table, bool l3)
+        : table_(table), l3_(l3), books_(new std::unique_ptr<OrderBook>[Capacity]), is_dirty_(Capacity, false) {
+        dirty_.reserve(Capacity);
+    }
+
+    void on_event(const OrderEvent& event) {
+        const size_t index = event.symbol_index;
+        if (index >= Capacity) {
+            ++rejected_;
+            return;
+        }
+        if (!books_[index]) {
+            books_[index] = std::make_unique<OrderBook>(memory_, l3_);
+        }
+        if (books_[index]->apply(event)) {
+            ++applied_;
+        } else {
+            ++rejected_;
+        }
+        if (!is_dirty_[index]) {
+            is_dirty_[index] = true;
+            dirty_.push_back(static_cast<uint16_t>(index));
+        }
+    }
+
+    // Publishes every book changed since the last call; returns how many
+    size_t publish() {
+        BookSnapshot snapshot;
+        uint32_t count = table_->count.load(std::memory_order_relaxed);
+        for (const uint16_t index : dirty_) {
+            books_[index]->snapshot(snapshot);
+            table_->at(index).publish(snapshot);
+            is_dirty_[index] = false;
+            count = std::max<uint32_t>(count, index + 1u);
+        }
+        table_->count.store(count, std::memory_order_release);
+        const size_t published = dirty_.size();
+        dirty_.clear();
+        return published;
+    }
+
+    const OrderBook* book(size_t index) const { return index < Capacity ? books_[index].get() : nullptr; }
+    uint64_t applied() const { return applied_; }
+    uint64_t rejected() const { return rejected_; }
+    const BookMemory& memory() const { return memory_; }
+};
+
+using BookEngine = OrderBookEngine<MARKET_TABLE_CAPACITY>;
+
+// Turns the producer's price stream into L3 order flow for the book
+// engine, standing in for a real depth feed: each tick rests a bid and an
+// ask a few ticks either side of the price, executes resting orders the
+// new price crossed, cancels the oldest once a symbol has more than
+// max_resting orders, and now and then shrinks one in place. For L2 books
+// the shrink goes out as a Cancel of the removed quantity instead.
+class SyntheticOrderFlow {
+private:
+    struct Resting {
+        uint64_t id;
+        int64_t price;
+        uint32_t quantity;
+        Side side;
+    };
+
+    // A symbol's resting orders, oldest first. Reserved on the symbol's
+    // first tick; at most max_resting_ + 2 entries, so erasing from the
+    // front is a short move and never frees
+    Xoshiro256 rng_;
+    std::vector<std::vector<Resting>> resting_;
+    size_t max_resting_;
+    bool l3_;
+    uint64_t next_id_ = 1;
+
+public:
+    explicit SyntheticOrderFlow(uint64_t seed, bool l3 = true, size_t max_resting = 40)
+        : rng_(seed), resting_(MARKET_TABLE_CAPACITY), max_resting_(max_resting), l3_(l3) {}
+
+    // Calls emit(const OrderEvent&) for each delta this tick produces
+    template<typename Emit>
+    void on_tick(const TradingTick& tick, Emit&& emit) {
+        if (tick.symbol_index >= resting_.size() || !tick.valid) {
+            return;
+        }
+        std::vector<Resting>& orders = resting_[tick.symbol_index];
+        if (orders.capacity() == 0) {
+            orders.reserve(max_resting_ + 2);
+        }
+        const int64_t price = to_book_ticks(tick.price);
+        OrderEvent event;
+        event.symbol_index = tick.symbol_index;
+        event.timestamp = tick.timestamp;
+
+        // Bids at or above the trade price and asks at or below it were hit
+        for (auto it = orders.begin(); it != orders.end();) {
+            const bool crossed = it->side == Side::Bid ? it->price >= price : it->price <= price;
+            if (!crossed) {
+                ++it;
+                continue;
+            }
+            event.action = BookAction::Trade;
+            event.order_id = it->id;
+            event.side = it->side;
+            event.price = it->price;
+            event.quantity = it->quantity;
+            emit(event);
+            it = orders.erase(it);
+        }
+
+        for (const Side side : {Side::Bid, Side::Ask}) {
+            const int64_t offset = 1 + static_cast<int64_t>(rng_.below(8));
+            const Resting order{next_id_++, side == Side::Bid ? price - offset : price + offset,
+                                static_cast<uint32_t>(1 + rng_.below(1000)), side};
+            event.action = BookAction::Add;
+            event.order_id = order.id;
+            event.side = order.side;
+            event.price = order.price;
+            event.quantity = order.quantity;
+            emit(event);
+            orders.push_back(order);
+        }
+
+        while (orders.size() > max_resting_) {
+            const Resting& oldest = orders.front();
+            event.action = BookAction::Cancel;
+            event.order_id = oldest.id;
+            event.side = oldest.side;
+            event.price = oldest.price;
+            event.quantity = oldest.quantity;
+            emit(event);
+            orders.erase(orders.begin());
+        }
+
+        if (!orders.empty() && rng_.below(4) == 0) {
+            Resting& order = orders[rng_.below(orders.size())];
+            if (order.quantity > 1) {
+                const uint32_t removed = order.quantity - order.quantity / 2;
+                order.quantity -= removed;
+                event.action = l3_ ? BookAction::Modify : BookAction::Cancel;
+                event.order_id = order.id;
+                event.side = order.side;
+                event.price = order.price;
+                event.quantity = l3_ ? order.quantity : removed;
+                emit(event);
+            }
+        }
+    }
+};
+
+#endif // ORDER_BOOK_H
@@ -0,0 +1,207 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tick_store.h"
+#include "trading_system.h"
+
+// Historical replay: merges the tick stores of several symbols by
+// timestamp and hands the ticks to the producer's publish path, paced
+// against the wall clock at 1x, at an N× multiple, or not at all.
+
+constexpr size_t REPLAY_MAX_SPEED_BATCH = 256;  // ticks per notify when unpaced
+constexpr auto REPLAY_MAX_SLEEP = std::chrono::milliseconds(100);
+
+struct ReplayOptions {
+    std::vector<std::string> symbols;
+    std::string data_dir = "market_data";
+    double speed = 1.0;  // multiple of recorded time, 0 = as fast as possible
+
+    bool enabled() const { return !symbols.empty(); }
+
+    // "AAPL,TSLA,BTC"
+    void set_symbols(const std::string& list) {
+        symbols.clear();
+        std::stringstream names(list);
+        std::string name;
+        while (std::getline(names, name, ',')) {
+            if (!name.empty()) {
+                symbols.push_back(name);
+            }
+        }
+    }
+
+    // "max", "10x", "10" or "0.5x"
+    void set_speed(const std::string& value) {
+        if (value == "max") {
+            speed = 0.0;
+            return;
+        }
+        try {
+            size_t used = 0;
+            speed = std::stod(value, &used);
+            if (used + (value[used] == 'x' ? 1 : 0) != value.size() || speed <= 0.0) {
+                throw std::invalid_argument(value);
+            }
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Invalid replay speed: " + value + " (use max, 10x, 0.5x)");
+        }
+    }
+};
+
+// <data_dir>/<asset_type>/<symbol>.ticks for whichever asset type holds it
+inline std::string find_tick_store(const std::string& data_dir, const std::string& symbol) {
+    namespace fs = std::filesystem;
+    const std::string file_name = symbol + ".ticks";
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(data_dir, error), end; it != end; it.increment(error)) {
+        if (it->is_regular_file() && it->path().filename() == file_name) {
+            return it->path().string();
+        }
+    }
+    throw std::runtime_error("No tick store for " + symbol + " under " + data_dir + " (run csv_import first)");
+}
+
+// K-way merge of per-symbol stores. The heap holds one entry per store
+// with ticks left, keyed by that store's next timestamp, so each tick
+// costs O(log k) and the stores are read sequentially in place.
+class TickReplayer {
+private:
+    struct Source {
+        std::unique_ptr<TickStoreReader> reader;
+        ColumnSpan<uint64_t> timestamps;
+        ColumnSpan<double> prices;
+        ColumnSpan<double> volumes;
+        uint64_t next;
+        uint16_t symbol_index;
+    };
+
+    // Ties go to the lower source index, so replays are deterministic
+    struct HeapEntry {
+        uint64_t timestamp;
+        size_t source;
+        bool operator>(const HeapEntry& other) const {
+            return timestamp != other.timestamp ? timestamp > other.timestamp : source > other.source;
+        }
+    };
+
+    std::vector<Source> sources_;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap_;
+    uint64_t total_ = 0;
+
+public:
+    // symbol_indices[i] is the /market_data slot ticks of options.symbols[i] go to
+    TickReplayer(const ReplayOptions& options, const std::vector<int32_t>& symbol_indices) {
+        for (size_t i = 0; i < options.symbols.size(); ++i) {
+            Source source;
+            source.reader = std::make_unique<TickStoreReader>(find_tick_store(options.data_dir, options.symbols[i]));
+            const TickRange range = source.reader->slice(0, source.reader->size());
+            source.timestamps = range.timestamp;
+            source.prices = range.price;
+            source.volumes = range.volume;
+            source.next = 0;
+            source.symbol_index = static_cast<uint16_t>(symbol_indices[i]);
+            total_ += range.size();
+            if (!range.empty()) {
+                heap_.push({range.timestamp[0], sources_.size()});
+            }
+            sources_.push_back(std::move(source));
+        }
+    }
+
+    bool done() const { return heap_.empty(); }
+    uint64_t total() const { return total_; }
+
+    // Timestamp of the tick next() returns; only valid while !done()
+    uint64_t next_timestamp() const { return heap_.top().timestamp; }
+
+    bool next(TradingTick& tick) {
+        if (heap_.empty()) {
+            return false;
+        }
+        const HeapEntry entry = heap_.top();
+        heap_.pop();
+        Source& source = sources_[entry.source];
+        const uint64_t i = source.next++;
+
+        tick.price = source.prices[i];
+        tick.volume = static_cast<int32_t>(std::min(source.volumes[i], static_cast<double>(INT32_MAX)));
+        tick.timestamp = source.timestamps[i];
+        tick.valid = true;
+        tick.symbol_index = source.symbol_index;
+
+        if (source.next < source.timestamps.size) {
+            heap_.push({source.timestamps[source.next], entry.source});
+        }
+        return true;
+    }
+};
+
+struct ReplayStats {
+    uint64_t ticks = 0;
+    std::chrono::nanoseconds elapsed{0};
+
+    double ticks_per_second() const {
+        return elapsed.count() > 0 ? ticks * 1e9 / static_cast<double>(elapsed.count()) : 0.0;
+    }
+};
+
+// Replays until the stores run out or running clears. publish(tick) is
+// called per tick, flush() before every sleep and every
+// REPLAY_MAX_SPEED_BATCH ticks when unpaced, so consumers are woken once
+// per burst rather than once per tick. Between ticks the loop waits in
+// wait_until(deadline), which may return early (the producer uses it to
+// apply commands while it waits); deadlines are capped so a long gap in
+// the recording doesn't hold up shutdown.
+template<typename Publish, typename Flush, typename WaitUntil>
+ReplayStats run_replay(TickReplayer& replayer, double speed, const std::atomic<bool>& running,
+                       Publish&& publish, Flush&& flush, WaitUntil&& wait_until) {
+    using clock = std::chrono::steady_clock;
+    ReplayStats stats;
+    const auto start = clock::now();
+    const uint64_t first_timestamp = replayer.done() ? 0 : replayer.next_timestamp();
+    size_t unflushed = 0;
+    TradingTick tick;
+
+    while (running && !replayer.done()) {
+        if (speed > 0.0) {
+            const auto due = start + std::chrono::nanoseconds(static_cast<int64_t>(
+                static_cast<double>(replayer.next_timestamp() - first_timestamp) / speed));
+            if (due > clock::now()) {
+                if (unflushed > 0) {
+                    flush();
+                    unflushed = 0;
+                }
+                wait_until(std::min(due, clock::now() + REPLAY_MAX_SLEEP));
+                continue;
+            }
+        }
+        replayer.next(tick);
+        publish(tick);
+        ++stats.ticks;
+        if (++unflushed == REPLAY_MAX_SPEED_BATCH) {
+            flush();
+            unflushed = 0;
+        }
+    }
+    if (unflushed > 0) {
+        flush();
+    }
+    stats.elapsed = clock::now() - start;
+    return stats;
+}
+
+#endif // REPLAY_H
@@ -0,0 +1,202 @@
+#ifndef RUNTIME_CONFIG_H
+#define RUNTIME_CONFIG_H
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "feed_handler.h"
+#include "load_generator.h"
+#include "order_book.h"
+#include "replay.h"
+#include "scheduling.h"
+#include "tick_persister.h"
+
+// trading_app settings, from `--config <file>` and CLI flags (flags win).
+// The file holds `key = value` lines, '#' starts a comment; flags are the
+// same keys with dashes: --producer-cpus 2 --producer-fifo 80
+//
+//   producer_cpus / producer_fifo     market data producer loop (main thread)
+//   indicator_cpus / indicator_fifo   indicator engine consumer thread
+//   python_cpus / python_fifo         forked Python bridge, applied before execl
+//   book_cpus / book_fifo             order book engine thread
+//   persist_cpus / persist_fifo       tick persister drain thread
+//   book_mode                         l3 (default, per-order books), l2 (aggregated levels) or off
+//   replay                            symbols to replay instead of simulating, "AAPL,BTC"
+//   replay_speed                      1x (default), 10x, 0.5x, or max
+//   replay_dir                        where the .ticks stores live (market_data)
+//   load_symbols                      synthetic symbols to generate instead of simulating, up to 4096
+//   load_rate                         target ticks per second over all symbols (100000)
+//   load_burst                        rate multiplier pattern, "4x:50/1000" = 4x for 50 ms per second
+//   load_volatility / load_seed       largest per-tick volatility (0.001), PRNG seed (0 = random)
+//   feed                              live venue feed instead of simulating, repeatable:
+//                                     "coinbase:BTC-USD=BTC", "yahoo:AAPL,TSLA" (see feed_handler.h)
+//   feed_poll_ms                      interval between polls of REST venues (1000)
+//   persist_dir                       write every tick to <dir>/<symbol>.ticks in the background (off)
+//   persist_window_ms                 durability window: the most a crash can lose (100)
+//   persist_mode                      direct (default, O_DIRECT) or buffered
+struct RuntimeConfig {
+    SchedulingOptions producer;
+    SchedulingOptions indicator;
+    SchedulingOptions python;
+    SchedulingOptions book;
+    std::string book_mode = "l3";
+    ReplayOptions replay;
+    LoadOptions load;
+    FeedOptions feed;
+    SchedulingOptions persist;
+    PersistOptions persistence;
+
+    void set(const std::string& key, const std::string& value) {
+        if (key == "replay") {
+            replay.set_symbols(value);
+            return;
+        }
+        if (key == "replay_speed") {
+            replay.set_speed(value);
+            return;
+        }
+        if (key == "replay_dir") {
+            replay.data_dir = value;
+            return;
+        }
+        if (key == "book_mode") {
+            if (value != "l3" && value != "l2" && value != "off") {
+                throw std::runtime_error("Invalid book mode: " + value + " (use l3, l2 or off)");
+            }
+            book_mode = value;
+            return;
+        }
+        if (key == "load_symbols") {
+            load.symbols = std::stoul(value);
+            return;
+        }
+        if (key == "load_rate") {
+            load.rate = std::stod(value);
+            if (load.rate <= 0.0) {
+                throw std::runtime_error("Load rate must be positive: " + value);
+            }
+            return;
+        }
+        if (key == "load_burst") {
+            load.set_burst(value);
+            return;
+        }
+        if (key == "load_volatility") {
+            load.volatility = std::stod(value);
+            return;
+        }
+        if (key == "load_seed") {
+            load.seed = std::stoull(value);
+            return;
+        }
+        if (key == "feed") {
+            feed.add(value);
+            return;
+        }
+        if (key == "feed_poll_ms") {
+            feed.poll_interval = std::chrono::milliseconds(std::stol(value));
+            if (feed.poll_interval.count() <= 0) {
+                throw std::runtime_error("Feed poll interval must be positive: " + value);
+            }
+            return;
+        }
+        if (key == "persist_dir") {
+            persistence.dir = value;
+            return;
+        }
+        if (key == "persist_window_ms") {
+            persistence.window = std::chrono::milliseconds(std::stol(value));
+            if (persistence.window.count() <= 0) {
+                throw std::runtime_error("Persist window must be positive: " + value);
+            }
+            return;
+        }
+        if (key == "persist_mode") {
+            persistence.set_mode(value);
+            return;
+        }
+
+        static const std::map<std::string, SchedulingOptions RuntimeConfig::*> roles = {
+            {"producer", &RuntimeConfig::producer},
+            {"indicator", &RuntimeConfig::indicator},
+            {"python", &RuntimeConfig::python},
+            {"book", &RuntimeConfig::book},
+            {"persist", &RuntimeConfig::persist},
+        };
+        const auto underscore = key.rfind('_');
+        const auto role = roles.find(key.substr(0, underscore));
+        if (underscore == std::string::npos || role == roles.end()) {
+            throw std::runtime_error("Unknown config key: " + key);
+        }
+        SchedulingOptions& options = this->*(role->second);
+        const std::string field = key.substr(underscore + 1);
+        if (field == "cpus") {
+            parse_cpu_list(value);
+            options.cpus = value;
+        } else if (field == "fifo") {
+            options.fifo_priority = std::stoi(value);
+            if (options.fifo_priority < 0 || options.fifo_priority > sched_get_priority_max(SCHED_FIFO)) {
+                throw std::runtime_error("SCHED_FIFO priority out of range: " + value);
+            }
+        } else {
+            throw std::runtime_error("Unknown config key: " + key);
+        }
+    }
+
+    void load_file(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Cannot open config file " + path);
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            line = line.substr(0, line.find('#'));
+            const auto equals = line.find('=');
+            if (equals == std::string::npos) {
+                continue;
+            }
+            auto trim = [](std::string text) {
+                const auto begin = text.find_first_not_of(" \t");
+                const auto end = text.find_last_not_of(" \t\r");
+                return begin == std::string::npos ? std::string() : text.substr(begin, end - begin + 1);
+            };
+            set(trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+        }
+    }
+
+    static RuntimeConfig from_args(int argc, char** argv) {
+        RuntimeConfig config;
+        std::vector<std::pair<std::string, std::string>> flags;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0 || i + 1 >= argc) {
+                throw std::runtime_error("Usage: trading_app [--config file] [--<role>-cpus list] [--<role>-fifo priority] "
+                                         "[--replay symbols] [--replay-speed 10x|max] [--replay-dir dir] "
+                                         "[--load-symbols n] [--load-rate ticks/s] [--load-burst 4x:50/1000] [--book-mode l3|l2|off] "
+                                         "[--feed venue[@url]:SYMBOL[=NAME],...] [--feed-poll-ms ms] "
+                                         "[--persist-dir dir] [--persist-window-ms ms] [--persist-mode direct|buffered]");
+            }
+            flags.emplace_back(arg.substr(2), argv[++i]);
+        }
+        for (const auto& [flag, value] : flags) {
+            if (flag == "config") {
+                config.load_file(value);
+            }
+        }
+        for (auto [flag, value] : flags) {
+            if (flag != "config") {
+                std::replace(flag.begin(), flag.end(), '-', '_');
+                config.set(flag, value);
+            }
+        }
+        if (config.replay.enabled() + config.load.enabled() + config.feed.enabled() > 1) {
+            throw std::runtime_error("--replay, --load-symbols and --feed are separate modes, pick one");
+        }
+        return config;
+    }
+};
+
+#endif // RUNTIME_CONFIG_H
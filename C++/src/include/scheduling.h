@@ -0,0 +1,122 @@
+#ifndef SCHEDULING_H
+#define SCHEDULING_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "latency.h"    // LatencyHistogram
+
+// Where and how a thread or process runs. Empty cpus leaves the affinity
+// alone; fifo_priority 0 keeps SCHED_OTHER. Failing to apply either (no
+// CAP_SYS_NICE, CPU offline) logs and continues with the default.
+struct SchedulingOptions {
+    std::string cpus;        // cpu list, e.g. "2" or "4-5,8"
+    int fifo_priority = 0;   // 1..99 for SCHED_FIFO
+
+    bool empty() const { return cpus.empty() && fifo_priority == 0; }
+};
+
+// "2", "4-5,8" -> cpu_set_t; throws on malformed lists
+inline cpu_set_t parse_cpu_list(const std::string& list) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        const auto dash = range.find('-');
+        try {
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            if (first < 0 || last < first || last >= CPU_SETSIZE) {
+                throw std::out_of_range(range);
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                CPU_SET(cpu, &set);
+            }
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Invalid cpu list: " + list);
+        }
+    }
+    return set;
+}
+
+// CPUs booted with isolcpus=, which the scheduler won't place other tasks on
+inline cpu_set_t isolated_cpus() {
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    std::string list;
+    std::getline(file, list);
+    if (list.empty()) {
+        cpu_set_t none;
+        CPU_ZERO(&none);
+        return none;
+    }
+    return parse_cpu_list(list);
+}
+
+// Applies options to the calling thread (pid 0 = calling thread for the
+// sched_* calls, which is what a forked child wants before execl too)
+inline void apply_scheduling(const char* role, const SchedulingOptions& options) {
+    if (!options.cpus.empty()) {
+        cpu_set_t set = parse_cpu_list(options.cpus);
+        if (sched_setaffinity(0, sizeof(set), &set) == -1) {
+            std::cout << "Scheduling: cannot pin " << role << " to cpus " << options.cpus
+                      << " (" << strerror(errno) << "), running unpinned" << std::endl;
+        } else {
+            cpu_set_t isolated = isolated_cpus();
+            CPU_AND(&isolated, &isolated, &set);
+            std::cout << "Scheduling: " << role << " pinned to cpus " << options.cpus
+                      << (CPU_EQUAL(&isolated, &set) ? " (isolated)" : " (not isolated, other tasks may share them)")
+                      << std::endl;
+        }
+    }
+    if (options.fifo_priority != 0) {
+        sched_param param{};
+        param.sched_priority = options.fifo_priority;
+        if (sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
+            std::cout << "Scheduling: cannot give " << role << " SCHED_FIFO priority " << options.fifo_priority
+                      << " (" << strerror(errno) << ", needs CAP_SYS_NICE or RLIMIT_RTPRIO), staying on SCHED_OTHER"
+                      << std::endl;
+        } else {
+            std::cout << "Scheduling: " << role << " runs SCHED_FIFO priority " << options.fifo_priority << std::endl;
+        }
+    }
+}
+
+// Wakeup lateness of a periodic loop: how far past its deadline each
+// iteration actually started. This is what pinning and SCHED_FIFO shrink.
+// Kept in a fixed log-linear histogram (latency.h), so recording never
+// allocates and a report costs the same however long the loop has run.
+class JitterStats {
+private:
+    LatencyHistogram histogram_{};  // value-initialized: the bucket atomics have no initializers
+
+public:
+    // Early wakeups count as on time
+    void add(int64_t lateness_ns) { histogram_.record(lateness_ns > 0 ? static_cast<uint64_t>(lateness_ns) : 0); }
+    uint64_t count() const { return histogram_.count.load(std::memory_order_relaxed); }
+
+    void report(const char* label) const {
+        const LatencySummary summary = summarize_latency(histogram_);
+        if (summary.count == 0) {
+            return;
+        }
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Jitter " << label << " (" << summary.count << " wakeups, us): "
+                  << "p50 " << summary.p50_ns / 1000.0 << " | p90 " << summary.p90_ns / 1000.0
+                  << " | p99 " << summary.p99_ns / 1000.0 << " | p99.9 " << summary.p999_ns / 1000.0
+                  << " | max " << summary.max_ns / 1000.0 << std::endl;
+    }
+};
+
+#endif // SCHEDULING_H
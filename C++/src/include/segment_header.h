@@ -0,0 +1,167 @@
+#ifndef SEGMENT_HEADER_H
+#define SEGMENT_HEADER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "trading_system.h"
+
+// Self-describing header on the first page of every SharedMemory<T>
+// segment. It names the payload type and records its size, record size,
+// capacity and the offsets of the fields other processes read, plus a hash
+// over all of that. Attaching checks the hash, so a reader built against a
+// different layout fails loudly instead of reading garbage.
+//
+//   [0, 4096)                header (rest of the page is zero)
+//   [4096, ...)              payload T, then the SegmentNotifier
+//
+// The payload starts on its own page so Python can mmap it at offset 4096
+// and keep using payload-relative offsets. Python/segment_layouts.py is
+// generated from these descriptions by tools/gen_segment_layouts.cpp.
+
+constexpr char SEGMENT_MAGIC[8] = {'T', 'R', 'D', 'S', 'E', 'G', '0', '1'};
+constexpr uint32_t SEGMENT_VERSION = 1;
+constexpr size_t SEGMENT_HEADER_SIZE = 4096;
+constexpr size_t SEGMENT_TYPE_NAME_SIZE = 32;
+constexpr size_t SEGMENT_FIELD_NAME_SIZE = 24;
+constexpr size_t SEGMENT_MAX_FIELDS = 28;
+
+struct SegmentField {
+    char name[SEGMENT_FIELD_NAME_SIZE];
+    uint32_t offset;  // from the start of the payload (or of a record, for "record." fields)
+    uint32_t size;
+};
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t layout_hash;
+    uint32_t payload_offset;
+    uint32_t payload_size;
+    uint32_t record_size;   // size of one element for rings and tables, sizeof(T) otherwise
+    uint32_t capacity;      // number of elements, 1 for single-record segments
+    uint32_t field_count;
+    uint32_t reserved;
+    char type_name[SEGMENT_TYPE_NAME_SIZE];
+    uint8_t padding[48];
+    SegmentField fields[SEGMENT_MAX_FIELDS];
+};
+
+// Python SEGMENT_HEADER_FORMAT '8sIIQIIIIII32s48x' + SEGMENT_FIELD_FORMAT '24sII'
+static_assert(offsetof(SegmentHeader, layout_hash) == 16 && offsetof(SegmentHeader, type_name) == 48 &&
+              offsetof(SegmentHeader, fields) == 128 && sizeof(SegmentField) == 32,
+              "SegmentHeader layout is mirrored by Python/segment_layouts.py");
+static_assert(sizeof(SegmentHeader) <= SEGMENT_HEADER_SIZE, "Segment header must fit its page");
+
+// Describes a payload type. Specialize for every type mapped across
+// processes; the unspecialized form only pins the payload size.
+template<typename T>
+struct SegmentLayout {
+    static constexpr const char* type_name = "";
+    static constexpr size_t record_size = sizeof(T);
+    static constexpr size_t capacity = 1;
+    static void describe(SegmentHeader&) {}
+};
+
+inline void add_segment_field(SegmentHeader& header, const char* name, size_t offset, size_t size) {
+    if (header.field_count >= SEGMENT_MAX_FIELDS || std::strlen(name) >= SEGMENT_FIELD_NAME_SIZE) {
+        throw std::runtime_error("Segment field table overflow at " + std::string(name));
+    }
+    SegmentField& field = header.fields[header.field_count++];
+    std::strncpy(field.name, name, SEGMENT_FIELD_NAME_SIZE);
+    field.offset = static_cast<uint32_t>(offset);
+    field.size = static_cast<uint32_t>(size);
+}
+
+// FNV-1a over the descriptive part of the header: type name, sizes,
+// capacity and the field table. Python recomputes it the same way.
+inline uint64_t segment_layout_hash(const SegmentHeader& header) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(header.type_name, SEGMENT_TYPE_NAME_SIZE);
+    mix(&header.payload_size, sizeof(uint32_t) * 3);  // payload_size, record_size, capacity
+    mix(header.fields, sizeof(SegmentField) * header.field_count);
+    return hash;
+}
+
+template<typename T>
+SegmentHeader make_segment_header() {
+    static_assert(sizeof(T) <= UINT32_MAX, "Segment payload too large for the header");
+    SegmentHeader header{};
+    std::memcpy(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    header.version = SEGMENT_VERSION;
+    header.header_size = SEGMENT_HEADER_SIZE;
+    header.payload_offset = SEGMENT_HEADER_SIZE;
+    header.payload_size = sizeof(T);
+    header.record_size = SegmentLayout<T>::record_size;
+    header.capacity = SegmentLayout<T>::capacity;
+    std::strncpy(header.type_name, SegmentLayout<T>::type_name, SEGMENT_TYPE_NAME_SIZE - 1);
+    SegmentLayout<T>::describe(header);
+    header.layout_hash = segment_layout_hash(header);
+    return header;
+}
+
+// Creator: everything but the magic first, so attachers never accept a half-written header
+inline void write_segment_header(char* memory, const SegmentHeader& header) {
+    SegmentHeader* target = reinterpret_cast<SegmentHeader*>(memory);
+    std::memcpy(reinterpret_cast<char*>(target) + sizeof(header.magic),
+                reinterpret_cast<const char*>(&header) + sizeof(header.magic),
+                sizeof(SegmentHeader) - sizeof(header.magic));
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(target->magic, header.magic, sizeof(header.magic));
+}
+
+inline void validate_segment_header(const SegmentHeader* actual, const SegmentHeader& expected, const char* filename) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::string name(filename);
+    if (std::memcmp(actual->magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0) {
+        throw std::runtime_error("Shared memory " + name + " has no segment header (not initialized, or an older producer)");
+    }
+    if (actual->version != SEGMENT_VERSION || actual->payload_offset != expected.payload_offset) {
+        throw std::runtime_error("Shared memory " + name + " uses segment header version " +
+                                 std::to_string(actual->version) + ", expected " + std::to_string(SEGMENT_VERSION));
+    }
+    if (actual->layout_hash != expected.layout_hash || actual->payload_size != expected.payload_size) {
+        throw std::runtime_error("Shared memory " + name + " layout mismatch: segment holds " +
+                                 std::string(actual->type_name, strnlen(actual->type_name, SEGMENT_TYPE_NAME_SIZE)) +
+                                 " (" + std::to_string(actual->payload_size) + " bytes), expected " +
+                                 expected.type_name + " (" + std::to_string(expected.payload_size) + " bytes)" +
+                                 " - rebuild against the producer's headers");
+    }
+}
+
+template<>
+struct SegmentLayout<TradingData> {
+    static constexpr const char* type_name = "TradingData";
+    static constexpr size_t record_size = sizeof(TradingData);
+    static constexpr size_t capacity = 1;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "sequence", offsetof(TradingData, sequence), sizeof(uint64_t));
+        add_segment_field(header, "price", offsetof(TradingData, price), sizeof(double));
+        add_segment_field(header, "timestamp", offsetof(TradingData, timestamp), sizeof(uint64_t));
+        add_segment_field(header, "volume", offsetof(TradingData, volume), sizeof(int32_t));
+        add_segment_field(header, "valid", offsetof(TradingData, valid), sizeof(bool));
+    }
+};
+
+// Record fields of a TradingTick element, offsets relative to base within a slot
+inline void describe_tick_record(SegmentHeader& header, size_t base) {
+    add_segment_field(header, "record.price", base + offsetof(TradingTick, price), sizeof(double));
+    add_segment_field(header, "record.timestamp", base + offsetof(TradingTick, timestamp), sizeof(uint64_t));
+    add_segment_field(header, "record.volume", base + offsetof(TradingTick, volume), sizeof(int32_t));
+    add_segment_field(header, "record.valid", base + offsetof(TradingTick, valid), sizeof(bool));
+    add_segment_field(header, "record.symbol_index", base + offsetof(TradingTick, symbol_index), sizeof(uint16_t));
+    add_segment_field(header, "record.publish_ns", base + offsetof(TradingTick, publish_ns), sizeof(uint64_t));
+}
+
+#endif // SEGMENT_HEADER_H
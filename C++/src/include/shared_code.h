@@ -3,8 +3,20 @@
 
 #include <sys/mman.h>    // shm_open, mmap, munmap
 #include <sys/stat.h>    // mode constants
+#include <sys/file.h>    // flock
 #include <fcntl.h>       // O_* constants
 #include <unistd.h>      // ftruncate, close
+#include <signal.h>      // kill, for stale reader detection
+#include <sys/syscall.h> // SYS_futex
+#include <linux/futex.h> // FUTEX_WAIT, FUTEX_WAKE
+#include <climits>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>   // _mm_pause
+#endif
 #include <string>
 #include <stdexcept>
 #include <cstring>
@@ -12,11 +24,92 @@
 #include <type_traits>
 #include <errno.h>
 #include <atomic>        // For atomic operations needed in trading
+#include <cstddef>
+#include <cstdint>
+#include <new>           // hardware_destructive_interference_size
 #include "trading_system.h"
+#include "segment_header.h"
+#include "mapping_options.h"
+#include <linux/magic.h> // HUGETLBFS_MAGIC
+
+// Keeps producer-owned and consumer-owned fields on separate cache lines.
+// Segment layouts are an ABI shared with the Python struct offsets, so the
+// line size is a fixed constant; std::hardware_destructive_interference_size
+// varies with -mtune and is only used for process-local padding.
+constexpr size_t CACHE_LINE_SIZE = 64;
+#if defined(__cpp_lib_hardware_interference_size)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+constexpr size_t DESTRUCTIVE_INTERFERENCE_SIZE = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+constexpr size_t DESTRUCTIVE_INTERFERENCE_SIZE = CACHE_LINE_SIZE;
+#endif
 
 // Low-level functions for shared memory operations - IMPLEMENTATIONS
-inline char* create_memory_block(const char* filename, int size) {
+
+// Segment backed by a file on hugetlbfs. Returns nullptr after logging when
+// the mount or the huge page pool can't provide it, so the caller falls back
+// to /dev/shm. mapped_length is the size rounded up to whole huge pages.
+inline char* create_hugetlbfs_block(const char* filename, size_t size, const MappingOptions& options,
+                                    size_t& mapped_length) {
+    const std::string path = options.hugetlbfs_path(filename);
+    struct statfs fs{};
+    if (statfs(options.hugetlbfs_dir.c_str(), &fs) == -1 || fs.f_type != HUGETLBFS_MAGIC) {
+        std::cout << "Huge pages: " << options.hugetlbfs_dir << " is not a hugetlbfs mount, "
+                  << filename << " falls back to /dev/shm" << std::endl;
+        return nullptr;
+    }
+
+    const int fd = open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd == -1) {
+        if (errno == EEXIST) {
+            throw std::runtime_error("Shared memory already exists - use attach mode");
+        }
+        std::cout << "Huge pages: cannot create " << path << " (" << strerror(errno) << "), "
+                  << filename << " falls back to /dev/shm" << std::endl;
+        return nullptr;
+    }
+
+    const size_t length = round_up_to(size, backing_page_size(fd));
+    char* memory = static_cast<char*>(MAP_FAILED);
+    if (ftruncate(fd, length) == 0) {
+        // hugetlbfs reserves the pages at mmap time, so an empty pool fails here
+        memory = map_with_options(fd, length, options, filename);
+    }
+    const int error = errno;
+    close(fd);
+
+    if (memory == MAP_FAILED) {
+        unlink(path.c_str());
+        std::cout << "Huge pages: no " << length << " bytes in the huge page pool for " << path << " ("
+                  << strerror(error) << ", see HugePages_Free in /proc/meminfo), "
+                  << filename << " falls back to /dev/shm" << std::endl;
+        return nullptr;
+    }
+    std::cout << "Huge pages: " << filename << " backed by " << path << " ("
+              << length / static_cast<size_t>(fs.f_bsize) << " huge pages)" << std::endl;
+    mapped_length = length;
+    return memory;
+}
+
+inline char* create_memory_block(const char* filename, size_t size, const MappingOptions& options = MappingOptions{},
+                                 size_t* mapped_length = nullptr) {
     std::cout << "Creating memory block " << filename << std::endl;
+    size_t length = size;
+
+    if (options.huge_pages == HugePageMode::HugeTlbfs) {
+        if (char* memory = create_hugetlbfs_block(filename, size, options, length)) {
+            if (mapped_length) {
+                *mapped_length = length;
+            }
+            return memory;
+        }
+    }
   
     const int shm_fd = shm_open(filename, O_CREAT | O_EXCL | O_RDWR, 0666);
     if (shm_fd == -1) {
@@ -33,9 +126,7 @@ inline char* create_memory_block(const char* filename, int size) {
         throw std::runtime_error("Failed to set shared memory size");
     }
 
-    auto memory = static_cast<char*>(
-        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0)
-    );
+    auto memory = map_with_options(shm_fd, size, options, filename);
     close(shm_fd);
 
     if (memory == MAP_FAILED) {
@@ -43,33 +134,159 @@ inline char* create_memory_block(const char* filename, int size) {
         throw std::runtime_error("Failed to map shared memory");
     }
 
+    if (mapped_length) {
+        *mapped_length = length;
+    }
     return memory;
 }
 
-inline char* attach_memory_block(const char* filename, int size) {
-    int shm_fd = shm_open(filename, O_RDWR, 0);
+// Opens an existing segment; with the hugetlbfs option a file the creator
+// placed there wins over /dev/shm. Returns -1 with errno set if neither exists.
+inline int open_memory_block(const char* filename, const MappingOptions& options = MappingOptions{}) {
+    if (options.huge_pages == HugePageMode::HugeTlbfs) {
+        const int fd = open(options.hugetlbfs_path(filename).c_str(), O_RDWR);
+        if (fd != -1) {
+            return fd;
+        }
+    }
+    return shm_open(filename, O_RDWR, 0);
+}
+
+// With `expected`, the segment's header must match it (see segment_header.h)
+inline char* attach_memory_block(const char* filename, size_t size, const SegmentHeader* expected = nullptr,
+                                 const MappingOptions& options = MappingOptions{}, size_t* mapped_length = nullptr) {
+    const int shm_fd = open_memory_block(filename, options);
     if (shm_fd == -1) {
         throw std::runtime_error("Failed to open existing shared memory");
     }
 
-    auto memory = static_cast<char*>(
-        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0)
-    );
+    // Touching a mapping past the end of a smaller object would SIGBUS
+    struct stat st{};
+    if (fstat(shm_fd, &st) == -1 || static_cast<size_t>(st.st_size) < size) {
+        close(shm_fd);
+        throw std::runtime_error("Shared memory " + std::string(filename) + " is smaller than expected (" +
+                                 std::to_string(st.st_size) + " < " + std::to_string(size) + " bytes)");
+    }
+
+    const size_t length = round_up_to(size, backing_page_size(shm_fd));
+    auto memory = map_with_options(shm_fd, length, options, filename);
     close(shm_fd);
 
     if (memory == MAP_FAILED) {
         throw std::runtime_error("Failed to map existing shared memory");
     }
 
+    if (expected) {
+        try {
+            validate_segment_header(reinterpret_cast<const SegmentHeader*>(memory), *expected, filename);
+        } catch (...) {
+            munmap(memory, length);
+            throw;
+        }
+    }
+    if (mapped_length) {
+        *mapped_length = length;
+    }
     return memory;
 }
 
-inline bool detach_from_memory_block(char* block, int size) {
+inline bool detach_from_memory_block(char* block, size_t size) {
     return munmap(block, size) != -1;
 }
 
-inline bool destroy_memory_block(const char* filename) {
-    return shm_unlink(filename) != -1;
+// Removes the /dev/shm object and, with the hugetlbfs option, its hugetlbfs file
+inline bool destroy_memory_block(const char* filename, const MappingOptions& options = MappingOptions{}) {
+    bool removed = shm_unlink(filename) != -1;
+    if (options.huge_pages == HugePageMode::HugeTlbfs) {
+        removed = (unlink(options.hugetlbfs_path(filename).c_str()) != -1) || removed;
+    }
+    return removed;
+}
+
+// Process-shared futex helpers; the word must live in a MAP_SHARED mapping
+inline void futex_wait(std::atomic<uint32_t>* word, uint32_t expected, const timespec* timeout) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+inline void futex_wake_all(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// Wakeup channel placed on its own cache lines after every SharedMemory<T>
+// payload. The producer bumps `epoch` after publishing; consumers block in
+// the kernel on `epoch` instead of sleep-polling. `sleepers` is a flag, not
+// a count, so Python readers can set it with a plain store: notify() only
+// pays for a syscall when somebody has announced they may be asleep.
+// `epoch` is producer-written and `sleepers` consumer-written, so each gets
+// its own line and a consumer going to sleep doesn't steal the producer's.
+struct alignas(CACHE_LINE_SIZE) SegmentNotifier {
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> sleepers{0};
+};
+
+// Offsets below are mirrored by the Python struct layouts in data_bridge.py
+static_assert(offsetof(SegmentNotifier, epoch) == 0, "Python NOTIFIER_EPOCH_OFFSET");
+static_assert(offsetof(SegmentNotifier, sleepers) == 64, "Python NOTIFIER_SLEEPERS_OFFSET");
+static_assert(sizeof(SegmentNotifier) == 128, "Python NOTIFIER_SIZE");
+
+// How a consumer waits for the next update. Latency-critical readers spin
+// (burning a core), background readers block in the kernel right away.
+enum class WaitStrategy {
+    BusySpin,       // spin with cpu_relax() until the update or the timeout
+    Yield,          // sched_yield() between checks
+    SpinThenBlock,  // spin_iterations pauses, then futex wait; 0 spins = block immediately
+    Sleep           // fixed sleep_interval between checks; no futex involvement
+};
+
+struct WaitPolicy {
+    WaitStrategy strategy = WaitStrategy::SpinThenBlock;
+    uint32_t spin_iterations = 0;
+    std::chrono::microseconds sleep_interval{100};
+
+    // Accepts "busy-spin", "yield", "block", "spin:<iterations>" and "sleep:<microseconds>"
+    static WaitPolicy parse(const std::string& spec) {
+        WaitPolicy policy;
+        const auto colon = spec.find(':');
+        const std::string kind = spec.substr(0, colon);
+        const std::string arg = colon == std::string::npos ? "" : spec.substr(colon + 1);
+
+        if (kind == "busy-spin") {
+            policy.strategy = WaitStrategy::BusySpin;
+        } else if (kind == "yield") {
+            policy.strategy = WaitStrategy::Yield;
+        } else if (kind == "block") {
+            policy.strategy = WaitStrategy::SpinThenBlock;
+        } else if (kind == "spin") {
+            policy.strategy = WaitStrategy::SpinThenBlock;
+            policy.spin_iterations = arg.empty() ? 10000 : static_cast<uint32_t>(std::stoul(arg));
+        } else if (kind == "sleep") {
+            policy.strategy = WaitStrategy::Sleep;
+            if (!arg.empty()) {
+                policy.sleep_interval = std::chrono::microseconds(std::stoul(arg));
+            }
+        } else {
+            throw std::runtime_error("Unknown wait strategy: " + spec);
+        }
+        return policy;
+    }
+
+    // Lets each process pick its trade-off without a rebuild
+    static WaitPolicy from_env(const char* variable = "TRADING_WAIT_STRATEGY") {
+        const char* spec = std::getenv(variable);
+        return spec ? parse(spec) : WaitPolicy{};
+    }
+};
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+constexpr size_t segment_notifier_offset(size_t payload_size) {
+    return (payload_size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
 }
 
 
@@ -79,43 +296,459 @@ private:
     char* raw_memory_;
     const char* filename_;
     bool owner_;
+    MappingOptions options_;
+    size_t mapped_length_;  // mapped_size() rounded up to the backing page size
     static_assert(std::is_trivially_copyable_v<T>,
                   "Type must be trivially copyable for shared memory");
 
 public:
-    explicit SharedMemory(const char* filename, bool create_new = true);
+    explicit SharedMemory(const char* filename, bool create_new = true,
+                          const MappingOptions& options = MappingOptions{});
     ~SharedMemory();
 
-    T* get() { return reinterpret_cast<T*>(raw_memory_); }
-    const T* get() const { return reinterpret_cast<const T*>(raw_memory_); }
+    T* get() { return reinterpret_cast<T*>(raw_memory_ + SEGMENT_HEADER_SIZE); }
+    const T* get() const { return reinterpret_cast<const T*>(raw_memory_ + SEGMENT_HEADER_SIZE); }
     T& operator*() { return *get(); }
     const T& operator*() const { return *get(); }
     T* operator->() { return get(); }
     const T* operator->() const { return get(); }
     
     bool is_valid() const { return raw_memory_ != nullptr; }
+    const char* name() const { return filename_; }
+    const MappingOptions& options() const { return options_; }
+
+    const SegmentHeader* header() const { return reinterpret_cast<const SegmentHeader*>(raw_memory_); }
+
+    // Header page, payload and the trailing SegmentNotifier
+    static constexpr size_t mapped_size() {
+        return SEGMENT_HEADER_SIZE + segment_notifier_offset(sizeof(T)) + sizeof(SegmentNotifier);
+    }
+
+    SegmentNotifier* notifier() const {
+        return reinterpret_cast<SegmentNotifier*>(raw_memory_ + SEGMENT_HEADER_SIZE + segment_notifier_offset(sizeof(T)));
+    }
+
+    // Producer: call after publishing; cheap when nobody is blocked
+    void notify() {
+        SegmentNotifier* n = notifier();
+        n->epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (n->sleepers.load(std::memory_order_seq_cst) != 0 && n->sleepers.exchange(0) != 0) {
+            futex_wake_all(&n->epoch);
+        }
+    }
+
+    uint32_t update_epoch() const {
+        return notifier()->epoch.load(std::memory_order_acquire);
+    }
+
+    // Consumer: wait until the epoch moves past last_epoch or the timeout
+    // expires, using the given strategy. Returns true if there was an update.
+    bool wait_for_update(uint32_t last_epoch, std::chrono::nanoseconds timeout,
+                         const WaitPolicy& policy = WaitPolicy{}) const;
 };
 
 template<typename T>
-SharedMemory<T>::SharedMemory(const char* filename, bool create_new)
-    : raw_memory_(nullptr), filename_(filename), owner_(create_new) {
+SharedMemory<T>::SharedMemory(const char* filename, bool create_new, const MappingOptions& options)
+    : raw_memory_(nullptr), filename_(filename), owner_(create_new), options_(options), mapped_length_(0) {
 
+    const SegmentHeader expected = make_segment_header<T>();
     if (create_new) {
-        raw_memory_ = create_memory_block(filename, sizeof(T));
-        new(raw_memory_) T{};
+        raw_memory_ = create_memory_block(filename, mapped_size(), options_, &mapped_length_);
+        new(get()) T{};
+        new(notifier()) SegmentNotifier{};
+        write_segment_header(raw_memory_, expected);
     } else {
-        raw_memory_ = attach_memory_block(filename, sizeof(T));
+        raw_memory_ = attach_memory_block(filename, mapped_size(), &expected, options_, &mapped_length_);
     }
 }
 
 template<typename T>
 SharedMemory<T>::~SharedMemory() {
     if (raw_memory_) {
-        detach_from_memory_block(raw_memory_, sizeof(T));
+        detach_from_memory_block(raw_memory_, mapped_length_);
         if (owner_) {
-            destroy_memory_block(filename_);
+            destroy_memory_block(filename_, options_);
         }
     }
 }
 
+template<typename T>
+bool SharedMemory<T>::wait_for_update(uint32_t last_epoch, std::chrono::nanoseconds timeout,
+                                      const WaitPolicy& policy) const {
+    SegmentNotifier* n = notifier();
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto updated = [&] { return n->epoch.load(std::memory_order_acquire) != last_epoch; };
+
+    switch (policy.strategy) {
+    case WaitStrategy::BusySpin:
+        // Only consult the clock every 1024 pauses to keep the loop tight
+        for (uint32_t i = 1; !updated(); ++i) {
+            cpu_relax();
+            if ((i & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+        }
+        return true;
+    case WaitStrategy::Yield:
+        while (!updated()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    case WaitStrategy::Sleep:
+        while (!updated()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(policy.sleep_interval);
+        }
+        return true;
+    case WaitStrategy::SpinThenBlock:
+        for (uint32_t i = 0; i < policy.spin_iterations; ++i) {
+            if (updated()) {
+                return true;
+            }
+            cpu_relax();
+        }
+        break;
+    }
+
+    while (!updated()) {
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            return false;
+        }
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+        timespec ts{};
+        ts.tv_sec = secs.count();
+        ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - secs).count();
+
+        // Announce before re-checking so a concurrent notify() cannot miss us
+        n->sleepers.store(1, std::memory_order_seq_cst);
+        if (n->epoch.load(std::memory_order_seq_cst) != last_epoch) {
+            break;
+        }
+        futex_wait(&n->epoch, last_epoch, &ts);
+    }
+    return true;
+}
+
+// Lock-free single-producer/single-consumer queue laid out for shared memory.
+// Map it with SharedMemory<SharedRingBuffer<T, N>>. `head` and `tail` are
+// free-running counters; slot index is counter & (N - 1). Each side keeps a
+// cached copy of the other side's counter on its own cache line so the hot
+// path only touches the remote line when the cached value says full/empty.
+// The producer never blocks: try_push() fails when the consumer is N behind.
+template<typename T, size_t N>
+struct SharedRingBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Ring capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Ring element must be trivially copyable for shared memory");
+
+    using value_type = T;
+    static constexpr size_t capacity = N;
+    static constexpr uint64_t mask = N - 1;
+
+    // Producer-owned line
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};
+    uint64_t cached_tail = 0;
+
+    // Consumer-owned line
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail{0};
+    uint64_t cached_head = 0;
+
+    alignas(CACHE_LINE_SIZE) T slots[N];
+
+    bool try_push(const T& value) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - cached_tail >= N) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h - cached_tail >= N) {
+                return false;
+            }
+        }
+        slots[h & mask] = value;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        return pop_batch(&out, 1) == 1;
+    }
+
+    // Copies up to max_count elements into out and releases their slots
+    size_t pop_batch(T* out, size_t max_count) {
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        if (cached_head == t) {
+            cached_head = head.load(std::memory_order_acquire);
+        }
+        size_t count = static_cast<size_t>(cached_head - t);
+        if (count > max_count) {
+            count = max_count;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = slots[(t + i) & mask];
+        }
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t size() const {
+        // Tail first: it can only move towards head, never past it
+        const uint64_t t = tail.load(std::memory_order_acquire);
+        return static_cast<size_t>(head.load(std::memory_order_acquire) - t);
+    }
+
+    bool empty() const { return size() == 0; }
+};
+
+// Tick stream published by the producer alongside the latest-value TradingData
+constexpr size_t TICK_RING_CAPACITY = 4096;
+using TickRing = SharedRingBuffer<TradingTick, TICK_RING_CAPACITY>;
+
+template<>
+struct SegmentLayout<TickRing> {
+    static constexpr const char* type_name = "TickRing";
+    static constexpr size_t record_size = sizeof(TradingTick);
+    static constexpr size_t capacity = TICK_RING_CAPACITY;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "head", offsetof(TickRing, head), sizeof(uint64_t));
+        add_segment_field(header, "tail", offsetof(TickRing, tail), sizeof(uint64_t));
+        add_segment_field(header, "slots", offsetof(TickRing, slots), sizeof(TickRing::slots));
+        describe_tick_record(header, 0);
+    }
+};
+
+static_assert(offsetof(TickRing, head) == 0, "Python TICK_RING_HEAD_OFFSET");
+static_assert(offsetof(TickRing, tail) == 64, "Python TICK_RING_TAIL_OFFSET");
+static_assert(offsetof(TickRing, slots) == 128, "Python TICK_RING_SLOTS_OFFSET");
+static_assert(sizeof(TickRing) == 128 + TICK_RING_CAPACITY * 32, "Python TICK_RING_SIZE");
+
+// One-writer, many-reader broadcast ring laid out for shared memory.
+// Unlike SharedRingBuffer the writer never looks at readers: it overwrites
+// the oldest slot unconditionally. Each slot carries a sequence stamp
+// (2 * position + 1 while being written, 2 * position + 2 once published),
+// so a reader holding its own cursor can tell a fresh slot from one the
+// writer has already lapped. Slot payloads are copied as relaxed atomic
+// words, keeping concurrent overwrites free of data races.
+//
+// Readers register in `readers` so their cursor and drop counts are
+// visible to monitoring tools; registration is serialized with flock() on
+// the segment so C++ and Python readers can share the table.
+template<typename T, size_t N, size_t MaxReaders = 16>
+struct SharedBroadcastRing {
+    static_assert(N > 1 && (N & (N - 1)) == 0, "Ring capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Ring element must be trivially copyable for shared memory");
+
+    using value_type = T;
+    static constexpr size_t capacity = N;
+    static constexpr size_t max_readers = MaxReaders;
+    static constexpr uint64_t mask = N - 1;
+    static constexpr size_t words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> payload[words];
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ReaderSlot {
+        std::atomic<int32_t> pid{0};         // 0 when the slot is free
+        std::atomic<uint64_t> cursor{0};     // next position the reader will consume
+        std::atomic<uint64_t> received{0};
+        std::atomic<uint64_t> dropped{0};    // ticks overwritten before the reader got to them
+    };
+
+    // Writer-owned line: number of values ever published
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};
+
+    alignas(CACHE_LINE_SIZE) ReaderSlot readers[MaxReaders];
+    alignas(CACHE_LINE_SIZE) Slot slots[N];
+
+    void publish(const T& value) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[h & mask];
+
+        uint64_t buffer[words] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        slot.sequence.store(2 * h + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < words; ++i) {
+            slot.payload[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        slot.sequence.store(2 * h + 2, std::memory_order_release);
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+// Process-local reader handle over a SharedBroadcastRing. Owns a cursor
+// and a registration in the ring's reader table; fast readers never wait
+// on slow ones, and a reader the writer has lapped skips ahead to the
+// oldest value still in the ring, counting everything it missed.
+template<typename Ring>
+class BroadcastReader {
+private:
+    using T = typename Ring::value_type;
+
+    const SharedMemory<Ring>* shm_;
+    Ring* ring_;
+    WaitPolicy policy_;
+    typename Ring::ReaderSlot* slot_;
+    uint64_t cursor_;
+    uint64_t received_;
+    uint64_t dropped_;
+
+    typename Ring::ReaderSlot* register_reader(const char* filename) {
+        int shm_fd = open_memory_block(filename, shm_->options());
+        if (shm_fd == -1) {
+            throw std::runtime_error("Failed to open broadcast ring for reader registration");
+        }
+        flock(shm_fd, LOCK_EX);
+
+        typename Ring::ReaderSlot* claimed = nullptr;
+        for (size_t i = 0; i < Ring::max_readers && !claimed; ++i) {
+            auto& candidate = ring_->readers[i];
+            const int32_t pid = candidate.pid.load(std::memory_order_acquire);
+            // Reclaim slots left behind by readers that died without detaching
+            if (pid == 0 || (kill(pid, 0) == -1 && errno == ESRCH)) {
+                candidate.received.store(0, std::memory_order_relaxed);
+                candidate.dropped.store(0, std::memory_order_relaxed);
+                candidate.cursor.store(cursor_, std::memory_order_relaxed);
+                candidate.pid.store(getpid(), std::memory_order_release);
+                claimed = &candidate;
+            }
+        }
+
+        flock(shm_fd, LOCK_UN);
+        close(shm_fd);
+
+        if (!claimed) {
+            throw std::runtime_error("Broadcast ring reader table is full");
+        }
+        return claimed;
+    }
+
+    void handle_overrun() {
+        // The slot at head & mask may be mid-write, so resume one past it
+        const uint64_t oldest = ring_->head.load(std::memory_order_acquire) - Ring::capacity + 1;
+        if (oldest > cursor_) {
+            dropped_ += oldest - cursor_;
+            cursor_ = oldest;
+        }
+    }
+
+public:
+    // Starts at the live edge: only values published after attaching are seen
+    explicit BroadcastReader(SharedMemory<Ring>& shm, WaitPolicy policy = WaitPolicy::from_env())
+        : shm_(&shm), ring_(shm.get()), policy_(policy), slot_(nullptr),
+          cursor_(0), received_(0), dropped_(0) {
+        cursor_ = ring_->head.load(std::memory_order_acquire);
+        slot_ = register_reader(shm.name());
+    }
+
+    ~BroadcastReader() {
+        slot_->pid.store(0, std::memory_order_release);
+    }
+
+    BroadcastReader(const BroadcastReader&) = delete;
+    BroadcastReader& operator=(const BroadcastReader&) = delete;
+
+    // Copies up to max_count new values into out; never blocks
+    size_t poll(T* out, size_t max_count) {
+        size_t count = 0;
+        while (count < max_count) {
+            const auto& slot = ring_->slots[cursor_ & Ring::mask];
+            const uint64_t expected = 2 * cursor_ + 2;
+
+            const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before < expected) {
+                break;  // not published yet
+            }
+            if (before > expected) {
+                handle_overrun();
+                continue;
+            }
+
+            uint64_t buffer[Ring::words];
+            for (size_t i = 0; i < Ring::words; ++i) {
+                buffer[i] = slot.payload[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+                handle_overrun();
+                continue;
+            }
+
+            std::memcpy(&out[count], buffer, sizeof(T));
+            ++count;
+            ++cursor_;
+        }
+
+        received_ += count;
+        slot_->cursor.store(cursor_, std::memory_order_relaxed);
+        slot_->received.store(received_, std::memory_order_relaxed);
+        slot_->dropped.store(dropped_, std::memory_order_relaxed);
+        return count;
+    }
+
+    // Like poll(), but waits up to timeout under this reader's WaitPolicy
+    // when nothing is pending
+    size_t wait_and_poll(T* out, size_t max_count, std::chrono::nanoseconds timeout) {
+        const uint32_t epoch = shm_->update_epoch();
+        size_t count = poll(out, max_count);
+        if (count == 0 && shm_->wait_for_update(epoch, timeout, policy_)) {
+            count = poll(out, max_count);
+        }
+        return count;
+    }
+
+    const WaitPolicy& wait_policy() const { return policy_; }
+    void set_wait_policy(const WaitPolicy& policy) { policy_ = policy; }
+
+    uint64_t cursor() const { return cursor_; }
+    uint64_t received() const { return received_; }
+    uint64_t dropped() const { return dropped_; }
+
+    // Values published but not yet consumed by this reader
+    uint64_t lag() const {
+        return ring_->head.load(std::memory_order_acquire) - cursor_;
+    }
+};
+
+// Tick stream fanned out to every monitor, viewer and strategy process
+constexpr size_t BROADCAST_RING_CAPACITY = 4096;
+constexpr size_t BROADCAST_MAX_READERS = 16;
+using TickBroadcastRing = SharedBroadcastRing<TradingTick, BROADCAST_RING_CAPACITY, BROADCAST_MAX_READERS>;
+using TickBroadcastReader = BroadcastReader<TickBroadcastRing>;
+
+template<>
+struct SegmentLayout<TickBroadcastRing> {
+    using Ring = TickBroadcastRing;
+    static constexpr const char* type_name = "TickBroadcastRing";
+    static constexpr size_t record_size = sizeof(Ring::Slot);
+    static constexpr size_t capacity = BROADCAST_RING_CAPACITY;
+    static void describe(SegmentHeader& header) {
+        add_segment_field(header, "head", offsetof(Ring, head), sizeof(uint64_t));
+        add_segment_field(header, "readers", offsetof(Ring, readers), sizeof(Ring::readers));
+        add_segment_field(header, "reader.pid", offsetof(Ring::ReaderSlot, pid), sizeof(int32_t));
+        add_segment_field(header, "reader.cursor", offsetof(Ring::ReaderSlot, cursor), sizeof(uint64_t));
+        add_segment_field(header, "reader.received", offsetof(Ring::ReaderSlot, received), sizeof(uint64_t));
+        add_segment_field(header, "reader.dropped", offsetof(Ring::ReaderSlot, dropped), sizeof(uint64_t));
+        add_segment_field(header, "slots", offsetof(Ring, slots), sizeof(Ring::slots));
+        add_segment_field(header, "record.sequence", offsetof(Ring::Slot, sequence), sizeof(uint64_t));
+        describe_tick_record(header, offsetof(Ring::Slot, payload));
+    }
+};
+
+static_assert(offsetof(TickBroadcastRing, head) == 0, "Python BROADCAST_HEAD_OFFSET");
+static_assert(offsetof(TickBroadcastRing, readers) == 64, "Python BROADCAST_READERS_OFFSET");
+static_assert(sizeof(TickBroadcastRing::ReaderSlot) == 64, "Python BROADCAST_READER_STRIDE");
+static_assert(offsetof(TickBroadcastRing::ReaderSlot, cursor) == 8, "Python BROADCAST_READER_FORMAT");
+static_assert(offsetof(TickBroadcastRing::ReaderSlot, dropped) == 24, "Python BROADCAST_READER_FORMAT");
+static_assert(sizeof(TickBroadcastRing::Slot) == 40, "Python BROADCAST_SLOT_SIZE");
+static_assert(offsetof(TickBroadcastRing, slots) == 64 + BROADCAST_MAX_READERS * 64, "Python BROADCAST_SLOTS_OFFSET");
+
 #endif // SHARED_MEM_H
@@ -0,0 +1,513 @@
+#ifndef STRATEGY_PIPELINE_H
+#define STRATEGY_PIPELINE_H
+
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "tick_store.h"   // TickRange
+
+// Per-tick strategy chains: indicators feed a signal rule, the rule's
+// target position goes to one or more sinks. The stages are plain types
+// composed as template arguments,
+//
+//   Pipeline<LongOnly<Crossover<Sma<10>, Ema<50>>>, EquitySink, SignalCounter>
+//
+// so the compiler sees the whole chain and inlines it into the tick loop:
+// no virtual calls, no std::function, windows and EMA constants fixed at
+// compile time. The same stage templates also run from a spec string
+// chosen at runtime (parse_strategy_rule), with each indicator and rule
+// behind a virtual call, runtime-sized windows and std::function sinks.
+// That mode is for exploring; both produce identical signals.
+//
+// Interfaces, by convention rather than base classes:
+//   indicator  void update(const PipelineTick&); bool ready() const; double value() const;
+//   rule       int update(const PipelineTick&);  target position: -1, 0 or 1
+//   sink       void on_signal(const PipelineTick&, int position);
+
+constexpr size_t DYNAMIC_WINDOW = 0;  // window length given to the constructor instead
+
+struct PipelineTick {
+    uint64_t timestamp = 0;
+    double price = 0.0;
+    double volume = 0.0;
+};
+
+// Last N prices: std::array for a compile-time N, a vector otherwise
+template<size_t N>
+class WindowRing {
+private:
+    std::array<double, N> values_{};
+
+public:
+    explicit WindowRing(size_t window = N) {
+        if (window != N) {
+            throw std::runtime_error("Window length " + std::to_string(window) + " for a " + std::to_string(N) +
+                                     "-tick indicator");
+        }
+    }
+    static constexpr size_t size() { return N; }
+    double& operator[](size_t i) { return values_[i]; }
+    double operator[](size_t i) const { return values_[i]; }
+};
+
+template<>
+class WindowRing<DYNAMIC_WINDOW> {
+private:
+    std::vector<double> values_;
+
+public:
+    explicit WindowRing(size_t window = 0) : values_(window) {
+        if (window == 0) {
+            throw std::runtime_error("Indicator window must be at least 1 tick");
+        }
+    }
+    size_t size() const { return values_.size(); }
+    double& operator[](size_t i) { return values_[i]; }
+    double operator[](size_t i) const { return values_[i]; }
+};
+
+// Simple moving average of the last N prices
+template<size_t N = DYNAMIC_WINDOW>
+class Sma {
+private:
+    WindowRing<N> ring_;
+    size_t next_ = 0;
+    uint64_t samples_ = 0;
+    double sum_ = 0.0;
+
+public:
+    explicit Sma(size_t window = N) : ring_(window) {}
+
+    void update(const PipelineTick& tick) {
+        const size_t n = ring_.size();
+        if (samples_ >= n) {
+            sum_ -= ring_[next_];
+        }
+        ring_[next_] = tick.price;
+        sum_ += tick.price;
+        ++samples_;
+        // Rebuild the sum once per lap so add/subtract rounding can't accumulate
+        if (++next_ == n) {
+            next_ = 0;
+            sum_ = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                sum_ += ring_[i];
+            }
+        }
+    }
+
+    bool ready() const { return samples_ >= ring_.size(); }
+    double value() const { return samples_ ? sum_ / (ready() ? ring_.size() : samples_) : 0.0; }
+};
+
+// Exponential moving average with alpha = 2 / (N + 1), ready after N ticks
+template<size_t N = DYNAMIC_WINDOW>
+class Ema {
+private:
+    uint64_t window_;
+    double alpha_;
+    uint64_t samples_ = 0;
+    double ema_ = 0.0;
+
+    double alpha() const {
+        if constexpr (N != DYNAMIC_WINDOW) {
+            return 2.0 / (N + 1);
+        } else {
+            return alpha_;
+        }
+    }
+
+public:
+    explicit Ema(size_t window = N) : window_(window), alpha_(2.0 / (window + 1)) {
+        if (window == 0 || (N != DYNAMIC_WINDOW && window != N)) {
+            throw std::runtime_error("Invalid EMA window " + std::to_string(window));
+        }
+    }
+
+    void update(const PipelineTick& tick) {
+        ema_ = samples_ == 0 ? tick.price : ema_ + alpha() * (tick.price - ema_);
+        ++samples_;
+    }
+
+    bool ready() const {
+        if constexpr (N != DYNAMIC_WINDOW) {
+            return samples_ >= N;
+        } else {
+            return samples_ >= window_;
+        }
+    }
+    double value() const { return ema_; }
+};
+
+// Price change over the last N ticks
+template<size_t N = DYNAMIC_WINDOW>
+class Momentum {
+private:
+    WindowRing<N> ring_;
+    size_t next_ = 0;
+    uint64_t samples_ = 0;
+    double change_ = 0.0;
+
+public:
+    explicit Momentum(size_t window = N) : ring_(window) {}
+
+    void update(const PipelineTick& tick) {
+        change_ = samples_ >= ring_.size() ? tick.price - ring_[next_] : 0.0;
+        ring_[next_] = tick.price;
+        ++samples_;
+        if (++next_ == ring_.size()) {
+            next_ = 0;
+        }
+    }
+
+    bool ready() const { return samples_ > ring_.size(); }
+    double value() const { return change_; }
+};
+
+// Long while Fast is above Slow, short while below, unchanged when equal
+template<typename Fast, typename Slow>
+class Crossover {
+private:
+    Fast fast_;
+    Slow slow_;
+    int position_ = 0;
+
+public:
+    Crossover() = default;
+    Crossover(Fast fast, Slow slow) : fast_(std::move(fast)), slow_(std::move(slow)) {}
+
+    int update(const PipelineTick& tick) {
+        fast_.update(tick);
+        slow_.update(tick);
+        if (fast_.ready() && slow_.ready()) {
+            const double fast = fast_.value();
+            const double slow = slow_.value();
+            if (fast > slow) {
+                position_ = 1;
+            } else if (fast < slow) {
+                position_ = -1;
+            }
+        }
+        return position_;
+    }
+};
+
+// Follows the sign of one indicator, e.g. Momentum; unchanged at zero
+template<typename Indicator>
+class SignOf {
+private:
+    Indicator indicator_;
+    int position_ = 0;
+
+public:
+    SignOf() = default;
+    explicit SignOf(Indicator indicator) : indicator_(std::move(indicator)) {}
+
+    int update(const PipelineTick& tick) {
+        indicator_.update(tick);
+        if (indicator_.ready()) {
+            const double value = indicator_.value();
+            if (value > 0.0) {
+                position_ = 1;
+            } else if (value < 0.0) {
+                position_ = -1;
+            }
+        }
+        return position_;
+    }
+};
+
+// Takes a position only when both rules agree on it, flat otherwise
+template<typename A, typename B>
+class Both {
+private:
+    A a_;
+    B b_;
+
+public:
+    Both() = default;
+    Both(A a, B b) : a_(std::move(a)), b_(std::move(b)) {}
+
+    int update(const PipelineTick& tick) {
+        const int a = a_.update(tick);
+        const int b = b_.update(tick);
+        return a == b ? a : 0;
+    }
+};
+
+// Flat instead of short
+template<typename Rule>
+class LongOnly {
+private:
+    Rule rule_;
+
+public:
+    LongOnly() = default;
+    explicit LongOnly(Rule rule) : rule_(std::move(rule)) {}
+
+    int update(const PipelineTick& tick) {
+        const int position = rule_.update(tick);
+        return position > 0 ? position : 0;
+    }
+};
+
+// Marks the position to market every tick; costs are charged per unit of
+// position change, the same accounting as the backtester
+class EquitySink {
+private:
+    double cost_;
+    double equity_ = 1.0;
+    double peak_ = 1.0;
+    double max_drawdown_ = 0.0;
+    double last_price_ = 0.0;
+    int position_ = 0;
+    uint64_t trades_ = 0;
+
+public:
+    explicit EquitySink(double cost_bps = 1.0) : cost_(cost_bps * 1e-4) {}
+
+    void on_signal(const PipelineTick& tick, int position) {
+        if (position_ != 0 && last_price_ != 0.0) {
+            equity_ *= 1.0 + position_ * (tick.price / last_price_ - 1.0);
+        }
+        last_price_ = tick.price;
+        if (position != position_) {
+            equity_ *= 1.0 - cost_ * std::abs(position - position_);
+            position_ = position;
+            ++trades_;
+        }
+        if (equity_ > peak_) {
+            peak_ = equity_;
+        }
+        const double drawdown = 1.0 - equity_ / peak_;
+        if (drawdown > max_drawdown_) {
+            max_drawdown_ = drawdown;
+        }
+    }
+
+    double total_return() const { return equity_ - 1.0; }
+    double max_drawdown() const { return max_drawdown_; }
+    uint64_t trades() const { return trades_; }
+    int position() const { return position_; }
+};
+
+// Ticks spent long, flat and short
+class SignalCounter {
+private:
+    uint64_t counts_[3] = {0, 0, 0};
+
+public:
+    void on_signal(const PipelineTick&, int position) { ++counts_[position + 1]; }
+
+    uint64_t short_ticks() const { return counts_[0]; }
+    uint64_t flat_ticks() const { return counts_[1]; }
+    uint64_t long_ticks() const { return counts_[2]; }
+};
+
+// Timestamp and new position at every change, for inspection
+class SignalRecorder {
+private:
+    std::vector<std::pair<uint64_t, int>> changes_;
+    int position_ = 0;
+
+public:
+    void on_signal(const PipelineTick& tick, int position) {
+        if (position != position_) {
+            changes_.emplace_back(tick.timestamp, position);
+            position_ = position;
+        }
+    }
+
+    const std::vector<std::pair<uint64_t, int>>& changes() const { return changes_; }
+};
+
+template<typename Rule, typename... Sinks>
+class Pipeline {
+private:
+    Rule rule_;
+    std::tuple<Sinks...> sinks_;
+
+public:
+    Pipeline() = default;
+    explicit Pipeline(Rule rule, Sinks... sinks) : rule_(std::move(rule)), sinks_(std::move(sinks)...) {}
+
+    void on_tick(const PipelineTick& tick) {
+        const int position = rule_.update(tick);
+        std::apply([&](auto&... sink) { (sink.on_signal(tick, position), ...); }, sinks_);
+    }
+
+    void run(const TickRange& range) {
+        const uint64_t* timestamps = range.timestamp.data;
+        const double* prices = range.price.data;
+        const double* volumes = range.volume.data;
+        for (size_t i = 0; i < range.size(); ++i) {
+            on_tick({timestamps[i], prices[i], volumes[i]});
+        }
+    }
+
+    template<size_t I>
+    auto& sink() { return std::get<I>(sinks_); }
+    template<size_t I>
+    const auto& sink() const { return std::get<I>(sinks_); }
+};
+
+// Runtime-dispatched stages: any indicator or rule type behind a virtual
+// call, so chains can be assembled from configuration
+
+class DynamicIndicator {
+private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual void update(const PipelineTick& tick) = 0;
+        virtual bool ready() const = 0;
+        virtual double value() const = 0;
+    };
+
+    template<typename T>
+    struct Model final : Concept {
+        T indicator;
+        explicit Model(T i) : indicator(std::move(i)) {}
+        void update(const PipelineTick& tick) override { indicator.update(tick); }
+        bool ready() const override { return indicator.ready(); }
+        double value() const override { return indicator.value(); }
+    };
+
+    std::unique_ptr<Concept> impl_;
+
+public:
+    DynamicIndicator() = default;
+    template<typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, DynamicIndicator>>>
+    explicit DynamicIndicator(T indicator) : impl_(std::make_unique<Model<T>>(std::move(indicator))) {}
+
+    void update(const PipelineTick& tick) { impl_->update(tick); }
+    bool ready() const { return impl_->ready(); }
+    double value() const { return impl_->value(); }
+};
+
+class DynamicRule {
+private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual int update(const PipelineTick& tick) = 0;
+    };
+
+    template<typename T>
+    struct Model final : Concept {
+        T rule;
+        explicit Model(T r) : rule(std::move(r)) {}
+        int update(const PipelineTick& tick) override { return rule.update(tick); }
+    };
+
+    std::unique_ptr<Concept> impl_;
+
+public:
+    DynamicRule() = default;
+    template<typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, DynamicRule>>>
+    explicit DynamicRule(T rule) : impl_(std::make_unique<Model<T>>(std::move(rule))) {}
+
+    int update(const PipelineTick& tick) { return impl_->update(tick); }
+};
+
+// Any number of sinks added at runtime
+class SinkList {
+private:
+    std::vector<std::function<void(const PipelineTick&, int)>> sinks_;
+
+public:
+    // Sinks are held by reference; they must outlive the pipeline's use
+    template<typename Sink>
+    void add(Sink& sink) {
+        sinks_.emplace_back([&sink](const PipelineTick& tick, int position) { sink.on_signal(tick, position); });
+    }
+
+    void on_signal(const PipelineTick& tick, int position) {
+        for (auto& sink : sinks_) {
+            sink(tick, position);
+        }
+    }
+};
+
+using RuntimePipeline = Pipeline<DynamicRule, SinkList>;
+
+// "sma10", "ema50", "mom20"
+inline DynamicIndicator parse_strategy_indicator(const std::string& spec) {
+    size_t digits = 0;
+    while (digits < spec.size() && !std::isdigit(static_cast<unsigned char>(spec[digits]))) {
+        ++digits;
+    }
+    const std::string kind = spec.substr(0, digits);
+    size_t window = 0;
+    try {
+        size_t used = 0;
+        window = std::stoul(spec.substr(digits), &used);
+        if (digits + used != spec.size() || window == 0) {
+            throw std::invalid_argument(spec);
+        }
+    } catch (const std::logic_error&) {
+        throw std::runtime_error("Invalid indicator: " + spec + " (use sma10, ema50, mom20)");
+    }
+    if (kind == "sma") {
+        return DynamicIndicator(Sma<>(window));
+    }
+    if (kind == "ema") {
+        return DynamicIndicator(Ema<>(window));
+    }
+    if (kind == "mom") {
+        return DynamicIndicator(Momentum<>(window));
+    }
+    throw std::runtime_error("Unknown indicator: " + spec + " (use sma, ema or mom)");
+}
+
+// Rules joined by '&' must all agree (Both); each is
+//   [long:]cross:<fast>:<slow>   Crossover of two indicators
+//   [long:]sign:<indicator>      SignOf one indicator
+// e.g. "long:cross:ema12:ema26&sign:mom100"
+inline DynamicRule parse_strategy_rule(const std::string& spec) {
+    std::vector<DynamicRule> rules;
+    std::stringstream terms(spec);
+    std::string term;
+    while (std::getline(terms, term, '&')) {
+        std::vector<std::string> parts;
+        std::stringstream fields(term);
+        std::string field;
+        while (std::getline(fields, field, ':')) {
+            parts.push_back(field);
+        }
+        const bool long_only = !parts.empty() && parts[0] == "long";
+        if (long_only) {
+            parts.erase(parts.begin());
+        }
+
+        DynamicRule rule;
+        if (parts.size() == 3 && parts[0] == "cross") {
+            rule = DynamicRule(Crossover<DynamicIndicator, DynamicIndicator>(parse_strategy_indicator(parts[1]),
+                                                                             parse_strategy_indicator(parts[2])));
+        } else if (parts.size() == 2 && parts[0] == "sign") {
+            rule = DynamicRule(SignOf<DynamicIndicator>(parse_strategy_indicator(parts[1])));
+        } else {
+            throw std::runtime_error("Invalid strategy rule: " + term + " (use cross:sma10:sma50 or sign:mom20)");
+        }
+        rules.push_back(long_only ? DynamicRule(LongOnly<DynamicRule>(std::move(rule))) : std::move(rule));
+    }
+    if (rules.empty()) {
+        throw std::runtime_error("Empty strategy rule");
+    }
+
+    DynamicRule combined = std::move(rules[0]);
+    for (size_t i = 1; i < rules.size(); ++i) {
+        combined = DynamicRule(Both<DynamicRule, DynamicRule>(std::move(combined), std::move(rules[i])));
+    }
+    return combined;
+}
+
+#endif // STRATEGY_PIPELINE_H
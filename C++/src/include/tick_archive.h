@@ -0,0 +1,940 @@
+#ifndef TICK_ARCHIVE_H
+#define TICK_ARCHIVE_H
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tick_store.h"
+
+// Compressed, write-once tick archive (<symbol>.tka) for long-term history.
+// Records are cut into blocks of TICK_ARCHIVE_BLOCK_RECORDS; each block
+// encodes its seven columns as independent streams:
+//
+//   timestamp  delta-of-delta, zigzagged, in 1/10/19/36/68-bit buckets
+//   doubles    Gorilla XOR against the previous value of the column
+//   volume     LEB128 varints when every volume in the block is a whole number
+//   OHLC       nothing at all when the column equals price (live ticks)
+//
+//   [0, 64)          TickArchiveHeader
+//   [64, ...)        encoded blocks, back to back
+//   index_offset     TickArchiveBlock[block_count]: offset, size, record
+//                    range, min/max timestamp and price of each block
+//
+// Blocks carry their own state, so they decode independently: range
+// queries skip blocks by the index and decode() spreads blocks
+// over threads. The header is written last; an archive whose writer never
+// finished has no magic and is rejected.
+
+constexpr char TICK_ARCHIVE_MAGIC[8] = {'T', 'I', 'C', 'K', 'A', 'R', 'C', '1'};
+constexpr uint32_t TICK_ARCHIVE_VERSION = 1;
+constexpr uint32_t TICK_ARCHIVE_BLOCK_RECORDS = 4096;
+constexpr size_t TICK_ARCHIVE_STREAM_PADDING = 8;  // zero bytes after each stream, so reads never run off the end
+
+constexpr uint32_t BLOCK_VOLUME_VARINT = 1u << 8;   // bit c < 7: column c repeats price and has no stream
+
+struct TickArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t block_records;
+    char symbol[TICK_STORE_SYMBOL_SIZE];
+    uint64_t record_count;
+    uint64_t block_count;
+    uint64_t index_offset;
+    uint64_t reserved;
+};
+
+static_assert(sizeof(TickArchiveHeader) == 64, "Tick archive header is 64 bytes");
+
+struct TickArchiveBlock {
+    uint64_t offset;        // from the start of the file
+    uint64_t size;          // encoded bytes
+    uint64_t first_record;
+    uint32_t count;
+    uint32_t flags;
+    uint64_t min_timestamp;
+    uint64_t max_timestamp;
+    double min_price;
+    double max_price;
+};
+
+// Precedes each block's column streams
+struct TickArchiveBlockHeader {
+    uint32_t count;
+    uint32_t flags;
+    uint32_t column_size[TICK_STORE_COLUMN_COUNT];  // bytes, padding included; 0 for omitted columns
+};
+
+// Records [first, last) of range, relative to its start
+inline TickRange tick_subrange(const TickRange& range, size_t first, size_t last) {
+    TickRange r;
+    r.first = range.first + first;
+    r.last = range.first + last;
+    r.timestamp = {range.timestamp.data + first, last - first};
+    r.open = {range.open.data + first, last - first};
+    r.high = {range.high.data + first, last - first};
+    r.low = {range.low.data + first, last - first};
+    r.close = {range.close.data + first, last - first};
+    r.volume = {range.volume.data + first, last - first};
+    r.price = {range.price.data + first, last - first};
+    return r;
+}
+
+inline TickRecord tick_record_at(const TickRange& range, size_t i) {
+    TickRecord record;
+    record.timestamp = range.timestamp[i];
+    record.open = range.open[i];
+    record.high = range.high[i];
+    record.low = range.low[i];
+    record.close = range.close[i];
+    record.volume = range.volume[i];
+    record.price = range.price[i];
+    return record;
+}
+
+// Owned columns, the decoded form of an archive range
+struct TickColumns {
+    std::vector<uint64_t> timestamp;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+    std::vector<double> price;
+
+    size_t size() const { return timestamp.size(); }
+    bool empty() const { return timestamp.empty(); }
+
+    void reserve(size_t n) {
+        timestamp.reserve(n);
+        open.reserve(n);
+        high.reserve(n);
+        low.reserve(n);
+        close.reserve(n);
+        volume.reserve(n);
+        price.reserve(n);
+    }
+
+    void resize(size_t n) {
+        timestamp.resize(n);
+        open.resize(n);
+        high.resize(n);
+        low.resize(n);
+        close.resize(n);
+        volume.resize(n);
+        price.resize(n);
+    }
+
+    // Keeps records [first, last)
+    void trim(size_t first, size_t last) {
+        auto keep = [&](auto& column) {
+            column.erase(column.begin() + static_cast<std::ptrdiff_t>(last), column.end());
+            column.erase(column.begin(), column.begin() + static_cast<std::ptrdiff_t>(first));
+        };
+        keep(timestamp);
+        keep(open);
+        keep(high);
+        keep(low);
+        keep(close);
+        keep(volume);
+        keep(price);
+    }
+
+    // Zero-copy spans over records [first, last), the same view a TickStoreReader hands out
+    TickRange range(size_t first, size_t last) const {
+        TickRange all;
+        all.timestamp = {timestamp.data(), size()};
+        all.open = {open.data(), size()};
+        all.high = {high.data(), size()};
+        all.low = {low.data(), size()};
+        all.close = {close.data(), size()};
+        all.volume = {volume.data(), size()};
+        all.price = {price.data(), size()};
+        return tick_subrange(all, first, last);
+    }
+
+    TickRange range() const { return range(0, size()); }
+};
+
+namespace archive_detail {
+
+inline uint64_t double_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double bits_double(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline uint64_t load_be64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return __builtin_bswap64(value);
+}
+
+// MSB-first bit stream appended to a byte vector
+class BitWriter {
+private:
+    std::vector<uint8_t>& out_;
+    uint64_t buffer_ = 0;
+    unsigned used_ = 0;
+
+    void emit(uint64_t word) {
+        const uint64_t big = __builtin_bswap64(word);
+        const size_t at = out_.size();
+        out_.resize(at + sizeof(big));
+        std::memcpy(out_.data() + at, &big, sizeof(big));
+    }
+
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    // Low `bits` bits of value, 0 to 64
+    void write(uint64_t value, unsigned bits) {
+        if (bits == 0) {
+            return;
+        }
+        if (bits < 64) {
+            value &= (1ull << bits) - 1;
+        }
+        const unsigned space = 64 - used_;
+        if (bits < space) {
+            buffer_ = (buffer_ << bits) | value;
+            used_ += bits;
+            return;
+        }
+        const unsigned rest = bits - space;
+        emit(space == 64 ? value : (buffer_ << space) | (value >> rest));
+        buffer_ = rest ? value & ((1ull << rest) - 1) : 0;
+        used_ = rest;
+    }
+
+    // Flushes the partial word and appends the stream padding
+    void finish() {
+        if (used_ > 0) {
+            const uint64_t big = __builtin_bswap64(buffer_ << (64 - used_));
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&big);
+            out_.insert(out_.end(), bytes, bytes + (used_ + 7) / 8);
+        }
+        out_.insert(out_.end(), TICK_ARCHIVE_STREAM_PADDING, 0);
+        buffer_ = 0;
+        used_ = 0;
+    }
+};
+
+[[noreturn]] inline void corrupt_stream() {
+    throw std::runtime_error("Tick archive block is corrupt");
+}
+
+// Reads a stream of `size` bytes, padding included; a read that would
+// run past it throws, so a corrupt stream can't leave its block
+class BitReader {
+private:
+    const uint8_t* data_;
+    size_t size_;
+    uint64_t position_ = 0;  // in bits
+
+public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    // Next `bits` bits without consuming them, up to 56
+    uint64_t peek(unsigned bits) const {
+        if (__builtin_expect((position_ >> 3) + sizeof(uint64_t) > size_, 0)) {
+            corrupt_stream();
+        }
+        const uint64_t window = load_be64(data_ + (position_ >> 3)) << (position_ & 7);
+        return window >> (64 - bits);
+    }
+
+    void skip(unsigned bits) { position_ += bits; }
+
+    uint64_t read(unsigned bits) {
+        if (bits == 0) {
+            return 0;
+        }
+        if (bits > 56) {
+            const uint64_t high = read(bits - 32);
+            return (high << 32) | read(32);
+        }
+        const uint64_t value = peek(bits);
+        position_ += bits;
+        return value;
+    }
+
+    uint64_t bytes_read() const { return (position_ + 7) / 8; }
+};
+
+// Timestamps: the first raw, then the change in delta per record. Regular
+// ticks cost one bit; the buckets fit jitter of up to ±128 ns, ±32 us and
+// ±1 s, anything else takes the full 64 bits.
+inline void encode_timestamps(const uint64_t* values, size_t n, std::vector<uint8_t>& out) {
+    BitWriter writer(out);
+    uint64_t previous = 0;
+    uint64_t previous_delta = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0) {
+            writer.write(values[0], 64);
+            previous = values[0];
+            continue;
+        }
+        const uint64_t delta = values[i] - previous;
+        const uint64_t z = zigzag(static_cast<int64_t>(delta - previous_delta));
+        if (z == 0) {
+            writer.write(0b0, 1);
+        } else if (z < (1ull << 8)) {
+            writer.write(0b10, 2);
+            writer.write(z, 8);
+        } else if (z < (1ull << 16)) {
+            writer.write(0b110, 3);
+            writer.write(z, 16);
+        } else if (z < (1ull << 32)) {
+            writer.write(0b1110, 4);
+            writer.write(z, 32);
+        } else {
+            writer.write(0b1111, 4);
+            writer.write(z, 64);
+        }
+        previous = values[i];
+        previous_delta = delta;
+    }
+    writer.finish();
+}
+
+inline size_t decode_timestamps(const uint8_t* data, size_t size, size_t n, uint64_t* out) {
+    BitReader reader(data, size);
+    uint64_t previous = 0;
+    uint64_t previous_delta = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0) {
+            previous = reader.read(64);
+            out[0] = previous;
+            continue;
+        }
+        const uint64_t prefix = reader.peek(4);
+        uint64_t z;
+        if (prefix < 0b1000) {
+            reader.skip(1);
+            z = 0;
+        } else if (prefix < 0b1100) {
+            reader.skip(2);
+            z = reader.read(8);
+        } else if (prefix < 0b1110) {
+            reader.skip(3);
+            z = reader.read(16);
+        } else {
+            reader.skip(4);
+            z = reader.read(prefix == 0b1110 ? 32 : 64);
+        }
+        previous_delta += static_cast<uint64_t>(unzigzag(z));
+        previous += previous_delta;
+        out[i] = previous;
+    }
+    return reader.bytes_read();
+}
+
+// Gorilla XOR: '0' repeats the previous value, '10' + bits reuses the
+// previous leading/trailing zero window, '11' + 5-bit leading zeros +
+// 6-bit length + bits opens a new window
+inline void encode_doubles(const double* values, size_t n, std::vector<uint8_t>& out) {
+    BitWriter writer(out);
+    uint64_t previous = 0;
+    unsigned window_leading = 65;  // no window yet
+    unsigned window_trailing = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t bits = double_bits(values[i]);
+        if (i == 0) {
+            writer.write(bits, 64);
+            previous = bits;
+            continue;
+        }
+        const uint64_t x = bits ^ previous;
+        previous = bits;
+        if (x == 0) {
+            writer.write(0b0, 1);
+            continue;
+        }
+        const unsigned leading = std::min(31u, static_cast<unsigned>(__builtin_clzll(x)));
+        const unsigned trailing = static_cast<unsigned>(__builtin_ctzll(x));
+        if (window_leading <= 64 && leading >= window_leading && trailing >= window_trailing) {
+            writer.write(0b10, 2);
+            writer.write(x >> window_trailing, 64 - window_leading - window_trailing);
+            continue;
+        }
+        const unsigned meaningful = 64 - leading - trailing;
+        writer.write(0b11, 2);
+        writer.write(leading, 5);
+        writer.write(meaningful - 1, 6);
+        writer.write(x >> trailing, meaningful);
+        window_leading = leading;
+        window_trailing = trailing;
+    }
+    writer.finish();
+}
+
+inline size_t decode_doubles(const uint8_t* data, size_t size, size_t n, double* out) {
+    BitReader reader(data, size);
+    uint64_t previous = 0;
+    unsigned window_leading = 0;
+    unsigned window_trailing = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0) {
+            previous = reader.read(64);
+            out[0] = bits_double(previous);
+            continue;
+        }
+        const uint64_t control = reader.peek(2);
+        if (control < 0b10) {
+            reader.skip(1);
+        } else if (control == 0b10) {
+            reader.skip(2);
+            previous ^= reader.read(64 - window_leading - window_trailing) << window_trailing;
+        } else {
+            reader.skip(2);
+            window_leading = static_cast<unsigned>(reader.read(5));
+            const unsigned meaningful = static_cast<unsigned>(reader.read(6)) + 1;
+            if (window_leading + meaningful > 64) {
+                corrupt_stream();
+            }
+            window_trailing = 64 - window_leading - meaningful;
+            previous ^= reader.read(meaningful) << window_trailing;
+        }
+        out[i] = bits_double(previous);
+    }
+    return reader.bytes_read();
+}
+
+inline bool whole_volumes(const double* values, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (!(values[i] >= 0.0 && values[i] < 9007199254740992.0 && values[i] == std::floor(values[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void encode_varints(const double* values, size_t n, std::vector<uint8_t>& out) {
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t value = static_cast<uint64_t>(values[i]);
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+    out.insert(out.end(), TICK_ARCHIVE_STREAM_PADDING, 0);
+}
+
+inline size_t decode_varints(const uint8_t* data, size_t size, size_t n, double* out) {
+    const uint8_t* p = data;
+    const uint8_t* const end = data + size;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        for (;;) {
+            if (p == end || shift > 63) {
+                corrupt_stream();
+            }
+            const uint8_t byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+            shift += 7;
+        }
+        out[i] = static_cast<double>(value);
+    }
+    return static_cast<size_t>(p - data);
+}
+
+inline bool same_column(const ColumnSpan<double>& a, const ColumnSpan<double>& b) {
+    return std::memcmp(a.data, b.data, a.size * sizeof(double)) == 0;
+}
+
+}  // namespace archive_detail
+
+// Encodes one block of records and fills in everything but its offset
+inline TickArchiveBlock encode_tick_block(const TickRange& range, std::vector<uint8_t>& out) {
+    using namespace archive_detail;
+    const size_t n = range.size();
+    if (n == 0 || n > UINT32_MAX) {
+        throw std::invalid_argument("Tick archive blocks hold 1 to 2^32-1 records");
+    }
+
+    TickArchiveBlock block{};
+    block.first_record = range.first;
+    block.count = static_cast<uint32_t>(n);
+    block.min_timestamp = range.timestamp[0];
+    block.max_timestamp = range.timestamp[n - 1];
+    const auto [min_price, max_price] = std::minmax_element(range.price.begin(), range.price.end());
+    block.min_price = *min_price;
+    block.max_price = *max_price;
+
+    const ColumnSpan<double>* doubles[TICK_STORE_COLUMN_COUNT] = {
+        nullptr, &range.open, &range.high, &range.low, &range.close, &range.volume, &range.price};
+    for (size_t c = COLUMN_OPEN; c <= COLUMN_CLOSE; ++c) {
+        if (same_column(*doubles[c], range.price)) {
+            block.flags |= 1u << c;
+        }
+    }
+    if (whole_volumes(range.volume.data, n)) {
+        block.flags |= BLOCK_VOLUME_VARINT;
+    }
+
+    const size_t start = out.size();
+    out.resize(start + sizeof(TickArchiveBlockHeader));
+    TickArchiveBlockHeader header{};
+    header.count = block.count;
+    header.flags = block.flags;
+    for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+        const size_t column_start = out.size();
+        if (c == COLUMN_TIMESTAMP) {
+            encode_timestamps(range.timestamp.data, n, out);
+        } else if (block.flags & (1u << c)) {
+            continue;
+        } else if (c == COLUMN_VOLUME && (block.flags & BLOCK_VOLUME_VARINT)) {
+            encode_varints(range.volume.data, n, out);
+        } else {
+            encode_doubles(doubles[c]->data, n, out);
+        }
+        header.column_size[c] = static_cast<uint32_t>(out.size() - column_start);
+    }
+    std::memcpy(out.data() + start, &header, sizeof(header));
+    block.size = out.size() - start;
+    return block;
+}
+
+// Decodes one encoded block into out[at, at + count)
+inline void decode_tick_block(const uint8_t* data, size_t size, TickColumns& out, size_t at) {
+    using namespace archive_detail;
+    TickArchiveBlockHeader header;
+    if (size < sizeof(header)) {
+        throw std::runtime_error("Tick archive block is truncated");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    size_t total = sizeof(header);
+    for (const uint32_t column_size : header.column_size) {
+        total += column_size;
+    }
+    if (total != size || at + header.count > out.size() || header.count == 0) {
+        throw std::runtime_error("Tick archive block is corrupt");
+    }
+
+    const size_t n = header.count;
+    double* doubles[TICK_STORE_COLUMN_COUNT] = {
+        nullptr, &out.open[at], &out.high[at], &out.low[at], &out.close[at], &out.volume[at], &out.price[at]};
+    const uint8_t* column = data + sizeof(header);
+    for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+        if (c != COLUMN_TIMESTAMP && (header.flags & (1u << c))) {
+            continue;
+        }
+        // Each decoder stops at its stream's end; the padding must be left over
+        const size_t size = header.column_size[c];
+        size_t used;
+        if (c == COLUMN_TIMESTAMP) {
+            used = decode_timestamps(column, size, n, &out.timestamp[at]);
+        } else if (c == COLUMN_VOLUME && (header.flags & BLOCK_VOLUME_VARINT)) {
+            used = decode_varints(column, size, n, doubles[c]);
+        } else {
+            used = decode_doubles(column, size, n, doubles[c]);
+        }
+        if (used + TICK_ARCHIVE_STREAM_PADDING > size) {
+            corrupt_stream();
+        }
+        column += header.column_size[c];
+    }
+    for (size_t c = COLUMN_OPEN; c <= COLUMN_CLOSE; ++c) {
+        if (header.flags & (1u << c)) {
+            std::memcpy(doubles[c], doubles[COLUMN_PRICE], n * sizeof(double));
+        }
+    }
+}
+
+// Appends records in timestamp order and writes the index and header on finish()
+class TickArchiveWriter {
+private:
+    std::string path_;
+    int fd_;
+    TickArchiveHeader header_;
+    std::vector<TickArchiveBlock> index_;
+    TickColumns pending_;
+    std::vector<uint8_t> encoded_;
+    uint64_t offset_;
+    uint64_t last_timestamp_;
+    bool finished_;
+
+    void write_all(const void* data, size_t size, uint64_t offset) {
+        const char* in = static_cast<const char*>(data);
+        while (size > 0) {
+            const ssize_t n = pwrite(fd_, in, size, static_cast<off_t>(offset));
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("Failed to write tick archive " + path_ + ": " + strerror(errno));
+            }
+            in += n;
+            size -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+        }
+    }
+
+    void check_order(uint64_t first, uint64_t last) {
+        if (first < last_timestamp_) {
+            throw std::runtime_error("Tick archive records must be appended in timestamp order: " + path_);
+        }
+        last_timestamp_ = last;
+    }
+
+    void flush_pending() {
+        if (pending_.empty()) {
+            return;
+        }
+        encoded_.clear();
+        write_block(encode_tick_block(pending_.range(), encoded_), encoded_);  // ordered as appended
+        pending_.resize(0);
+    }
+
+    void write_block(TickArchiveBlock block, const std::vector<uint8_t>& bytes) {
+        if (finished_) {
+            throw std::runtime_error("Tick archive is already finished: " + path_);
+        }
+        block.offset = offset_;
+        block.first_record = header_.record_count;
+        write_all(bytes.data(), bytes.size(), offset_);
+        offset_ += bytes.size();
+        header_.record_count += block.count;
+        index_.push_back(block);
+    }
+
+public:
+    TickArchiveWriter(const std::string& path, const char* symbol,
+                      uint32_t block_records = TICK_ARCHIVE_BLOCK_RECORDS)
+        : path_(path), fd_(-1), header_{}, offset_(sizeof(TickArchiveHeader)), last_timestamp_(0), finished_(false) {
+        if (block_records == 0) {
+            throw std::invalid_argument("Tick archive block size must be positive");
+        }
+        fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ == -1) {
+            throw std::runtime_error("Failed to create tick archive " + path + ": " + strerror(errno));
+        }
+        header_.version = TICK_ARCHIVE_VERSION;
+        header_.block_records = block_records;
+        std::strncpy(header_.symbol, symbol, TICK_STORE_SYMBOL_SIZE - 1);
+        pending_.reserve(block_records);
+        // Zeroed until finish(), so a crashed conversion never looks valid
+        const TickArchiveHeader blank{};
+        write_all(&blank, sizeof(blank), 0);
+    }
+
+    ~TickArchiveWriter() {
+        if (fd_ != -1) {
+            close(fd_);
+        }
+    }
+
+    TickArchiveWriter(const TickArchiveWriter&) = delete;
+    TickArchiveWriter& operator=(const TickArchiveWriter&) = delete;
+
+    void append(const TickRecord& record) {
+        check_order(record.timestamp, record.timestamp);
+        const size_t n = pending_.size();
+        pending_.resize(n + 1);
+        pending_.timestamp[n] = record.timestamp;
+        pending_.open[n] = record.open;
+        pending_.high[n] = record.high;
+        pending_.low[n] = record.low;
+        pending_.close[n] = record.close;
+        pending_.volume[n] = record.volume;
+        pending_.price[n] = record.price;
+        if (pending_.size() == header_.block_records) {
+            flush_pending();
+        }
+    }
+
+    // Whole blocks are encoded straight from the spans
+    void append(const TickRange& range) {
+        size_t i = 0;
+        while (i < range.size() && !pending_.empty()) {
+            append(tick_record_at(range, i++));
+        }
+        for (; i + header_.block_records <= range.size(); i += header_.block_records) {
+            const TickRange block_range = tick_subrange(range, i, i + header_.block_records);
+            encoded_.clear();
+            append_encoded(encode_tick_block(block_range, encoded_), encoded_);
+        }
+        for (; i < range.size(); ++i) {
+            append(tick_record_at(range, i));
+        }
+    }
+
+    // A block encoded elsewhere (see compress_tick_range), appended in order
+    void append_encoded(const TickArchiveBlock& block, const std::vector<uint8_t>& bytes) {
+        if (!pending_.empty()) {
+            throw std::logic_error("Encoded blocks can only follow whole blocks: " + path_);
+        }
+        check_order(block.min_timestamp, block.max_timestamp);
+        write_block(block, bytes);
+    }
+
+    // Writes the last partial block, the index and then the header
+    void finish(bool sync = false) {
+        if (finished_) {
+            return;
+        }
+        flush_pending();
+        // The index is read in place, so it starts 8-byte aligned
+        const uint64_t padding = (8 - offset_ % 8) % 8;
+        const uint64_t zeros = 0;
+        write_all(&zeros, padding, offset_);
+        offset_ += padding;
+        header_.block_count = index_.size();
+        header_.index_offset = offset_;
+        write_all(index_.data(), index_.size() * sizeof(TickArchiveBlock), offset_);
+        offset_ += index_.size() * sizeof(TickArchiveBlock);
+        if (sync && fdatasync(fd_) == -1) {
+            throw std::runtime_error("Failed to sync tick archive " + path_ + ": " + strerror(errno));
+        }
+        std::memcpy(header_.magic, TICK_ARCHIVE_MAGIC, sizeof(TICK_ARCHIVE_MAGIC));
+        write_all(&header_, sizeof(header_), 0);
+        if (sync && fdatasync(fd_) == -1) {
+            throw std::runtime_error("Failed to sync tick archive " + path_ + ": " + strerror(errno));
+        }
+        finished_ = true;
+    }
+
+    uint64_t size() const { return header_.record_count + pending_.size(); }
+    size_t pending() const { return pending_.size(); }  // records waiting for a full block
+    uint64_t bytes() const { return offset_; }
+    uint32_t block_records() const { return header_.block_records; }
+    const std::string& path() const { return path_; }
+};
+
+// Encodes range with `threads` workers, a batch of blocks at a time, and
+// appends the blocks to writer in order
+inline void compress_tick_range(TickRange range, TickArchiveWriter& writer, unsigned threads) {
+    // Complete the writer's partial block first, so encoded blocks line up behind it
+    size_t head = 0;
+    while (writer.pending() > 0 && head < range.size()) {
+        writer.append(tick_record_at(range, head++));
+    }
+    range = tick_subrange(range, head, range.size());
+
+    const size_t block_records = writer.block_records();
+    const size_t blocks = range.size() / block_records;
+    threads = std::max(1u, threads);
+    if (threads == 1 || blocks < 2) {
+        writer.append(range);
+        return;
+    }
+
+    const size_t batch = threads * 4;
+    std::vector<std::vector<uint8_t>> encoded(batch);
+    std::vector<TickArchiveBlock> stats(batch);
+    for (size_t first = 0; first < blocks; first += batch) {
+        const size_t count = std::min(batch, blocks - first);
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::min<size_t>(threads, count); ++t) {
+            workers.emplace_back([&] {
+                for (size_t b = next.fetch_add(1); b < count; b = next.fetch_add(1)) {
+                    const size_t begin = (first + b) * block_records;
+                    encoded[b].clear();
+                    stats[b] = encode_tick_block(tick_subrange(range, begin, begin + block_records),
+                                                 encoded[b]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (size_t b = 0; b < count; ++b) {
+            writer.append_encoded(stats[b], encoded[b]);
+        }
+    }
+    writer.append(tick_subrange(range, blocks * block_records, range.size()));
+}
+
+// Maps an archive read-only; queries pick blocks through the index
+class TickArchiveReader {
+private:
+    std::string path_;
+    const uint8_t* memory_;
+    size_t mapped_size_;
+    const TickArchiveHeader* header_;
+    const TickArchiveBlock* index_;
+
+public:
+    explicit TickArchiveReader(const std::string& path)
+        : path_(path), memory_(nullptr), mapped_size_(0), header_(nullptr), index_(nullptr) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Failed to open tick archive " + path + ": " + strerror(errno));
+        }
+        struct stat st{};
+        if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < sizeof(TickArchiveHeader)) {
+            close(fd);
+            throw std::runtime_error("Tick archive is truncated: " + path);
+        }
+        void* memory = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error("Failed to map tick archive " + path + ": " + strerror(errno));
+        }
+        memory_ = static_cast<const uint8_t*>(memory);
+        mapped_size_ = static_cast<size_t>(st.st_size);
+        header_ = reinterpret_cast<const TickArchiveHeader*>(memory_);
+
+        if (std::memcmp(header_->magic, TICK_ARCHIVE_MAGIC, sizeof(TICK_ARCHIVE_MAGIC)) != 0) {
+            munmap(memory, mapped_size_);
+            throw std::runtime_error("Not a finished tick archive: " + path);
+        }
+        // Compared by division: index_offset + block_count * size could wrap
+        if (header_->version != TICK_ARCHIVE_VERSION || header_->index_offset % alignof(TickArchiveBlock) != 0 ||
+            header_->index_offset < sizeof(TickArchiveHeader) || header_->index_offset > mapped_size_ ||
+            header_->block_count > (mapped_size_ - header_->index_offset) / sizeof(TickArchiveBlock)) {
+            munmap(memory, mapped_size_);
+            throw std::runtime_error("Unsupported or truncated tick archive: " + path);
+        }
+        index_ = reinterpret_cast<const TickArchiveBlock*>(memory_ + header_->index_offset);
+        for (size_t b = 0; b < header_->block_count; ++b) {
+            if (index_[b].offset < sizeof(TickArchiveHeader) || index_[b].offset > header_->index_offset ||
+                index_[b].size > header_->index_offset - index_[b].offset) {
+                munmap(memory, mapped_size_);
+                throw std::runtime_error("Tick archive index is corrupt: " + path);
+            }
+        }
+    }
+
+    ~TickArchiveReader() {
+        if (memory_) {
+            munmap(const_cast<uint8_t*>(memory_), mapped_size_);
+        }
+    }
+
+    TickArchiveReader(const TickArchiveReader&) = delete;
+    TickArchiveReader& operator=(const TickArchiveReader&) = delete;
+
+    uint64_t size() const { return header_->record_count; }
+    size_t block_count() const { return header_->block_count; }
+    const TickArchiveBlock& block(size_t b) const { return index_[b]; }
+    const char* symbol() const { return header_->symbol; }
+    const std::string& path() const { return path_; }
+    size_t file_size() const { return mapped_size_; }
+
+    // Blocks [first, last) that may hold records with begin_ns <= timestamp < end_ns
+    std::pair<size_t, size_t> blocks_in_time(uint64_t begin_ns, uint64_t end_ns) const {
+        const TickArchiveBlock* end = index_ + block_count();
+        const TickArchiveBlock* first = std::lower_bound(index_, end, begin_ns,
+            [](const TickArchiveBlock& block, uint64_t t) { return block.max_timestamp < t; });
+        const TickArchiveBlock* last = std::lower_bound(first, end, end_ns,
+            [](const TickArchiveBlock& block, uint64_t t) { return block.min_timestamp < t; });
+        return {static_cast<size_t>(first - index_), static_cast<size_t>(last - index_)};
+    }
+
+    // Blocks whose price range touches [low, high], from the index alone
+    std::vector<size_t> blocks_with_price(double low, double high) const {
+        std::vector<size_t> blocks;
+        for (size_t b = 0; b < block_count(); ++b) {
+            if (index_[b].max_price >= low && index_[b].min_price <= high) {
+                blocks.push_back(b);
+            }
+        }
+        return blocks;
+    }
+
+    // Decodes block b to out[at, at + count)
+    void decode_block(size_t b, TickColumns& out, size_t at) const {
+        decode_tick_block(memory_ + index_[b].offset, index_[b].size, out, at);
+    }
+
+    // Blocks [first, last), spread over `threads` workers
+    TickColumns decode(size_t first, size_t last, unsigned threads = 1) const {
+        TickColumns out;
+        decode(first, last, out, threads);
+        return out;
+    }
+
+    // Same, into out, reusing its capacity
+    void decode(size_t first, size_t last, TickColumns& out, unsigned threads = 1) const {
+        last = std::min(last, block_count());
+        if (first >= last) {
+            out.resize(0);
+            return;
+        }
+        const uint64_t base = index_[first].first_record;
+        out.resize(index_[last - 1].first_record + index_[last - 1].count - base);
+
+        const size_t blocks = last - first;
+        threads = static_cast<unsigned>(std::min<size_t>(std::max(1u, threads), blocks));
+        if (threads == 1) {
+            for (size_t b = first; b < last; ++b) {
+                decode_block(b, out, index_[b].first_record - base);
+            }
+            return;
+        }
+        std::atomic<size_t> next{first};
+        std::vector<std::thread> workers;
+        std::vector<std::string> errors(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                try {
+                    for (size_t b = next.fetch_add(1); b < last; b = next.fetch_add(1)) {
+                        decode_block(b, out, index_[b].first_record - base);
+                    }
+                } catch (const std::exception& e) {
+                    errors[t] = e.what();
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& error : errors) {
+            if (!error.empty()) {
+                throw std::runtime_error(error + ": " + path_);
+            }
+        }
+    }
+
+    TickColumns decode_all(unsigned threads = 1) const { return decode(0, block_count(), threads); }
+
+    // Records with begin_ns <= timestamp < end_ns; only overlapping blocks are decoded
+    TickColumns time_range(uint64_t begin_ns, uint64_t end_ns, unsigned threads = 1) const {
+        const auto [first, last] = blocks_in_time(begin_ns, end_ns);
+        TickColumns out = decode(first, last, threads);
+        const auto from = std::lower_bound(out.timestamp.begin(), out.timestamp.end(), begin_ns);
+        const auto to = std::lower_bound(from, out.timestamp.end(), end_ns);
+        out.trim(static_cast<size_t>(from - out.timestamp.begin()), static_cast<size_t>(to - out.timestamp.begin()));
+        return out;
+    }
+};
+
+// <symbol>.ticks -> <symbol>.tka
+inline std::string tick_archive_path(const std::string& store_path) {
+    const auto dot = store_path.rfind(".ticks");
+    return (dot == std::string::npos ? store_path : store_path.substr(0, dot)) + ".tka";
+}
+
+#endif // TICK_ARCHIVE_H
@@ -0,0 +1,526 @@
+#ifndef TICK_PERSISTER_H
+#define TICK_PERSISTER_H
+
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "latency.h"
+#include "market_data_table.h"
+#include "tick_store.h"
+#include "trading_system.h"
+
+// Background persistence of the live tick stream into the binary tick
+// store, one <dir>/<symbol>.ticks per symbol, off the producer thread.
+//
+// A drain thread copies ticks into per-symbol column buffers that are
+// page-aligned and laid out like the file's columns. Once per durability
+// window it swaps every touched symbol's buffer for its spare and hands
+// the whole batch to a writer thread (double buffering), which writes
+// each column with O_DIRECT, syncs the files once, then writes the new
+// record counts into the headers and syncs again: a group commit, so a
+// crash loses at most the last window and never exposes a count whose
+// records are not on disk. Direct I/O moves whole pages, so the partially
+// filled last page of each column is carried over into the next buffer
+// and rewritten by the following commit.
+
+constexpr uint64_t PERSIST_PAGE_RECORDS = 4096 / sizeof(uint64_t);
+constexpr uint64_t PERSIST_MAX_BUFFER_RECORDS = 16384;  // per symbol, before a full buffer forces a commit
+constexpr size_t PERSIST_SYNCFS_THRESHOLD = 16;          // dirty files per commit above which one syncfs() wins
+
+inline uint64_t persist_page_floor(uint64_t records) {
+    return records / PERSIST_PAGE_RECORDS * PERSIST_PAGE_RECORDS;
+}
+
+inline uint64_t persist_page_ceil(uint64_t records) {
+    return persist_page_floor(records + PERSIST_PAGE_RECORDS - 1);
+}
+
+struct PersistOptions {
+    std::string dir;                         // empty = persistence off
+    std::chrono::milliseconds window{100};    // longest a received tick waits for its commit
+    bool direct = true;                       // O_DIRECT, or buffered writes through the page cache
+
+    bool enabled() const { return !dir.empty(); }
+
+    // "direct" or "buffered"
+    void set_mode(const std::string& mode) {
+        if (mode != "direct" && mode != "buffered") {
+            throw std::runtime_error("Invalid persist mode: " + mode + " (use direct or buffered)");
+        }
+        direct = mode == "direct";
+    }
+};
+
+struct PersistStats {
+    std::atomic<uint64_t> ticks{0};            // records durable in the stores
+    std::atomic<uint64_t> commits{0};
+    std::atomic<uint64_t> bytes{0};            // column and header bytes written
+    std::atomic<uint64_t> errors{0};           // failed commits or store opens
+    std::atomic<uint64_t> last_commit_ns{0};   // write plus both syncs
+    std::atomic<uint64_t> max_commit_ns{0};
+    std::atomic<uint64_t> source_lag{0};       // ticks published but not yet drained, as of the last poll
+    std::atomic<uint64_t> source_dropped{0};   // ticks the source ring overwrote before the drain got them
+};
+
+// Records [base, base + size) of one symbol, column by column. base is a
+// multiple of a page worth of records so every column writes page-aligned.
+class PersistBuffer {
+private:
+    uint64_t* columns_ = nullptr;
+    uint64_t capacity_ = 0;
+    uint64_t base_ = 0;
+    uint64_t size_ = 0;
+
+    static uint64_t* allocate(uint64_t capacity) {
+        void* memory = std::aligned_alloc(4096, TICK_STORE_COLUMN_COUNT * capacity * sizeof(uint64_t));
+        if (!memory) {
+            throw std::runtime_error("Failed to allocate persist buffer");
+        }
+        return static_cast<uint64_t*>(memory);
+    }
+
+public:
+    PersistBuffer() = default;
+    ~PersistBuffer() { std::free(columns_); }
+
+    PersistBuffer(const PersistBuffer&) = delete;
+    PersistBuffer& operator=(const PersistBuffer&) = delete;
+
+    // Capacity is kept a multiple of a page of records so columns stay aligned
+    void reserve(uint64_t records) {
+        records = persist_page_ceil(std::max<uint64_t>(records, 1));
+        if (records <= capacity_) {
+            return;
+        }
+        uint64_t* grown = allocate(records);
+        for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT && columns_; ++c) {
+            std::memcpy(grown + c * records, columns_ + c * capacity_, size_ * sizeof(uint64_t));
+        }
+        std::free(columns_);
+        columns_ = grown;
+        capacity_ = records;
+    }
+
+    // Starts at record `base`, empty
+    void reset(uint64_t base) {
+        base_ = base;
+        size_ = 0;
+    }
+
+    // Continues where `previous` ends, carrying its partially filled last page
+    void continue_from(const PersistBuffer& previous) {
+        const uint64_t end = previous.end();
+        reserve(PERSIST_PAGE_RECORDS);
+        base_ = persist_page_floor(end);
+        size_ = end - base_;
+        const uint64_t offset = base_ - previous.base_;
+        for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+            std::memcpy(column(c), previous.column(c) + offset, size_ * sizeof(uint64_t));
+        }
+    }
+
+    void push(const TradingTick& tick) {
+        const double volume = static_cast<double>(tick.volume);
+        column(COLUMN_TIMESTAMP)[size_] = tick.timestamp;
+        std::memcpy(&column(COLUMN_OPEN)[size_], &tick.price, sizeof(double));
+        std::memcpy(&column(COLUMN_HIGH)[size_], &tick.price, sizeof(double));
+        std::memcpy(&column(COLUMN_LOW)[size_], &tick.price, sizeof(double));
+        std::memcpy(&column(COLUMN_CLOSE)[size_], &tick.price, sizeof(double));
+        std::memcpy(&column(COLUMN_VOLUME)[size_], &volume, sizeof(double));
+        std::memcpy(&column(COLUMN_PRICE)[size_], &tick.price, sizeof(double));
+        ++size_;
+    }
+
+    // Records appended since reset / continue_from
+    void set_size(uint64_t size) { size_ = size; }
+
+    uint64_t* column(size_t c) { return columns_ + c * capacity_; }
+    const uint64_t* column(size_t c) const { return columns_ + c * capacity_; }
+    uint64_t base() const { return base_; }
+    uint64_t size() const { return size_; }
+    uint64_t end() const { return base_ + size_; }
+    uint64_t capacity() const { return capacity_; }
+    bool full() const { return size_ == capacity_; }
+
+    // Bytes per column a commit writes: whole pages covering the records
+    size_t write_bytes() const { return persist_page_ceil(size_) * sizeof(uint64_t); }
+};
+
+// The writer thread's view of one store file
+struct PersistedStore {
+    std::string symbol;
+    std::string path;
+    int fd = -1;
+    bool direct = false;
+    char* header_page = nullptr;      // aligned copy of the header page
+    uint64_t capacity = 0;
+    uint64_t column_offset[TICK_STORE_COLUMN_COUNT] = {};
+    uint64_t durable = 0;             // count in the header on disk
+
+    PersistBuffer buffers[2];
+    int active = 0;                   // buffer the drain thread fills; the other is the writer's
+    bool pending = false;             // active buffer has records since the last commit
+
+    ~PersistedStore() {
+        if (fd != -1) {
+            close(fd);
+        }
+        std::free(header_page);
+    }
+};
+
+class TickPersister {
+private:
+    PersistOptions options_;
+    const MarketData* market_;
+    std::vector<std::unique_ptr<PersistedStore>> stores_;  // by symbol index
+    PersistStats stats_;
+
+    // Drain side
+    std::vector<uint16_t> pending_;
+    uint64_t pending_ticks_ = 0;
+    std::chrono::steady_clock::time_point window_start_;
+
+    // Handoff: the batch belongs to the writer while busy_ is set
+    struct Write {
+        PersistedStore* store;
+        PersistBuffer* buffer;
+    };
+    std::vector<Write> batch_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::atomic<bool> failed_{false};
+    std::atomic<bool> warned_buffered_{false};
+    std::thread writer_;
+
+    static void read_exact(int fd, void* buffer, size_t size, uint64_t offset, const std::string& path) {
+        char* out = static_cast<char*>(buffer);
+        while (size > 0) {
+            const ssize_t n = pread(fd, out, size, static_cast<off_t>(offset));
+            if (n <= 0) {
+                if (n == -1 && errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Failed to read tick store " + path + ": " +
+                                         (n == 0 ? "short file" : strerror(errno)));
+            }
+            out += n;
+            size -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+        }
+    }
+
+    void write_exact(PersistedStore& store, const void* buffer, size_t size, uint64_t offset) {
+        const char* in = static_cast<const char*>(buffer);
+        while (size > 0) {
+            const ssize_t n = pwrite(store.fd, in, size, static_cast<off_t>(offset));
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n == -1 && errno == EINVAL && store.direct) {
+                // Some filesystems accept O_DIRECT at open and reject it on write
+                fcntl(store.fd, F_SETFL, fcntl(store.fd, F_GETFL) & ~O_DIRECT);
+                store.direct = false;
+                warn_buffered(store.path);
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("Failed to write tick store " + store.path + ": " + strerror(errno));
+            }
+            in += n;
+            size -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+            stats_.bytes.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+        }
+    }
+
+    void warn_buffered(const std::string& path) {
+        if (!warned_buffered_.exchange(true)) {
+            std::cout << "Persister: O_DIRECT not supported for " << path << ", using buffered writes" << std::endl;
+        }
+    }
+
+    // (Re)opens the file and loads capacity, column offsets and the durable count
+    void open_store(PersistedStore& store) {
+        if (store.fd != -1) {
+            close(store.fd);
+            store.fd = -1;
+        }
+        store.direct = options_.direct;
+        if (store.direct) {
+            store.fd = open(store.path.c_str(), O_RDWR | O_DIRECT);
+            if (store.fd == -1 && errno == EINVAL) {
+                store.direct = false;
+                warn_buffered(store.path);
+            }
+        }
+        if (store.fd == -1) {
+            store.fd = open(store.path.c_str(), O_RDWR);
+        }
+        if (store.fd == -1) {
+            throw std::runtime_error("Failed to open tick store " + store.path + ": " + strerror(errno));
+        }
+        // One writer per file: a second persister on the same directory would interleave pages
+        if (flock(store.fd, LOCK_EX | LOCK_NB) == -1) {
+            throw std::runtime_error("Tick store " + store.path + " is locked by another writer");
+        }
+
+        struct stat st{};
+        if (fstat(store.fd, &st) == -1 || static_cast<size_t>(st.st_size) < TICK_STORE_HEADER_SIZE) {
+            throw std::runtime_error("Tick store is truncated: " + store.path);
+        }
+        read_exact(store.fd, store.header_page, TICK_STORE_HEADER_SIZE, 0, store.path);
+        const auto* header = reinterpret_cast<const TickStoreHeader*>(store.header_page);
+        validate_tick_store_header(header, static_cast<size_t>(st.st_size), store.path);
+        store.capacity = header->capacity;
+        std::memcpy(store.column_offset, header->column_offset, sizeof(store.column_offset));
+        std::memcpy(&store.durable, store.header_page + offsetof(TickStoreHeader, count), sizeof(uint64_t));
+    }
+
+    // First tick of a symbol: create or reopen its file and load the partial last page
+    PersistedStore& store_for(uint16_t index) {
+        std::unique_ptr<PersistedStore>& slot = stores_[index];
+        if (slot) {
+            return *slot;
+        }
+        auto store = std::make_unique<PersistedStore>();
+        store->symbol = market_->symbol_at(index);
+        store->path = options_.dir + "/" + store->symbol + ".ticks";
+        store->header_page = static_cast<char*>(std::aligned_alloc(4096, TICK_STORE_HEADER_SIZE));
+        if (!store->header_page) {
+            throw std::runtime_error("Failed to allocate tick store header page");
+        }
+        {
+            TickStoreWriter create(store->path, store->symbol.c_str());  // no-op when it already exists
+        }
+        open_store(*store);
+
+        PersistBuffer& buffer = store->buffers[0];
+        buffer.reserve(PERSIST_PAGE_RECORDS);
+        buffer.reset(persist_page_floor(store->durable));
+        const uint64_t tail = store->durable - buffer.base();
+        if (tail > 0) {
+            for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+                read_exact(store->fd, buffer.column(c), PERSIST_PAGE_RECORDS * sizeof(uint64_t),
+                           store->column_offset[c] + buffer.base() * sizeof(uint64_t), store->path);
+            }
+            buffer.set_size(tail);
+        }
+        slot = std::move(store);
+        return *slot;
+    }
+
+    // Copy-and-rename growth through TickStoreWriter, then pick up the new file
+    void grow_store(PersistedStore& store, uint64_t records) {
+        close(store.fd);
+        store.fd = -1;
+        {
+            TickStoreWriter writer(store.path, store.symbol.c_str());
+            writer.reserve(records);
+        }
+        open_store(store);
+    }
+
+    void sync_files(const std::vector<Write>& batch) {
+        if (batch.size() > PERSIST_SYNCFS_THRESHOLD) {
+            if (syncfs(batch.front().store->fd) == -1) {
+                throw std::runtime_error(std::string("Failed to sync tick stores: ") + strerror(errno));
+            }
+            return;
+        }
+        for (const Write& write : batch) {
+            if (fdatasync(write.store->fd) == -1) {
+                throw std::runtime_error("Failed to sync tick store " + write.store->path + ": " + strerror(errno));
+            }
+        }
+    }
+
+    void write_batch() {
+        const uint64_t start_ns = monotonic_ns();
+        uint64_t committed = 0;
+
+        for (const Write& write : batch_) {
+            PersistedStore& store = *write.store;
+            const PersistBuffer& buffer = *write.buffer;
+            if (persist_page_ceil(buffer.end()) > store.capacity) {
+                grow_store(store, buffer.end());
+            }
+            for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+                write_exact(store, buffer.column(c), buffer.write_bytes(),
+                            store.column_offset[c] + buffer.base() * sizeof(uint64_t));
+            }
+        }
+        sync_files(batch_);
+
+        // Only now publish the counts, so a header never covers unsynced records
+        for (const Write& write : batch_) {
+            PersistedStore& store = *write.store;
+            const uint64_t count = write.buffer->end();
+            std::memcpy(store.header_page + offsetof(TickStoreHeader, count), &count, sizeof(uint64_t));
+            write_exact(store, store.header_page, TICK_STORE_HEADER_SIZE, 0);
+            committed += count - store.durable;
+            store.durable = count;
+        }
+        sync_files(batch_);
+
+        const uint64_t elapsed = monotonic_ns() - start_ns;
+        stats_.ticks.fetch_add(committed, std::memory_order_relaxed);
+        stats_.commits.fetch_add(1, std::memory_order_relaxed);
+        stats_.last_commit_ns.store(elapsed, std::memory_order_relaxed);
+        if (elapsed > stats_.max_commit_ns.load(std::memory_order_relaxed)) {
+            stats_.max_commit_ns.store(elapsed, std::memory_order_relaxed);
+        }
+    }
+
+    void writer_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this] { return busy_ || stopping_; });
+            if (!busy_) {
+                break;
+            }
+            lock.unlock();
+            try {
+                write_batch();
+            } catch (const std::exception& e) {
+                // The stores stay consistent at their last durable count; stop rather than leave a gap
+                stats_.errors.fetch_add(1, std::memory_order_relaxed);
+                failed_.store(true, std::memory_order_relaxed);
+                std::cerr << "Persister: " << e.what() << ", persistence stopped" << std::endl;
+            }
+            lock.lock();
+            batch_.clear();
+            busy_ = false;
+            cv_.notify_all();
+        }
+    }
+
+    void wait_idle(std::unique_lock<std::mutex>& lock) {
+        cv_.wait(lock, [this] { return !busy_; });
+    }
+
+public:
+    TickPersister(const PersistOptions& options, const MarketData* market)
+        : options_(options), market_(market), stores_(MARKET_TABLE_CAPACITY) {
+        std::filesystem::create_directories(options_.dir);
+        pending_.reserve(MARKET_TABLE_CAPACITY);
+        batch_.reserve(MARKET_TABLE_CAPACITY);
+        writer_ = std::thread(&TickPersister::writer_loop, this);
+    }
+
+    ~TickPersister() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        writer_.join();
+    }
+
+    TickPersister(const TickPersister&) = delete;
+    TickPersister& operator=(const TickPersister&) = delete;
+
+    // Drain thread only
+    void append(const TradingTick& tick) {
+        if (!tick.valid || tick.symbol_index >= stores_.size() || failed()) {
+            return;
+        }
+        PersistedStore* opened;
+        try {
+            opened = &store_for(tick.symbol_index);
+        } catch (const std::exception& e) {
+            stats_.errors.fetch_add(1, std::memory_order_relaxed);
+            failed_.store(true, std::memory_order_relaxed);
+            std::cerr << "Persister: " << e.what() << ", persistence stopped" << std::endl;
+            return;
+        }
+        PersistedStore& store = *opened;
+        PersistBuffer* buffer = &store.buffers[store.active];
+        if (buffer->full()) {
+            if (buffer->capacity() < PERSIST_MAX_BUFFER_RECORDS) {
+                buffer->reserve(buffer->capacity() * 2);
+            } else {
+                commit();
+                buffer = &store.buffers[store.active];
+            }
+        }
+        buffer->push(tick);
+
+        if (!store.pending) {
+            store.pending = true;
+            pending_.push_back(tick.symbol_index);
+        }
+        if (pending_ticks_++ == 0) {
+            window_start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    // Time left before the oldest uncommitted tick's window closes
+    std::chrono::nanoseconds until_due(std::chrono::steady_clock::time_point now) const {
+        if (pending_ticks_ == 0) {
+            return options_.window;
+        }
+        return std::max(std::chrono::nanoseconds(0),
+                        std::chrono::nanoseconds(window_start_ + options_.window - now));
+    }
+
+    // Hands every pending buffer to the writer; waits if the previous commit is still in flight
+    void commit() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wait_idle(lock);
+        if (pending_.empty()) {
+            return;
+        }
+        for (const uint16_t index : pending_) {
+            PersistedStore& store = *stores_[index];
+            PersistBuffer& filled = store.buffers[store.active];
+            store.active ^= 1;
+            store.buffers[store.active].continue_from(filled);
+            store.pending = false;
+            batch_.push_back({&store, &filled});
+        }
+        pending_.clear();
+        pending_ticks_ = 0;
+        busy_ = true;
+        cv_.notify_all();
+    }
+
+    // Commits what is pending and waits for it to be durable
+    void flush() {
+        commit();
+        std::unique_lock<std::mutex> lock(mutex_);
+        wait_idle(lock);
+    }
+
+    // Drain thread: where it stands against the ring it reads from
+    void note_source(uint64_t lag, uint64_t dropped) {
+        stats_.source_lag.store(lag, std::memory_order_relaxed);
+        stats_.source_dropped.store(dropped, std::memory_order_relaxed);
+    }
+
+    uint64_t pending() const { return pending_ticks_; }
+    bool failed() const { return failed_.load(std::memory_order_relaxed); }
+    const PersistStats& stats() const { return stats_; }
+    const PersistOptions& options() const { return options_; }
+};
+
+#endif // TICK_PERSISTER_H
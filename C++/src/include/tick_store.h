@@ -0,0 +1,457 @@
+#ifndef TICK_STORE_H
+#define TICK_STORE_H
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// Binary columnar tick store: one file per symbol, laid out so the whole
+// file can be mmapped and each column used in place as a plain array.
+//
+//   [0, 4096)            TickStoreHeader (rest of the page is zero)
+//   column_offset[c]     capacity * 8 bytes of column c
+//
+// Columns: timestamp (uint64 ns since epoch), open, high, low, close,
+// volume, price (double). Capacity is a multiple of 512 records so every
+// column starts on a 4 KiB boundary. When a file fills up the writer
+// copies it into a file of twice the capacity, renames that over the
+// original and flags the old header `superseded` so readers reopen.
+
+constexpr char TICK_STORE_MAGIC[8] = {'T', 'I', 'C', 'K', 'S', 'T', 'O', 'R'};
+constexpr uint32_t TICK_STORE_VERSION = 1;
+constexpr size_t TICK_STORE_HEADER_SIZE = 4096;
+constexpr size_t TICK_STORE_COLUMN_COUNT = 7;
+constexpr uint64_t TICK_STORE_CAPACITY_ALIGN = 512;
+constexpr uint64_t TICK_STORE_INITIAL_CAPACITY = 4096;
+constexpr size_t TICK_STORE_SYMBOL_SIZE = 16;
+
+enum TickColumn : size_t {
+    COLUMN_TIMESTAMP = 0,
+    COLUMN_OPEN,
+    COLUMN_HIGH,
+    COLUMN_LOW,
+    COLUMN_CLOSE,
+    COLUMN_VOLUME,
+    COLUMN_PRICE
+};
+
+// One row, as appended; stored column by column
+struct TickRecord {
+    uint64_t timestamp = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double volume = 0.0;
+    double price = 0.0;
+};
+
+struct TickStoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t column_count;
+    char symbol[TICK_STORE_SYMBOL_SIZE];
+    std::atomic<uint64_t> count;       // published after the column data
+    uint64_t capacity;
+    std::atomic<uint32_t> superseded;  // set once a grown copy replaced this file
+    uint32_t reserved;
+    uint64_t column_offset[TICK_STORE_COLUMN_COUNT];
+};
+
+static_assert(sizeof(TickStoreHeader) <= TICK_STORE_HEADER_SIZE, "Tick store header must fit its page");
+
+inline size_t tick_store_file_size(uint64_t capacity) {
+    return TICK_STORE_HEADER_SIZE + TICK_STORE_COLUMN_COUNT * capacity * sizeof(uint64_t);
+}
+
+inline uint64_t tick_store_round_capacity(uint64_t records) {
+    return (records + TICK_STORE_CAPACITY_ALIGN - 1) / TICK_STORE_CAPACITY_ALIGN * TICK_STORE_CAPACITY_ALIGN;
+}
+
+// Checks the header against the file it came from, so every column the
+// header describes lies inside file_size bytes and can be mapped or written
+inline void validate_tick_store_header(const TickStoreHeader* header, size_t file_size, const std::string& path) {
+    if (std::memcmp(header->magic, TICK_STORE_MAGIC, sizeof(TICK_STORE_MAGIC)) != 0) {
+        throw std::runtime_error("Not a tick store file: " + path);
+    }
+    if (header->version != TICK_STORE_VERSION || header->column_count != TICK_STORE_COLUMN_COUNT) {
+        throw std::runtime_error("Unsupported tick store version: " + path);
+    }
+    const uint64_t capacity = header->capacity;
+    if (file_size < TICK_STORE_HEADER_SIZE ||
+        capacity > (file_size - TICK_STORE_HEADER_SIZE) / (TICK_STORE_COLUMN_COUNT * sizeof(uint64_t)) ||
+        tick_store_file_size(capacity) > file_size) {
+        throw std::runtime_error("Tick store is truncated: " + path);
+    }
+    if (header->count.load(std::memory_order_acquire) > capacity) {
+        throw std::runtime_error("Tick store count exceeds its capacity: " + path);
+    }
+    for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+        if (header->column_offset[c] != TICK_STORE_HEADER_SIZE + c * capacity * sizeof(uint64_t)) {
+            throw std::runtime_error("Tick store has a corrupt column offset: " + path);
+        }
+    }
+}
+
+// Single writer per file. Appends go straight into the shared mapping, so
+// readers that mmap the same file see new records as soon as `count` moves.
+class TickStoreWriter {
+private:
+    std::string path_;
+    int fd_;
+    char* memory_;
+    size_t mapped_size_;
+
+    TickStoreHeader* header() const { return reinterpret_cast<TickStoreHeader*>(memory_); }
+
+    void map_file(int fd, size_t size) {
+        void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error("Failed to map tick store " + path_ + ": " + strerror(errno));
+        }
+        memory_ = static_cast<char*>(memory);
+        mapped_size_ = size;
+    }
+
+    void unmap_file() {
+        if (memory_) {
+            munmap(memory_, mapped_size_);
+            memory_ = nullptr;
+        }
+        if (fd_ != -1) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    static int create_file(const std::string& path, const char* symbol, uint64_t capacity) {
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) {
+            throw std::runtime_error("Failed to create tick store " + path + ": " + strerror(errno));
+        }
+        if (ftruncate(fd, tick_store_file_size(capacity)) == -1) {
+            close(fd);
+            throw std::runtime_error("Failed to size tick store " + path + ": " + strerror(errno));
+        }
+
+        TickStoreHeader header{};
+        std::memcpy(header.magic, TICK_STORE_MAGIC, sizeof(TICK_STORE_MAGIC));
+        header.version = TICK_STORE_VERSION;
+        header.column_count = TICK_STORE_COLUMN_COUNT;
+        std::strncpy(header.symbol, symbol, TICK_STORE_SYMBOL_SIZE - 1);
+        header.capacity = capacity;
+        for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+            header.column_offset[c] = TICK_STORE_HEADER_SIZE + c * capacity * sizeof(uint64_t);
+        }
+        if (pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+            close(fd);
+            throw std::runtime_error("Failed to write tick store header " + path);
+        }
+        return fd;
+    }
+
+    // Copy every column into a file twice as large and swap it in
+    void grow(uint64_t min_capacity) {
+        uint64_t capacity = header()->capacity * 2;
+        while (capacity < min_capacity) {
+            capacity *= 2;
+        }
+
+        const std::string tmp_path = path_ + ".grow";
+        const int fd = create_file(tmp_path, header()->symbol, capacity);
+        const uint64_t count = header()->count.load(std::memory_order_acquire);
+
+        void* grown = mmap(nullptr, tick_store_file_size(capacity), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (grown == MAP_FAILED) {
+            close(fd);
+            unlink(tmp_path.c_str());
+            throw std::runtime_error("Failed to map grown tick store " + tmp_path);
+        }
+        auto* grown_header = static_cast<TickStoreHeader*>(grown);
+        for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+            std::memcpy(static_cast<char*>(grown) + grown_header->column_offset[c],
+                        memory_ + header()->column_offset[c], count * sizeof(uint64_t));
+        }
+        grown_header->count.store(count, std::memory_order_release);
+
+        if (rename(tmp_path.c_str(), path_.c_str()) == -1) {
+            munmap(grown, tick_store_file_size(capacity));
+            close(fd);
+            unlink(tmp_path.c_str());
+            throw std::runtime_error("Failed to replace tick store " + path_ + ": " + strerror(errno));
+        }
+
+        header()->superseded.store(1, std::memory_order_release);
+        unmap_file();
+        fd_ = fd;
+        memory_ = static_cast<char*>(grown);
+        mapped_size_ = tick_store_file_size(capacity);
+    }
+
+public:
+    // Opens path for appending, creating it for symbol if it does not exist
+    TickStoreWriter(const std::string& path, const char* symbol,
+                    uint64_t initial_capacity = TICK_STORE_INITIAL_CAPACITY)
+        : path_(path), fd_(-1), memory_(nullptr), mapped_size_(0) {
+
+        fd_ = open(path.c_str(), O_RDWR);
+        if (fd_ == -1) {
+            if (errno != ENOENT) {
+                throw std::runtime_error("Failed to open tick store " + path + ": " + strerror(errno));
+            }
+            fd_ = create_file(path, symbol, tick_store_round_capacity(initial_capacity));
+        }
+
+        struct stat st{};
+        if (fstat(fd_, &st) == -1 || static_cast<size_t>(st.st_size) < TICK_STORE_HEADER_SIZE) {
+            close(fd_);
+            throw std::runtime_error("Tick store is truncated: " + path);
+        }
+        map_file(fd_, static_cast<size_t>(st.st_size));
+        try {
+            validate_tick_store_header(header(), mapped_size_, path);
+        } catch (...) {
+            unmap_file();
+            throw;
+        }
+    }
+
+    ~TickStoreWriter() {
+        unmap_file();
+    }
+
+    TickStoreWriter(const TickStoreWriter&) = delete;
+    TickStoreWriter& operator=(const TickStoreWriter&) = delete;
+
+    void append(const TickRecord& record) {
+        append_batch(&record, 1);
+    }
+
+    void append_batch(const TickRecord* records, size_t n) {
+        const uint64_t count = header()->count.load(std::memory_order_relaxed);
+        if (count + n > header()->capacity) {
+            grow(count + n);
+        }
+
+        uint64_t* columns[TICK_STORE_COLUMN_COUNT];
+        for (size_t c = 0; c < TICK_STORE_COLUMN_COUNT; ++c) {
+            columns[c] = reinterpret_cast<uint64_t*>(memory_ + header()->column_offset[c]) + count;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            columns[COLUMN_TIMESTAMP][i] = records[i].timestamp;
+            std::memcpy(&columns[COLUMN_OPEN][i], &records[i].open, sizeof(double));
+            std::memcpy(&columns[COLUMN_HIGH][i], &records[i].high, sizeof(double));
+            std::memcpy(&columns[COLUMN_LOW][i], &records[i].low, sizeof(double));
+            std::memcpy(&columns[COLUMN_CLOSE][i], &records[i].close, sizeof(double));
+            std::memcpy(&columns[COLUMN_VOLUME][i], &records[i].volume, sizeof(double));
+            std::memcpy(&columns[COLUMN_PRICE][i], &records[i].price, sizeof(double));
+        }
+
+        header()->count.store(count + n, std::memory_order_release);
+    }
+
+    // Grows the file (by copy and rename, as on a full append) to hold `records`
+    void reserve(uint64_t records) {
+        if (records > header()->capacity) {
+            grow(records);
+        }
+    }
+
+    // Force appended records to disk
+    bool flush() {
+        return msync(memory_, mapped_size_, MS_SYNC) == 0;
+    }
+
+    uint64_t size() const { return header()->count.load(std::memory_order_acquire); }
+    uint64_t capacity() const { return header()->capacity; }
+    const char* symbol() const { return header()->symbol; }
+    const std::string& path() const { return path_; }
+};
+
+// Read-only view into one column of a mapped store
+template<typename T>
+struct ColumnSpan {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const T& operator[](size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+};
+
+// Record indices [first, last) and zero-copy spans of each column over them
+struct TickRange {
+    uint64_t first = 0;
+    uint64_t last = 0;
+    ColumnSpan<uint64_t> timestamp;
+    ColumnSpan<double> open;
+    ColumnSpan<double> high;
+    ColumnSpan<double> low;
+    ColumnSpan<double> close;
+    ColumnSpan<double> volume;
+    ColumnSpan<double> price;
+
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// Maps a store read-only. Every query reads `count` afresh, so records a
+// writer appends through the same file become visible without remapping;
+// call refresh() to follow a writer that swapped in a grown file. Records
+// are assumed sorted by timestamp, as the importers and writers keep them.
+class TickStoreReader {
+private:
+    std::string path_;
+    const char* memory_;
+    size_t mapped_size_;
+    uint64_t capacity_ = 0;   // as validated against mapped_size_ when mapped
+
+    const TickStoreHeader* header() const { return reinterpret_cast<const TickStoreHeader*>(memory_); }
+
+    void map_file() {
+        const int fd = open(path_.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Failed to open tick store " + path_ + ": " + strerror(errno));
+        }
+        struct stat st{};
+        if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < TICK_STORE_HEADER_SIZE) {
+            close(fd);
+            throw std::runtime_error("Tick store is truncated: " + path_);
+        }
+        void* memory = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error("Failed to map tick store " + path_ + ": " + strerror(errno));
+        }
+
+        memory_ = static_cast<const char*>(memory);
+        mapped_size_ = static_cast<size_t>(st.st_size);
+        try {
+            validate_tick_store_header(header(), mapped_size_, path_);
+            capacity_ = header()->capacity;
+        } catch (...) {
+            unmap_file();
+            throw;
+        }
+    }
+
+    void unmap_file() {
+        if (memory_) {
+            munmap(const_cast<char*>(memory_), mapped_size_);
+            memory_ = nullptr;
+        }
+    }
+
+    template<typename T>
+    ColumnSpan<T> column_span(size_t column, uint64_t first, uint64_t last) const {
+        // The validated layout, rather than the header's offsets read again
+        const T* base = reinterpret_cast<const T*>(memory_ + TICK_STORE_HEADER_SIZE + column * capacity_ * sizeof(T));
+        return ColumnSpan<T>{base + first, static_cast<size_t>(last - first)};
+    }
+
+public:
+    explicit TickStoreReader(const std::string& path)
+        : path_(path), memory_(nullptr), mapped_size_(0) {
+        map_file();
+    }
+
+    ~TickStoreReader() {
+        unmap_file();
+    }
+
+    TickStoreReader(const TickStoreReader&) = delete;
+    TickStoreReader& operator=(const TickStoreReader&) = delete;
+
+    // Remaps if the writer replaced the file; spans handed out earlier become invalid
+    bool refresh() {
+        if (header()->superseded.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        unmap_file();
+        map_file();
+        return true;
+    }
+
+    // Capped at the validated capacity, so a count corrupted after mapping
+    // can't make a span reach past the mapping
+    uint64_t size() const { return std::min(header()->count.load(std::memory_order_acquire), capacity_); }
+    bool empty() const { return size() == 0; }
+    const char* symbol() const { return header()->symbol; }
+    const std::string& path() const { return path_; }
+
+    ColumnSpan<uint64_t> timestamps() const { return column_span<uint64_t>(COLUMN_TIMESTAMP, 0, size()); }
+    ColumnSpan<double> prices() const { return column_span<double>(COLUMN_PRICE, 0, size()); }
+
+    TickRange slice(uint64_t first, uint64_t last) const {
+        const uint64_t count = size();
+        last = std::min(last, count);
+        first = std::min(first, last);
+
+        TickRange range;
+        range.first = first;
+        range.last = last;
+        range.timestamp = column_span<uint64_t>(COLUMN_TIMESTAMP, first, last);
+        range.open = column_span<double>(COLUMN_OPEN, first, last);
+        range.high = column_span<double>(COLUMN_HIGH, first, last);
+        range.low = column_span<double>(COLUMN_LOW, first, last);
+        range.close = column_span<double>(COLUMN_CLOSE, first, last);
+        range.volume = column_span<double>(COLUMN_VOLUME, first, last);
+        range.price = column_span<double>(COLUMN_PRICE, first, last);
+        return range;
+    }
+
+    // Records with begin_ns <= timestamp < end_ns, found by binary search
+    TickRange time_range(uint64_t begin_ns, uint64_t end_ns) const {
+        const ColumnSpan<uint64_t> ts = timestamps();
+        const uint64_t first = std::lower_bound(ts.begin(), ts.end(), begin_ns) - ts.begin();
+        const uint64_t last = std::lower_bound(ts.begin() + first, ts.end(), end_ns) - ts.begin();
+        return slice(first, last);
+    }
+
+    // Most recent n records; O(1) regardless of file size
+    TickRange last(uint64_t n) const {
+        const uint64_t count = size();
+        return slice(count > n ? count - n : 0, count);
+    }
+
+    TickRecord record(uint64_t index) const {
+        const TickRange r = slice(index, index + 1);
+        if (r.empty()) {
+            throw std::out_of_range("Tick store record out of range: " + path_);
+        }
+        TickRecord record;
+        record.timestamp = r.timestamp[0];
+        record.open = r.open[0];
+        record.high = r.high[0];
+        record.low = r.low[0];
+        record.close = r.close[0];
+        record.volume = r.volume[0];
+        record.price = r.price[0];
+        return record;
+    }
+
+    TickRecord latest() const {
+        const uint64_t count = size();
+        if (count == 0) {
+            throw std::out_of_range("Tick store is empty: " + path_);
+        }
+        return record(count - 1);
+    }
+};
+
+// market_data/<asset_type>/<symbol>.ticks, next to the legacy CSV
+inline std::string tick_store_path(const std::string& data_dir, const std::string& asset_type,
+                                   const std::string& symbol) {
+    return data_dir + "/" + asset_type + "/" + symbol + ".ticks";
+}
+
+#endif // TICK_STORE_H
@@ -2,14 +2,81 @@
 #define TRADING_SYSTEM_H
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 
-// Essential trading data structure for shared memory communication
-struct TradingData {
+// Plain copy of one tick, as handed out by TradingData::snapshot()
+struct TradingTick {
+    double price = 0.0;
+    uint64_t timestamp = 0;     // source time, nanoseconds since the Unix epoch
+    int32_t volume = 0;
+    bool valid = false;
+    uint16_t symbol_index = 0;  // slot in the MarketDataTable; not stored in TradingData
+    uint64_t publish_ns = 0;    // CLOCK_MONOTONIC when published to the rings (latency.h); not stored in TradingData
+};
+
+// Python TICK_FORMAT 'dQi?xHQ'
+static_assert(offsetof(TradingTick, timestamp) == 8 && offsetof(TradingTick, volume) == 16 &&
+              offsetof(TradingTick, valid) == 20 && offsetof(TradingTick, symbol_index) == 22 &&
+              offsetof(TradingTick, publish_ns) == 24 && sizeof(TradingTick) == 32,
+              "TradingTick layout is mirrored by Python TICK_FORMAT");
+
+// Essential trading data structure for shared memory communication.
+//
+// Fields are published under a sequence counter (seqlock): the writer bumps
+// `sequence` to an odd value, stores the fields, then bumps it to the next
+// even value. Readers retry while the counter is odd or changed during the
+// read, so they always see all four fields from the same tick.
+// Single writer only. Every field is writer-owned and the struct is aligned
+// so it never straddles a cache line: a reader pulls in exactly one line
+// per snapshot. Reader-side state must live elsewhere, never in here.
+struct alignas(32) TradingData {
+    std::atomic<uint64_t> sequence{0};
     std::atomic<double> price{0.0};
     std::atomic<uint64_t> timestamp{0};
     std::atomic<int32_t> volume{0};
     std::atomic<bool> valid{false};
+
+    void publish(const TradingTick& tick) {
+        const uint64_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        price.store(tick.price, std::memory_order_relaxed);
+        timestamp.store(tick.timestamp, std::memory_order_relaxed);
+        volume.store(tick.volume, std::memory_order_relaxed);
+        valid.store(tick.valid, std::memory_order_relaxed);
+
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Single attempt; returns false if a write was in progress or raced us
+    bool try_snapshot(TradingTick& out) const {
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        out.price = price.load(std::memory_order_relaxed);
+        out.timestamp = timestamp.load(std::memory_order_relaxed);
+        out.volume = volume.load(std::memory_order_relaxed);
+        out.valid = valid.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    TradingTick snapshot() const {
+        TradingTick tick;
+        while (!try_snapshot(tick)) {
+        }
+        return tick;
+    }
 };
 
-#endif // TRADING_SYSTEM_H
\ No newline at end of file
+// Python TRADING_DATA_FORMAT 'QdQi?3x'
+static_assert(offsetof(TradingData, price) == 8 && offsetof(TradingData, timestamp) == 16 &&
+              offsetof(TradingData, volume) == 24 && offsetof(TradingData, valid) == 28 &&
+              sizeof(TradingData) == 32, "TradingData layout is mirrored by Python TRADING_DATA_FORMAT");
+
+#endif // TRADING_SYSTEM_H
@@ -0,0 +1,185 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "shared_code.h"  // CACHE_LINE_SIZE
+
+// Fixed set of workers, one task deque each. A worker takes from the back
+// of its own deque (last in, hot in cache) and, when that is empty, steals
+// from the front of another worker's (oldest, usually the largest
+// remaining piece of work), so uneven tasks even out without a central
+// queue everybody contends on. Tasks are meant to be coarse (milliseconds
+// and up): each deque has its own lock, taken once per pop or steal.
+//
+// A task receives the index of the worker running it, for worker-local
+// state indexed by it. Tasks submitted from inside a task go to the
+// submitting worker's own deque (when it belongs to the same pool). Idle
+// workers sleep until a task is queued.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(unsigned worker)>;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        uint64_t executed = 0;
+        uint64_t stolen = 0;   // tasks this worker took from other deques
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> unfinished_{0};
+    std::atomic<size_t> next_queue_{0};
+    // Tasks in the deques not yet taken. Raised under idle_mutex_, so an
+    // idle worker can't miss one between its last look and its wait; may dip
+    // below zero while a take overtakes the submit that raises it.
+    std::atomic<int64_t> queued_{0};
+    std::mutex idle_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    bool stopping_ = false;
+
+    // The pool and worker index of the calling thread, if it is a worker
+    struct WorkerIdentity {
+        const WorkStealingPool* pool = nullptr;
+        unsigned index = 0;
+    };
+
+    static WorkerIdentity& current_worker() {
+        static thread_local WorkerIdentity worker;
+        return worker;
+    }
+
+    bool pop_local(unsigned worker, Task& task) {
+        Queue& queue = *queues_[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool steal(unsigned worker, Task& task) {
+        const size_t count = queues_.size();
+        for (size_t i = 1; i < count; ++i) {
+            Queue& victim = *queues_[(worker + i) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(unsigned worker) {
+        current_worker() = WorkerIdentity{this, worker};
+        Task task;
+        while (true) {
+            bool stolen = false;
+            if (!pop_local(worker, task)) {
+                stolen = steal(worker, task);
+                if (!stolen) {
+                    std::unique_lock<std::mutex> lock(idle_mutex_);
+                    if (stopping_) {
+                        return;
+                    }
+                    work_available_.wait(lock, [this] {
+                        return stopping_ || queued_.load(std::memory_order_relaxed) > 0;
+                    });
+                    continue;
+                }
+            }
+            task(worker);
+            task = nullptr;
+            {
+                Queue& own = *queues_[worker];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                ++own.executed;
+                own.stolen += stolen;
+            }
+            if (unfinished_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(idle_mutex_);
+                all_done_.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency()) {
+        threads = std::max(1u, threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.emplace_back(&WorkStealingPool::run, this, i);
+        }
+    }
+
+    ~WorkStealingPool() {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // From outside the pool tasks are dealt round-robin over the deques
+    void submit(Task task) {
+        unfinished_.fetch_add(1, std::memory_order_relaxed);
+        const WorkerIdentity& self = current_worker();
+        const size_t target = self.pool == this ? self.index : next_queue_.fetch_add(1) % queues_.size();
+        {
+            Queue& queue = *queues_[target];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            queued_.fetch_add(1, std::memory_order_relaxed);
+        }
+        work_available_.notify_one();
+    }
+
+    // Blocks until every submitted task has finished; not callable from a task
+    void wait() {
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        all_done_.wait(lock, [this] { return unfinished_.load(std::memory_order_acquire) == 0; });
+    }
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    uint64_t executed(unsigned worker) {
+        std::lock_guard<std::mutex> lock(queues_[worker]->mutex);
+        return queues_[worker]->executed;
+    }
+
+    uint64_t stolen(unsigned worker) {
+        std::lock_guard<std::mutex> lock(queues_[worker]->mutex);
+        return queues_[worker]->stolen;
+    }
+};
+
+#endif // WORK_STEALING_POOL_H
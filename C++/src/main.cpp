@@ -5,18 +5,74 @@
 #include <atomic>
 #include <sys/wait.h>
 #include <unistd.h>
-#include <random>
 #include <iomanip>
+#include <vector>
+#include <cmath>
+#include <string>
 #include "include/shared_code.h"
+#include "include/market_data_table.h"
+#include "include/indicators.h"
+#include "include/order_book.h"
+#include "include/runtime_config.h"
+#include "include/latency.h"
+#include "include/memory_pool.h"
+#include "include/tick_persister.h"
+#include "include/command_queue.h"
+#include "include/metrics.h"
+#include "include/async_logger.h"
+
+// Counts every operator new, so the hot paths below can show they stay off the heap
+TRADING_COUNT_ALLOCATIONS();
 
 std::atomic<bool> running{true};
 pid_t python_pid = 0;
 
-void cleanup_shared_memory() {
+// Heap allocations inside each thread's per-tick / per-batch work, after a 2 s warmup
+HotPathAllocations producer_allocations;
+HotPathAllocations indicator_allocations;
+HotPathAllocations book_allocations;
+
+void report_allocations() {
+    if (!allocation_counting_enabled()) {
+        return;
+    }
+    std::cout << "Hot-path allocations after warmup: producer " << producer_allocations.count()
+              << " | indicator engine " << indicator_allocations.count()
+              << " | book engine " << book_allocations.count() << std::endl;
+}
+
+void cleanup_shared_memory(const MappingOptions& options) {
     std::cout << "Cleaning up previous shared memory..." << std::endl;
-    if (destroy_memory_block("/trading_data")) {
+    if (destroy_memory_block("/trading_data", options)) {
         std::cout << "Previous shared memory cleared" << std::endl;
     }
+    if (destroy_memory_block("/trading_ticks", options)) {
+        std::cout << "Previous tick ring cleared" << std::endl;
+    }
+    if (destroy_memory_block("/trading_broadcast", options)) {
+        std::cout << "Previous broadcast ring cleared" << std::endl;
+    }
+    if (destroy_memory_block("/market_data", options)) {
+        std::cout << "Previous market data table cleared" << std::endl;
+    }
+    if (destroy_memory_block("/trading_indicators", options)) {
+        std::cout << "Previous indicator table cleared" << std::endl;
+    }
+    if (destroy_memory_block("/trading_latency", options)) {
+        std::cout << "Previous latency table cleared" << std::endl;
+    }
+    if (destroy_memory_block("/trading_orders", options)) {
+        std::cout << "Previous order ring cleared" << std::endl;
+    }
+    if (destroy_memory_block("/trading_book", options)) {
+        std::cout << "Previous order book table cleared" << std::endl;
+    }
+    if (destroy_memory_block("/trading_commands", options)) {
+        std::cout << "Previous command ring cleared" << std::endl;
+    }
+    if (destroy_memory_block("/trading_metrics", options)) {
+        std::cout << "Previous metrics table cleared" << std::endl;
+    }
 }
 
 void signal_handler(int signal) {
@@ -31,10 +87,143 @@ void signal_handler(int signal) {
     }
 }
 
-pid_t launch_python_process() {
+// Random-walk parameters for each simulated instrument
+struct SimulatedSymbol {
+    const char* name;
+    double start_price;
+    double price;
+    int32_t index;
+};
+
+// Follows the broadcast ring off the producer thread and keeps /trading_indicators current
+void run_indicator_engine(SharedMemory<TickBroadcastRing>& broadcast_shm, SharedMemory<Indicators>& indicator_shm,
+                          SharedMemory<LatencyTable>& latency_shm, SharedMemory<MetricsTable>& metrics_shm,
+                          SchedulingOptions scheduling) {
+    apply_scheduling("indicator engine", scheduling);
+    TickBroadcastReader reader(broadcast_shm);
+    LatencyRecorder latency(latency_shm, "indicator-engine");
+    MetricsRecorder metrics(metrics_shm, "indicator-engine");
+    TickIndicatorEngine engine(indicator_shm.get());
+    TradingTick batch[256];
+    
+    while (running) {
+        const size_t count = reader.wait_and_poll(batch, 256, std::chrono::milliseconds(100));
+        const uint64_t received_ns = monotonic_ns();
+        HotPathAllocations::Section hot(indicator_allocations);
+        for (size_t i = 0; i < count; ++i) {
+            latency.record(batch[i], received_ns);
+            engine.on_tick(batch[i]);
+        }
+        if (count > 0) {
+            indicator_shm.notify();
+            metrics.add(METRIC_TICKS_CONSUMED, static_cast<int64_t>(count));
+            metrics.add(METRIC_BATCHES);
+            metrics.record_batch(monotonic_ns() - received_ns);
+        }
+        metrics.set(METRIC_READER_LAG, static_cast<int64_t>(reader.lag()));
+        metrics.set(METRIC_READER_DROPPED, static_cast<int64_t>(reader.dropped()));
+    }
+}
+
+// Applies order deltas from /trading_orders and keeps /trading_book current
+void run_book_engine(SharedMemory<OrderRing>& order_shm, SharedMemory<OrderBooks>& book_shm,
+                     SharedMemory<MetricsTable>& metrics_shm, bool l3, SchedulingOptions scheduling) {
+    apply_scheduling("book engine", scheduling);
+    MetricsRecorder metrics(metrics_shm, "book-engine");
+    BookEngine engine(book_shm.get(), l3);
+    OrderRing* ring = order_shm.get();
+    const WaitPolicy policy = WaitPolicy::from_env();
+    OrderEvent batch[1024];
+    
+    while (running) {
+        const uint32_t epoch = order_shm.update_epoch();
+        const size_t count = ring->pop_batch(batch, 1024);
+        if (count == 0) {
+            order_shm.wait_for_update(epoch, std::chrono::milliseconds(100), policy);
+            continue;
+        }
+        const uint64_t start_ns = monotonic_ns();
+        HotPathAllocations::Section hot(book_allocations);
+        for (size_t i = 0; i < count; ++i) {
+            engine.on_event(batch[i]);
+        }
+        if (engine.publish() > 0) {
+            book_shm.notify();
+        }
+        metrics.record_batch(monotonic_ns() - start_ns);
+        metrics.add(METRIC_BATCHES);
+        metrics.set(METRIC_DELTAS_APPLIED, static_cast<int64_t>(engine.applied()));
+        metrics.set(METRIC_DELTAS_REJECTED, static_cast<int64_t>(engine.rejected()));
+        metrics.set(METRIC_ORDER_RING_DEPTH, static_cast<int64_t>(ring->size()));
+    }
+    std::cout << "Book engine: " << engine.applied() << " deltas applied, " << engine.rejected() << " rejected" << std::endl;
+}
+
+// Drains the broadcast ring into the tick stores, committing once per durability window
+void run_persister(TickBroadcastReader& reader, TickPersister& persister, SharedMemory<MetricsTable>& metrics_shm,
+                   SchedulingOptions scheduling) {
+    apply_scheduling("persister", scheduling);
+    MetricsRecorder metrics(metrics_shm, "persister");
+    TradingTick batch[1024];
+    
+    while (running) {
+        const auto timeout = std::min<std::chrono::nanoseconds>(
+            persister.until_due(std::chrono::steady_clock::now()), std::chrono::milliseconds(100));
+        const size_t count = reader.wait_and_poll(batch, 1024, timeout);
+        for (size_t i = 0; i < count; ++i) {
+            persister.append(batch[i]);
+        }
+        persister.note_source(reader.lag(), reader.dropped());
+        if (persister.pending() > 0 && persister.until_due(std::chrono::steady_clock::now()).count() == 0) {
+            const uint64_t start_ns = monotonic_ns();
+            persister.commit();
+            metrics.record_batch(monotonic_ns() - start_ns);
+        }
+        const PersistStats& stats = persister.stats();
+        metrics.set(METRIC_TICKS_PERSISTED, static_cast<int64_t>(stats.ticks.load()));
+        metrics.set(METRIC_COMMITS, static_cast<int64_t>(stats.commits.load()));
+        metrics.set(METRIC_PERSIST_ERRORS, static_cast<int64_t>(stats.errors.load()));
+        metrics.set(METRIC_PERSIST_PENDING, static_cast<int64_t>(persister.pending()));
+        metrics.set(METRIC_READER_LAG, static_cast<int64_t>(reader.lag()));
+        metrics.set(METRIC_READER_DROPPED, static_cast<int64_t>(reader.dropped()));
+    }
+    // Whatever the producer published before stopping is still in the ring
+    size_t count;
+    while ((count = reader.poll(batch, 1024)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            persister.append(batch[i]);
+        }
+    }
+    persister.flush();
+    persister.note_source(reader.lag(), reader.dropped());
+}
+
+void report_persistence(const TickPersister* persister) {
+    if (!persister) {
+        return;
+    }
+    const PersistStats& stats = persister->stats();
+    std::cout << "Persisted: " << stats.ticks.load() << " ticks in " << stats.commits.load() << " commits | last "
+              << std::fixed << std::setprecision(2) << stats.last_commit_ns.load() / 1e6 << " ms, max "
+              << stats.max_commit_ns.load() / 1e6 << " ms | lag " << stats.source_lag.load() << " | dropped "
+              << stats.source_dropped.load() << " | errors " << stats.errors.load() << std::endl;
+}
+
+void report_commands(const CommandStats& stats) {
+    if (stats.applied + stats.rejected == 0) {
+        return;
+    }
+    std::cout << "Commands: " << stats.applied << " applied, " << stats.rejected << " rejected | last #"
+              << stats.last_id << " after " << std::fixed << std::setprecision(1) << stats.last_latency_ns / 1e3
+              << " us, max " << stats.max_latency_ns / 1e3 << " us" << std::endl;
+}
+
+pid_t launch_python_process(const SchedulingOptions& scheduling) {
     pid_t pid = fork();
     
     if (pid == 0) {
+        // Affinity and policy survive execl, so the interpreter starts on its own cores
+        apply_scheduling("python bridge", scheduling);
         execl("/usr/bin/python3", "python3", "../../Python/data_bridge.py", nullptr);
         perror("Failed to launch Python process");
         exit(1);
@@ -52,59 +241,429 @@ int main(int argc, char** argv) {
     signal(SIGTERM, signal_handler);
     
     try {
-        cleanup_shared_memory();
+        // --config file, --<role>-cpus / --<role>-fifo and --replay flags (see runtime_config.h)
+        const RuntimeConfig config = RuntimeConfig::from_args(argc, argv);
+        
+        // TRADING_SHM_OPTIONS, e.g. "thp,populate,lock,numa:0" (see mapping_options.h)
+        const MappingOptions mapping_options = MappingOptions::from_env();
+        cleanup_shared_memory(mapping_options);
         
-        SharedMemory<TradingData> trading_shm("/trading_data", true);        
+        SharedMemory<TradingData> trading_shm("/trading_data", true, mapping_options);        
         auto shared_data = trading_shm.get();
+        SharedMemory<TickRing> tick_ring_shm("/trading_ticks", true, mapping_options);
+        auto tick_ring = tick_ring_shm.get();
+        SharedMemory<TickBroadcastRing> broadcast_shm("/trading_broadcast", true, mapping_options);
+        auto broadcast_ring = broadcast_shm.get();
+        SharedMemory<MarketData> market_shm("/market_data", true, mapping_options);
+        auto market_data = market_shm.get();
+        SharedMemory<Indicators> indicator_shm("/trading_indicators", true, mapping_options);
+        SharedMemory<LatencyTable> latency_shm("/trading_latency", true, mapping_options);
+        SharedMemory<OrderRing> order_shm("/trading_orders", true, mapping_options);
+        auto order_ring = order_shm.get();
+        SharedMemory<OrderBooks> book_shm("/trading_book", true, mapping_options);
+        SharedMemory<CommandRing> command_shm("/trading_commands", true, mapping_options);
+        auto command_ring = command_shm.get();
+        CommandStats command_stats;
+        SharedMemory<MetricsTable> metrics_shm("/trading_metrics", true, mapping_options);
+        MetricsRecorder metrics(metrics_shm, "producer");
+        // Status lines from the publishing path; the periodic summaries below still print directly
+        AsyncLogger logger;
         
-        python_pid = launch_python_process();
+        // Symbols stored under market_data/; the first one also feeds /trading_data
+        std::vector<SimulatedSymbol> symbols = {
+            {"AAPL", 150.0, 150.0, -1},
+            {"TSLA", 255.0, 255.0, -1},
+            {"BTC", 104500.0, 104500.0, -1},
+        };
+        std::vector<int32_t> replay_indices;
+        std::vector<int32_t> load_indices;
+        FeedOptions feed_options = config.feed;
+        int32_t primary_index;
+        if (config.replay.enabled()) {
+            for (const auto& name : config.replay.symbols) {
+                replay_indices.push_back(market_data->add_symbol(name.c_str()));
+            }
+            primary_index = replay_indices[0];
+        } else if (config.load.enabled()) {
+            for (size_t i = 0; i < config.load.symbols; ++i) {
+                load_indices.push_back(market_data->add_symbol(LoadGenerator::symbol_name(i).c_str()));
+            }
+            primary_index = load_indices[0];
+        } else if (feed_options.enabled()) {
+            for (auto& feed : feed_options.feeds) {
+                for (auto& symbol : feed.symbols) {
+                    symbol.index = market_data->add_symbol(symbol.name.c_str());
+                }
+            }
+            primary_index = feed_options.feeds[0].symbols[0].index;
+        } else {
+            for (auto& symbol : symbols) {
+                symbol.index = market_data->add_symbol(symbol.name);
+            }
+            primary_index = symbols[0].index;
+        }
+        
+        // Stand-in depth feed for the book engine, derived from the ticks below
+        const bool books_enabled = config.book_mode != "off";
+        SyntheticOrderFlow order_flow(std::random_device{}(), config.book_mode == "l3");
+        auto push_order = [&](const OrderEvent& event) {
+            if (!order_ring->try_push(event)) {
+                metrics.add(METRIC_ORDERS_DROPPED);
+            }
+        };
+        
+        // Cleared by Unsubscribe commands; that symbol's ticks are dropped before publishing
+        std::vector<uint8_t> subscribed(MarketData::capacity, 1);
+        
+        // Every tick, simulated or replayed, goes to all segments the same way
+        uint64_t batch_start_ns = 0;
+        auto publish = [&](TradingTick& tick_data) {
+            if (!subscribed[tick_data.symbol_index]) {
+                return;
+            }
+            HotPathAllocations::Section hot(producer_allocations);
+            tick_data.publish_ns = monotonic_ns();
+            if (batch_start_ns == 0) {
+                batch_start_ns = tick_data.publish_ns;
+            }
+            market_data->at(tick_data.symbol_index).publish(tick_data);
+            if (tick_data.symbol_index == primary_index) {
+                shared_data->publish(tick_data);
+            }
+            if (!tick_ring->try_push(tick_data)) {
+                metrics.add(METRIC_TICKS_DROPPED);
+            }
+            broadcast_ring->publish(tick_data);
+            if (books_enabled) {
+                order_flow.on_tick(tick_data, push_order);
+            }
+            metrics.add(METRIC_TICKS_PUBLISHED);
+        };
+        
+        // Targets of SetRate: simulated updates per symbol, or the load generator's rate
+        const bool simulating = !config.replay.enabled() && !config.load.enabled() && !feed_options.enabled();
+        std::chrono::nanoseconds tick_interval = std::chrono::milliseconds(100);
+        LoadOptions load_options = config.load;
+        
+        // One command from /trading_commands; false rejects it in this mode
+        auto apply_command = [&](const Command& command) {
+            const std::string name = command_symbol(command);
+            switch (command.type) {
+            case CommandType::Subscribe: {
+                if (name.empty() || name.size() >= SYMBOL_NAME_SIZE) {
+                    return false;
+                }
+                int32_t index = market_data->find(name.c_str());
+                if (index < 0) {
+                    // Only the simulator can make up ticks for a symbol nobody feeds
+                    if (!simulating || market_data->size() >= MarketData::capacity) {
+                        return false;
+                    }
+                    index = market_data->add_symbol(name.c_str());
+                    const double start_price = command.value > 0.0 ? command.value : 100.0;
+                    symbols.push_back({market_data->symbol_at(index), start_price, start_price, index});
+                }
+                subscribed[index] = 1;
+                return true;
+            }
+            case CommandType::Unsubscribe: {
+                const int32_t index = market_data->find(name.c_str());
+                if (index < 0) {
+                    return false;
+                }
+                subscribed[index] = 0;
+                return true;
+            }
+            case CommandType::SetRate:
+                // Negated comparisons so NaN is rejected too
+                if (simulating) {
+                    if (!(command.value >= COMMAND_MIN_RATE && command.value <= COMMAND_MAX_SIMULATED_RATE)) {
+                        return false;
+                    }
+                    tick_interval = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / command.value));
+                    return true;
+                }
+                if (config.load.enabled()) {
+                    if (!(command.value >= COMMAND_MIN_RATE && command.value <= COMMAND_MAX_LOAD_RATE)) {
+                        return false;
+                    }
+                    load_options.rate = command.value;
+                    return true;
+                }
+                return false;
+            case CommandType::PlaceOrder:
+            case CommandType::CancelOrder: {
+                const int32_t index = market_data->find(name.c_str());
+                if (!books_enabled || index < 0 || !(command.value > 0.0)) {
+                    return false;
+                }
+                OrderEvent event;
+                event.order_id = command.order_id | COMMAND_ORDER_ID_BIT;
+                event.price = to_book_ticks(command.value);
+                event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                event.quantity = command.quantity;
+                event.symbol_index = static_cast<uint16_t>(index);
+                event.side = command.side;
+                event.action = command.type == CommandType::PlaceOrder ? BookAction::Add : BookAction::Cancel;
+                return order_ring->try_push(event);
+            }
+            default:
+                return false;
+            }
+        };
+        // Non-blocking; orders a command placed are handed to the book engine right away
+        auto handle_commands = [&]() {
+            const size_t count = poll_commands(*command_ring, command_stats, apply_command);
+            if (count > 0 && books_enabled) {
+                order_shm.notify();
+            }
+            return count;
+        };
+        // Stands in for sleep_until in every producer loop: blocks on the command ring's
+        // epoch until the deadline, applying commands as they arrive
+        auto wait_for_commands = [&](std::chrono::steady_clock::time_point deadline) {
+            while (running) {
+                const uint32_t epoch = command_shm.update_epoch();
+                if (handle_commands() > 0) {
+                    continue;
+                }
+                const auto remaining = deadline - std::chrono::steady_clock::now();
+                if (remaining <= std::chrono::nanoseconds::zero()) {
+                    break;
+                }
+                command_shm.wait_for_update(epoch, remaining);
+            }
+        };
+        
+        // Wake any blocked consumers once per batch of updates, then take in commands
+        auto notify_consumers = [&]() {
+            trading_shm.notify();
+            tick_ring_shm.notify();
+            broadcast_shm.notify();
+            market_shm.notify();
+            if (books_enabled) {
+                order_shm.notify();
+            }
+            handle_commands();
+            if (batch_start_ns != 0) {
+                metrics.record_batch(monotonic_ns() - batch_start_ns);
+                batch_start_ns = 0;
+            }
+            metrics.add(METRIC_BATCHES);
+            metrics.set(METRIC_TICK_RING_DEPTH, static_cast<int64_t>(tick_ring->size()));
+            metrics.set(METRIC_COMMAND_RING_DEPTH, static_cast<int64_t>(command_ring->size()));
+            metrics.set(METRIC_COMMANDS_APPLIED, static_cast<int64_t>(command_stats.applied));
+            metrics.set(METRIC_COMMANDS_REJECTED, static_cast<int64_t>(command_stats.rejected));
+            metrics.set(METRIC_LOG_LINES, static_cast<int64_t>(logger.written()));
+            metrics.set(METRIC_LOG_SUPPRESSED, static_cast<int64_t>(logger.suppressed()));
+        };
+        
+        std::thread indicator_thread(run_indicator_engine, std::ref(broadcast_shm), std::ref(indicator_shm),
+                                     std::ref(latency_shm), std::ref(metrics_shm), config.indicator);
+        std::thread book_thread;
+        if (books_enabled) {
+            book_thread = std::thread(run_book_engine, std::ref(order_shm), std::ref(book_shm), std::ref(metrics_shm),
+                                      config.book_mode == "l3", config.book);
+        }
+        // Attached before the producer starts, so the stores get every tick from the first one
+        std::unique_ptr<TickBroadcastReader> persist_reader;
+        std::unique_ptr<TickPersister> persister;
+        std::thread persist_thread;
+        if (config.persistence.enabled()) {
+            persist_reader = std::make_unique<TickBroadcastReader>(broadcast_shm);
+            persister = std::make_unique<TickPersister>(config.persistence, market_data);
+            persist_thread = std::thread(run_persister, std::ref(*persist_reader), std::ref(*persister),
+                                         std::ref(metrics_shm), config.persist);
+        }
+        auto join_consumers = [&]() {
+            indicator_thread.join();
+            if (book_thread.joinable()) {
+                book_thread.join();
+            }
+            if (persist_thread.joinable()) {
+                persist_thread.join();
+                report_persistence(persister.get());
+            }
+        };
+        
+        // The bridge leaves ingestion to the feed handler and stops fetching over HTTP itself
+        if (feed_options.enabled()) {
+            setenv("TRADING_NATIVE_FEED", "1", 1);
+        }
+        python_pid = launch_python_process(config.python);
         if (python_pid == -1) {
             std::cerr << "Failed to launch Python process, continuing without it..." << std::endl;
         }
         
+        // Only after the fork and the thread start, so neither inherits the producer's placement
+        apply_scheduling("producer", config.producer);
+        
         std::cout << "\n=== Trading System Ready ===" << std::endl;
         std::cout << "✓ Shared memory initialized" << std::endl;
         std::cout << "✓ Python bridge process launched" << std::endl;
-        std::cout << "✓ Simulating real market data" << std::endl;
+        std::cout << "✓ Indicator engine running" << std::endl;
+        if (books_enabled) {
+            std::cout << "✓ Order book engine running (" << config.book_mode << ")" << std::endl;
+        }
+        if (persister) {
+            std::cout << "✓ Persisting ticks to " << config.persistence.dir << " ("
+                      << (config.persistence.direct ? "direct" : "buffered") << ", "
+                      << config.persistence.window.count() << " ms window)" << std::endl;
+        }
+        if (config.replay.enabled()) {
+            std::cout << "✓ Replaying recorded market data" << std::endl;
+        } else if (config.load.enabled()) {
+            std::cout << "✓ Generating synthetic load" << std::endl;
+        } else if (feed_options.enabled()) {
+            std::cout << "✓ Receiving live venue feeds" << std::endl;
+        } else {
+            std::cout << "✓ Simulating real market data" << std::endl;
+        }
+        
+        if (config.replay.enabled()) {
+            TickReplayer replayer(config.replay, replay_indices);
+            std::cout << "\nReplaying " << replayer.total() << " ticks of " << config.replay.symbols.size() << " symbols at ";
+            if (config.replay.speed > 0.0) {
+                std::cout << config.replay.speed << "x" << std::endl;
+            } else {
+                std::cout << "max speed" << std::endl;
+            }
+            const ReplayStats stats = run_replay(replayer, config.replay.speed, running, publish, notify_consumers,
+                                                 wait_for_commands);
+            std::cout << "Replay " << (replayer.done() ? "finished" : "stopped") << ": " << stats.ticks << " ticks in "
+                      << std::fixed << std::setprecision(3) << stats.elapsed.count() / 1e9 << " s ("
+                      << std::setprecision(0) << stats.ticks_per_second() << " ticks/s) | Dropped: " << metrics.value(METRIC_TICKS_DROPPED)
+                      << std::endl;
+            report_latency(*latency_shm);
+            report_allocations();
+            if (running && python_pid > 0) {
+                kill(python_pid, SIGTERM);
+                waitpid(python_pid, nullptr, 0);
+            }
+            running = false;
+            join_consumers();
+            return 0;
+        }
         
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> price_dist(-2.0, 2.0);
-        std::uniform_int_distribution<> volume_dist(500000, 2000000);
+        if (config.load.enabled()) {
+            LoadGenerator generator(config.load, load_indices);
+            std::cout << "\nGenerating " << config.load.rate << " ticks/s over " << config.load.symbols << " symbols";
+            if (config.load.burst_ms > 0) {
+                std::cout << ", " << config.load.burst_factor << "x for " << config.load.burst_ms << " ms every "
+                          << config.load.burst_period_ms << " ms";
+            }
+            std::cout << std::endl;
+            run_load(generator, load_options, running, publish, notify_consumers, wait_for_commands,
+                     [&](const LoadReport& window) {
+                logger.printf("Load: target %.0f ticks/s | sent %.0f ticks/s | shortfall %.1f%% | backlog %llu"
+                              " | Ring: %zu | Dropped: %lld | Orders dropped: %lld",
+                              window.target_ticks / window.seconds, window.sent_ticks / window.seconds,
+                              window.shortfall_pct(), static_cast<unsigned long long>(window.backlog), tick_ring->size(),
+                              static_cast<long long>(metrics.value(METRIC_TICKS_DROPPED)),
+                              static_cast<long long>(metrics.value(METRIC_ORDERS_DROPPED)));
+                report_latency(*latency_shm);
+                report_allocations();
+                report_persistence(persister.get());
+                report_commands(command_stats);
+            });
+            join_consumers();
+            return 0;
+        }
+        
+        if (feed_options.enabled()) {
+            FeedHandler feed_handler(feed_options);
+            std::cout << "\nConnecting " << feed_options.feeds.size() << " feeds for "
+                      << feed_options.symbol_count() << " symbols" << std::endl;
+            run_feed(feed_handler, running, publish, notify_consumers, handle_commands, [&](const FeedHandler& handler) {
+                for (const auto& connection : handler.connections()) {
+                    const FeedStats& stats = connection->stats();
+                    logger.printf("Feed %s: %s | %llu msgs | %llu ticks | %llu errors | %llu reconnects",
+                                  feed_venue_name(connection->feed().venue),
+                                  connection->state() == FeedConnection::State::Open ? "open" : "connecting",
+                                  static_cast<unsigned long long>(stats.messages),
+                                  static_cast<unsigned long long>(stats.ticks),
+                                  static_cast<unsigned long long>(stats.parse_errors),
+                                  static_cast<unsigned long long>(stats.reconnects));
+                }
+                logger.printf("Ring: %zu | Dropped: %lld", tick_ring->size(),
+                              static_cast<long long>(metrics.value(METRIC_TICKS_DROPPED)));
+                report_latency(*latency_shm);
+                report_allocations();
+                report_persistence(persister.get());
+                report_commands(command_stats);
+            });
+            join_consumers();
+            return 0;
+        }
+        
+        Xoshiro256 rng(std::random_device{}());
         
-        double base_price = 150.0; // Starting price for AAPL
         int tick = 0;
+        JitterStats jitter;
+        auto next_wakeup = std::chrono::steady_clock::now();
+        // By the clock rather than every N ticks, which SetRate commands would speed up
+        const auto report_interval = std::chrono::seconds(10);
+        auto next_report = next_wakeup + report_interval;
         
         std::cout << "\nPress Ctrl+C to exit..." << std::endl;
         std::cout << "\nStreaming market data updates:\n" << std::endl;
         
         while (running) {
-            double price_change = price_dist(gen);
-            double current_price = base_price + price_change;
-            int current_volume = volume_dist(gen);
-            auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+            const uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
                 std::chrono::system_clock::now().time_since_epoch()).count();
             
-            shared_data->price.store(current_price);
-            shared_data->volume.store(current_volume);
-            shared_data->timestamp.store(timestamp);
-            shared_data->valid.store(true);
-            
-            if (tick % 10 == 0) {
-                std::cout << "Tick " << tick 
-                          << " | AAPL: $" << std::fixed << std::setprecision(2) << current_price
-                          << " | Volume: " << current_volume
-                          << " | Time: " << timestamp << std::endl;
+            for (auto& symbol : symbols) {
+                if (!subscribed[symbol.index]) {
+                    continue;
+                }
+                // Moves are scaled so every symbol wanders by the same fraction AAPL did at $150
+                const double scale = symbol.start_price / 150.0;
+                double current_price = symbol.price + rng.uniform(-2.0, 2.0) * scale;
+                int current_volume = static_cast<int>(500000 + rng.below(1500001));
+                
+                TradingTick tick_data;
+                tick_data.price = current_price;
+                tick_data.volume = current_volume;
+                tick_data.timestamp = timestamp;
+                tick_data.valid = true;
+                tick_data.symbol_index = static_cast<uint16_t>(symbol.index);
+                publish(tick_data);
+                
+                if (tick % 10 == 0) {
+                    logger.printf("Tick %d | %s: $%.2f | Volume: %d | Time: %llu | Ring: %zu | Dropped: %lld", tick,
+                                  symbol.name, current_price, current_volume, static_cast<unsigned long long>(timestamp),
+                                  tick_ring->size(), static_cast<long long>(metrics.value(METRIC_TICKS_DROPPED)));
+                }
+                
+                symbol.price += (rng.uniform(-2.0, 2.0) * 0.1 * scale); // Slow price drift
+                if (symbol.price < symbol.start_price * 2 / 3) symbol.price = symbol.start_price * 2 / 3;
+                if (symbol.price > symbol.start_price * 4 / 3) symbol.price = symbol.start_price * 4 / 3;
             }
             
-            base_price += (price_dist(gen) * 0.1); // Slow price drift
-            if (base_price < 100) base_price = 100;
-            if (base_price > 200) base_price = 200;
+            notify_consumers();
             
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            // Absolute deadlines, so the lateness of each wakeup is the loop's jitter
+            next_wakeup += tick_interval;
+            wait_for_commands(next_wakeup);
+            jitter.add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - next_wakeup).count());
             tick++;
+            if (std::chrono::steady_clock::now() >= next_report) {
+                next_report += report_interval;
+                jitter.report("producer");
+                report_latency(*latency_shm);
+                report_allocations();
+                report_persistence(persister.get());
+                report_commands(command_stats);
+            }
         }
         
+        jitter.report("producer");
+        report_latency(*latency_shm);
+        report_allocations();
+        join_consumers();
+        
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
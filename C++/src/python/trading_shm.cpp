@@ -0,0 +1,557 @@
+// Native Python access to the shared memory segments: batches of ticks
+// and market table snapshots exported through the buffer protocol, so
+// numpy wraps them as structured arrays without copying or building a
+// Python object per tick (see the Native* readers in data_bridge.py).
+//
+//   TickRingReader    single consumer of /trading_ticks. drain() returns a
+//                     view straight into the ring's slots; they stay
+//                     reserved, and the view valid, until the next drain()
+//                     or commit() hands them back to the producer. That
+//                     revokes the batch (len() 0, no new buffers), but
+//                     arrays already made from it keep pointing at slots
+//                     the producer reuses.
+//   BroadcastReader   one of many readers of /trading_broadcast. The writer
+//                     overwrites slots regardless of readers, so poll()
+//                     copies the new ticks out (validated per slot) into a
+//                     buffer the returned batch owns.
+//   MarketTable       seqlock snapshot of every /market_data slot, copied
+//                     into one buffer: a consistent read needs the copy.
+//
+// The GIL is released while a drain, poll, snapshot or wait runs. A reader
+// object is meant for one thread at a time.
+//
+// Build: cmake builds it as trading_shm when Python 3 development headers are found
+// Usage: import trading_shm; np.frombuffer(trading_shm.TickRingReader().drain(), dtype=TICK_DTYPE)
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include "../include/market_data_table.h"
+#include "../include/shared_code.h"
+
+namespace {
+
+// Buffer protocol formats, PEP 3118 struct syntax with field names
+constexpr const char* TICK_FORMAT = "T{<d:price:<Q:timestamp:<i:volume:?:valid:x:<H:symbol_index:<Q:publish_ns:}";
+constexpr const char* MARKET_RECORD_FORMAT = "T{<d:price:<Q:timestamp:<i:volume:?:valid:3x:16s:symbol:}";
+
+// One /market_data slot as handed to Python
+struct MarketRecord {
+    double price;
+    uint64_t timestamp;
+    int32_t volume;
+    bool valid;
+    char padding[3];
+    char symbol[SYMBOL_NAME_SIZE];
+};
+static_assert(sizeof(MarketRecord) == 40 && offsetof(MarketRecord, symbol) == 24, "MARKET_RECORD_FORMAT");
+
+std::chrono::nanoseconds to_timeout(double seconds) {
+    return std::chrono::nanoseconds(static_cast<int64_t>(std::max(0.0, seconds) * 1e9));
+}
+
+// ---------------------------------------------------------------------------
+// Batch: a run of fixed-size records exported as a 1-D read-only buffer.
+// Either a view into a reader's mapping (owner keeps the mapping alive) or
+// a buffer it allocated and frees itself.
+
+struct Batch {
+    PyObject_HEAD
+    PyObject* owner;
+    char* data;
+    bool owns_data;
+    bool revoked;           // a view whose slots went back to the producer
+    Batch** lent;           // the owner's pointer to this view, cleared on dealloc
+    const char* format;
+    Py_ssize_t shape[1];
+    Py_ssize_t strides[1];
+};
+
+// Called with the GIL held, before the view's slots are committed
+void revoke_batch(Batch* batch) {
+    batch->revoked = true;
+    batch->data = nullptr;
+    batch->shape[0] = 0;
+    batch->lent = nullptr;
+}
+
+void batch_dealloc(PyObject* self) {
+    Batch* batch = reinterpret_cast<Batch*>(self);
+    if (batch->lent) {
+        *batch->lent = nullptr;
+    }
+    if (batch->owns_data) {
+        PyMem_RawFree(batch->data);
+    }
+    Py_XDECREF(batch->owner);
+    Py_TYPE(self)->tp_free(self);
+}
+
+int batch_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+    Batch* batch = reinterpret_cast<Batch*>(self);
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "shared memory batches are read-only");
+        view->obj = nullptr;
+        return -1;
+    }
+    if (batch->revoked) {
+        PyErr_SetString(PyExc_BufferError, "batch was handed back to the producer by a later drain() or commit()");
+        view->obj = nullptr;
+        return -1;
+    }
+    view->obj = self;
+    Py_INCREF(self);
+    view->buf = batch->data;
+    view->len = batch->shape[0] * batch->strides[0];
+    view->readonly = 1;
+    view->itemsize = batch->strides[0];
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(batch->format) : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? batch->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? batch->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+Py_ssize_t batch_length(PyObject* self) {
+    return reinterpret_cast<Batch*>(self)->shape[0];
+}
+
+PyBufferProcs batch_buffer_procs = {batch_getbuffer, nullptr};
+PySequenceMethods batch_sequence_methods = {batch_length};
+
+PyTypeObject BatchType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+PyObject* make_batch(PyObject* owner, char* data, bool owns_data, size_t count, size_t record_size,
+                     const char* format) {
+    Batch* batch = PyObject_New(Batch, &BatchType);
+    if (!batch) {
+        if (owns_data) {
+            PyMem_RawFree(data);
+        }
+        return nullptr;
+    }
+    Py_XINCREF(owner);
+    batch->owner = owner;
+    batch->data = data;
+    batch->owns_data = owns_data;
+    batch->revoked = false;
+    batch->lent = nullptr;
+    batch->format = format;
+    batch->shape[0] = static_cast<Py_ssize_t>(count);
+    batch->strides[0] = static_cast<Py_ssize_t>(record_size);
+    return reinterpret_cast<PyObject*>(batch);
+}
+
+// Readers hold their C++ state behind a pointer, created in tp_init
+template<typename State>
+struct ReaderObject {
+    PyObject_HEAD
+    State* state;
+};
+
+template<typename State>
+void reader_dealloc(PyObject* self) {
+    delete reinterpret_cast<ReaderObject<State>*>(self)->state;
+    Py_TYPE(self)->tp_free(self);
+}
+
+template<typename State>
+State* reader_state(PyObject* self) {
+    State* state = reinterpret_cast<ReaderObject<State>*>(self)->state;
+    if (!state) {
+        PyErr_SetString(PyExc_RuntimeError, "reader is not attached");
+    }
+    return state;
+}
+
+// ---------------------------------------------------------------------------
+// TickRingReader
+
+struct TickRingState {
+    std::string name;
+    std::unique_ptr<SharedMemory<TickRing>> shm;
+    WaitPolicy policy = WaitPolicy::from_env();
+    uint64_t reserved = 0;  // slots of the last drain(), returned on the next one or commit()
+    Batch* view = nullptr;  // the batch viewing them, while it is alive
+
+    explicit TickRingState(const std::string& segment)
+        : name(segment), shm(std::make_unique<SharedMemory<TickRing>>(name.c_str(), false)) {}
+
+    // A reader dropped mid-batch returns its slots rather than stalling the producer
+    ~TickRingState() { commit(); }
+
+    // With the GIL held, ahead of commit()
+    void revoke_view() {
+        if (view) {
+            revoke_batch(view);
+            view = nullptr;
+        }
+    }
+
+    void commit() {
+        TickRing& ring = *shm->get();
+        if (reserved) {
+            ring.tail.store(ring.tail.load(std::memory_order_relaxed) + reserved, std::memory_order_release);
+            reserved = 0;
+        }
+    }
+
+    // Commits the previous batch, then reserves the next contiguous run of
+    // slots, waiting up to timeout for one; returns the first slot and count
+    size_t reserve(size_t max_ticks, std::chrono::nanoseconds timeout, size_t& slot) {
+        TickRing& ring = *shm->get();
+        commit();
+        const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        const uint32_t epoch = shm->update_epoch();
+        uint64_t head = ring.head.load(std::memory_order_acquire);
+        if (head == tail && timeout.count() > 0 && shm->wait_for_update(epoch, timeout, policy)) {
+            head = ring.head.load(std::memory_order_acquire);
+        }
+        slot = static_cast<size_t>(tail & TickRing::mask);
+        // A batch never wraps; the wrapped remainder comes with the next drain()
+        reserved = std::min<uint64_t>({head - tail, max_ticks, TickRing::capacity - slot});
+        return static_cast<size_t>(reserved);
+    }
+};
+
+using TickRingObject = ReaderObject<TickRingState>;
+
+int tick_ring_init(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"shm_name", nullptr};
+    const char* name = "/trading_ticks";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|s", const_cast<char**>(keywords), &name)) {
+        return -1;
+    }
+    TickRingObject* object = reinterpret_cast<TickRingObject*>(self);
+    try {
+        if (object->state) {
+            object->state->revoke_view();
+        }
+        delete object->state;
+        object->state = nullptr;
+        object->state = new TickRingState(name);
+    } catch (const std::exception& e) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to attach to tick ring %s: %s", name, e.what());
+        return -1;
+    }
+    return 0;
+}
+
+PyObject* tick_ring_drain(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"max_ticks", "timeout", nullptr};
+    Py_ssize_t max_ticks = TICK_RING_CAPACITY;
+    double timeout = 0.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nd", const_cast<char**>(keywords), &max_ticks, &timeout)) {
+        return nullptr;
+    }
+    TickRingState* state = reader_state<TickRingState>(self);
+    if (!state) {
+        return nullptr;
+    }
+    size_t slot = 0;
+    size_t count = 0;
+    state->revoke_view();
+    Py_BEGIN_ALLOW_THREADS
+    count = state->reserve(static_cast<size_t>(std::max<Py_ssize_t>(0, max_ticks)), to_timeout(timeout), slot);
+    Py_END_ALLOW_THREADS
+    char* data = reinterpret_cast<char*>(&state->shm->get()->slots[slot]);
+    PyObject* batch = make_batch(self, data, false, count, sizeof(TradingTick), TICK_FORMAT);
+    if (batch) {
+        state->view = reinterpret_cast<Batch*>(batch);
+        state->view->lent = &state->view;
+    }
+    return batch;
+}
+
+PyObject* tick_ring_commit(PyObject* self, PyObject*) {
+    TickRingState* state = reader_state<TickRingState>(self);
+    if (!state) {
+        return nullptr;
+    }
+    state->revoke_view();
+    state->commit();
+    Py_RETURN_NONE;
+}
+
+PyObject* tick_ring_pending(PyObject* self, PyObject*) {
+    TickRingState* state = reader_state<TickRingState>(self);
+    if (!state) {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(state->shm->get()->size() - state->reserved);
+}
+
+PyMethodDef tick_ring_methods[] = {
+    {"drain", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(tick_ring_drain)),
+     METH_VARARGS | METH_KEYWORDS,
+     "drain(max_ticks=4096, timeout=0.0) -> batch viewing the next ticks in the ring.\n"
+     "Returns the previous batch's slots to the producer first; waits up to timeout when empty.\n"
+     "That revokes the previous batch, but arrays already made from it are not protected:\n"
+     "the producer overwrites what they point at, so copy() anything kept past the next drain()."},
+    {"commit", tick_ring_commit, METH_NOARGS,
+     "Hand the last drained slots back to the producer now, revoking the batch that viewed them."},
+    {"pending", tick_ring_pending, METH_NOARGS, "Ticks published but not yet drained."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyTypeObject TickRingReaderType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+// ---------------------------------------------------------------------------
+// BroadcastReader
+
+struct BroadcastState {
+    std::string name;
+    std::unique_ptr<SharedMemory<TickBroadcastRing>> shm;
+    std::unique_ptr<TickBroadcastReader> reader;
+
+    explicit BroadcastState(const std::string& segment)
+        : name(segment), shm(std::make_unique<SharedMemory<TickBroadcastRing>>(name.c_str(), false)),
+          reader(std::make_unique<TickBroadcastReader>(*shm)) {}
+};
+
+using BroadcastObject = ReaderObject<BroadcastState>;
+
+int broadcast_init(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"shm_name", nullptr};
+    const char* name = "/trading_broadcast";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|s", const_cast<char**>(keywords), &name)) {
+        return -1;
+    }
+    BroadcastObject* object = reinterpret_cast<BroadcastObject*>(self);
+    try {
+        delete object->state;
+        object->state = nullptr;
+        object->state = new BroadcastState(name);
+    } catch (const std::exception& e) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to attach to broadcast ring %s: %s", name, e.what());
+        return -1;
+    }
+    return 0;
+}
+
+PyObject* broadcast_poll(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"max_ticks", "timeout", nullptr};
+    Py_ssize_t max_ticks = BROADCAST_RING_CAPACITY;
+    double timeout = 0.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nd", const_cast<char**>(keywords), &max_ticks, &timeout)) {
+        return nullptr;
+    }
+    BroadcastState* state = reader_state<BroadcastState>(self);
+    if (!state) {
+        return nullptr;
+    }
+    const size_t capacity = static_cast<size_t>(std::max<Py_ssize_t>(1, max_ticks));
+    TradingTick* ticks = static_cast<TradingTick*>(PyMem_RawMalloc(capacity * sizeof(TradingTick)));
+    if (!ticks) {
+        return PyErr_NoMemory();
+    }
+    size_t count = 0;
+    Py_BEGIN_ALLOW_THREADS
+    count = timeout > 0.0 ? state->reader->wait_and_poll(ticks, capacity, to_timeout(timeout))
+                          : state->reader->poll(ticks, capacity);
+    Py_END_ALLOW_THREADS
+    return make_batch(nullptr, reinterpret_cast<char*>(ticks), true, count, sizeof(TradingTick), TICK_FORMAT);
+}
+
+PyObject* broadcast_lag(PyObject* self, PyObject*) {
+    BroadcastState* state = reader_state<BroadcastState>(self);
+    return state ? PyLong_FromUnsignedLongLong(state->reader->lag()) : nullptr;
+}
+
+PyObject* broadcast_received(PyObject* self, PyObject*) {
+    BroadcastState* state = reader_state<BroadcastState>(self);
+    return state ? PyLong_FromUnsignedLongLong(state->reader->received()) : nullptr;
+}
+
+PyObject* broadcast_dropped(PyObject* self, PyObject*) {
+    BroadcastState* state = reader_state<BroadcastState>(self);
+    return state ? PyLong_FromUnsignedLongLong(state->reader->dropped()) : nullptr;
+}
+
+PyMethodDef broadcast_methods[] = {
+    {"poll", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(broadcast_poll)),
+     METH_VARARGS | METH_KEYWORDS,
+     "poll(max_ticks=4096, timeout=0.0) -> batch of the ticks published since the last poll.\n"
+     "Waits up to timeout when nothing is new; the batch owns its copy."},
+    {"lag", broadcast_lag, METH_NOARGS, "Ticks published but not yet polled."},
+    {"received", broadcast_received, METH_NOARGS, "Ticks polled so far."},
+    {"dropped", broadcast_dropped, METH_NOARGS, "Ticks overwritten before this reader got to them."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyTypeObject BroadcastReaderType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+// ---------------------------------------------------------------------------
+// MarketTable
+
+struct MarketTableState {
+    std::string name;
+    std::unique_ptr<SharedMemory<MarketData>> shm;
+
+    explicit MarketTableState(const std::string& segment)
+        : name(segment), shm(std::make_unique<SharedMemory<MarketData>>(name.c_str(), false)) {}
+
+    void snapshot(MarketRecord* out, uint32_t count) const {
+        const MarketData& table = *shm->get();
+        for (uint32_t i = 0; i < count; ++i) {
+            const TradingTick tick = table.at(static_cast<int32_t>(i)).snapshot();
+            MarketRecord& record = out[i];
+            record.price = tick.price;
+            record.timestamp = tick.timestamp;
+            record.volume = tick.volume;
+            record.valid = tick.valid;
+            std::memset(record.padding, 0, sizeof(record.padding));
+            std::memcpy(record.symbol, table.symbol_at(static_cast<int32_t>(i)), SYMBOL_NAME_SIZE);
+        }
+    }
+};
+
+using MarketTableObject = ReaderObject<MarketTableState>;
+
+int market_table_init(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"shm_name", nullptr};
+    const char* name = "/market_data";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|s", const_cast<char**>(keywords), &name)) {
+        return -1;
+    }
+    MarketTableObject* object = reinterpret_cast<MarketTableObject*>(self);
+    try {
+        delete object->state;
+        object->state = nullptr;
+        object->state = new MarketTableState(name);
+    } catch (const std::exception& e) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to attach to market data table %s: %s", name, e.what());
+        return -1;
+    }
+    return 0;
+}
+
+PyObject* market_table_snapshot(PyObject* self, PyObject*) {
+    MarketTableState* state = reader_state<MarketTableState>(self);
+    if (!state) {
+        return nullptr;
+    }
+    const uint32_t count = state->shm->get()->size();
+    MarketRecord* records = static_cast<MarketRecord*>(PyMem_RawMalloc(std::max<size_t>(1, count) * sizeof(MarketRecord)));
+    if (!records) {
+        return PyErr_NoMemory();
+    }
+    Py_BEGIN_ALLOW_THREADS
+    state->snapshot(records, count);
+    Py_END_ALLOW_THREADS
+    return make_batch(nullptr, reinterpret_cast<char*>(records), true, count, sizeof(MarketRecord),
+                      MARKET_RECORD_FORMAT);
+}
+
+PyObject* market_table_find(PyObject* self, PyObject* args) {
+    const char* symbol = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &symbol)) {
+        return nullptr;
+    }
+    MarketTableState* state = reader_state<MarketTableState>(self);
+    return state ? PyLong_FromLong(state->shm->get()->find(symbol)) : nullptr;
+}
+
+PyObject* market_table_count(PyObject* self, PyObject*) {
+    MarketTableState* state = reader_state<MarketTableState>(self);
+    return state ? PyLong_FromUnsignedLong(state->shm->get()->size()) : nullptr;
+}
+
+PyObject* market_table_wait(PyObject* self, PyObject* args) {
+    double timeout = 1.0;
+    if (!PyArg_ParseTuple(args, "|d", &timeout)) {
+        return nullptr;
+    }
+    MarketTableState* state = reader_state<MarketTableState>(self);
+    if (!state) {
+        return nullptr;
+    }
+    bool updated = false;
+    Py_BEGIN_ALLOW_THREADS
+    updated = state->shm->wait_for_update(state->shm->update_epoch(), to_timeout(timeout), WaitPolicy::from_env());
+    Py_END_ALLOW_THREADS
+    return PyBool_FromLong(updated);
+}
+
+PyMethodDef market_table_methods[] = {
+    {"snapshot", market_table_snapshot, METH_NOARGS,
+     "snapshot() -> batch with a consistent copy of every symbol's latest tick, by slot index."},
+    {"find", market_table_find, METH_VARARGS, "find(symbol) -> slot index, or -1."},
+    {"count", market_table_count, METH_NOARGS, "Number of symbols published so far."},
+    {"wait_for_update", market_table_wait, METH_VARARGS,
+     "wait_for_update(timeout=1.0) -> False if nothing was published before the timeout."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyTypeObject MarketTableType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+// ---------------------------------------------------------------------------
+
+template<typename State>
+bool ready_reader_type(PyTypeObject& type, const char* name, const char* doc, initproc init, PyMethodDef* methods) {
+    type.tp_name = name;
+    type.tp_doc = doc;
+    type.tp_basicsize = sizeof(ReaderObject<State>);
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    type.tp_new = PyType_GenericNew;
+    type.tp_init = init;
+    type.tp_dealloc = reader_dealloc<State>;
+    type.tp_methods = methods;
+    return PyType_Ready(&type) == 0;
+}
+
+PyModuleDef trading_shm_module = {PyModuleDef_HEAD_INIT, "trading_shm",
+                                  "Zero-copy access to the trading system's shared memory segments", -1,
+                                  nullptr, nullptr, nullptr, nullptr, nullptr};
+
+}  // namespace
+
+PyMODINIT_FUNC PyInit_trading_shm() {
+    BatchType.tp_name = "trading_shm.Batch";
+    BatchType.tp_doc = "Read-only run of fixed-size records; wrap with numpy.frombuffer or memoryview";
+    BatchType.tp_basicsize = sizeof(Batch);
+    BatchType.tp_flags = Py_TPFLAGS_DEFAULT;
+    BatchType.tp_dealloc = batch_dealloc;
+    BatchType.tp_as_buffer = &batch_buffer_procs;
+    BatchType.tp_as_sequence = &batch_sequence_methods;
+    if (PyType_Ready(&BatchType) < 0 ||
+        !ready_reader_type<TickRingState>(TickRingReaderType, "trading_shm.TickRingReader",
+                                          "TickRingReader(shm_name='/trading_ticks'): single consumer of the tick ring",
+                                          tick_ring_init, tick_ring_methods) ||
+        !ready_reader_type<BroadcastState>(BroadcastReaderType, "trading_shm.BroadcastReader",
+                                           "BroadcastReader(shm_name='/trading_broadcast'): broadcast ring reader",
+                                           broadcast_init, broadcast_methods) ||
+        !ready_reader_type<MarketTableState>(MarketTableType, "trading_shm.MarketTable",
+                                             "MarketTable(shm_name='/market_data'): market data table snapshots",
+                                             market_table_init, market_table_methods)) {
+        return nullptr;
+    }
+
+    PyObject* module = PyModule_Create(&trading_shm_module);
+    if (!module) {
+        return nullptr;
+    }
+    PyTypeObject* types[] = {&BatchType, &TickRingReaderType, &BroadcastReaderType, &MarketTableType};
+    const char* names[] = {"Batch", "TickRingReader", "BroadcastReader", "MarketTable"};
+    for (size_t i = 0; i < 4; ++i) {
+        Py_INCREF(types[i]);
+        if (PyModule_AddObject(module, names[i], reinterpret_cast<PyObject*>(types[i])) < 0) {
+            Py_DECREF(types[i]);
+            Py_DECREF(module);
+            return nullptr;
+        }
+    }
+    if (PyModule_AddIntConstant(module, "TICK_RECORD_SIZE", sizeof(TradingTick)) < 0 ||
+        PyModule_AddIntConstant(module, "MARKET_RECORD_SIZE", sizeof(MarketRecord)) < 0 ||
+        PyModule_AddIntConstant(module, "TICK_RING_CAPACITY", TICK_RING_CAPACITY) < 0 ||
+        PyModule_AddStringConstant(module, "TICK_FORMAT", TICK_FORMAT) < 0 ||
+        PyModule_AddStringConstant(module, "MARKET_RECORD_FORMAT", MARKET_RECORD_FORMAT) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,328 @@
+// Bulk importer: converts the market_data/{stocks,forex,crypto}/*.csv tree
+// into binary tick stores (<symbol>.ticks, see tick_store.h).
+//
+// Each CSV is memory-mapped, delimiters are located with the vectorized
+// scanner in csv_scanner.h and numbers are parsed in place with
+// std::from_chars. Files are converted in parallel, one per worker.
+//
+// Build: g++ -std=c++17 -O3 -o csv_import tools/csv_import.cpp -pthread
+// Usage: csv_import <market_data_dir> [-o <output_dir>] [-j <threads>] [--sync]
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/csv_scanner.h"
+#include "../include/tick_store.h"
+
+namespace fs = std::filesystem;
+
+constexpr uint64_t NANOS_PER_SECOND = 1'000'000'000ull;
+constexpr size_t IMPORT_CHUNK_SIZE = 256 * 1024;
+
+// Read-only mapping of a whole file
+class MappedFile {
+private:
+    const char* data_;
+    size_t size_;
+
+public:
+    explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Failed to open " + path + ": " + strerror(errno));
+        }
+        struct stat st{};
+        if (fstat(fd, &st) == -1) {
+            close(fd);
+            throw std::runtime_error("Failed to stat " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* memory = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+            if (memory == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Failed to map " + path + ": " + strerror(errno));
+            }
+            madvise(memory, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(memory);
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+struct ImportJob {
+    std::string csv_path;
+    std::string store_path;
+    std::string symbol;
+    bool sync = false;  // msync the store before reporting success
+};
+
+struct ImportResult {
+    size_t bytes = 0;
+    size_t rows = 0;
+    size_t skipped = 0;     // malformed rows
+    size_t duplicates = 0;  // rows sharing a timestamp with a later row
+    std::string error;
+};
+
+// Column order of the legacy header; any order is accepted, matched by name
+enum CsvField { FIELD_TIMESTAMP, FIELD_OPEN, FIELD_HIGH, FIELD_LOW, FIELD_CLOSE, FIELD_VOLUME, FIELD_PRICE, FIELD_COUNT };
+constexpr const char* CSV_FIELD_NAMES[FIELD_COUNT] = {"timestamp", "open", "high", "low", "close", "volume", "price"};
+
+inline bool parse_double(const char* begin, const char* end, double& out) {
+    const auto result = std::from_chars(begin, end, out);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+// Integer seconds is the common case; fractional seconds are accepted too
+inline bool parse_timestamp(const char* begin, const char* end, uint64_t& out_ns) {
+    uint64_t seconds = 0;
+    const auto result = std::from_chars(begin, end, seconds);
+    if (result.ec == std::errc() && result.ptr == end) {
+        out_ns = seconds * NANOS_PER_SECOND;
+        return true;
+    }
+    double fractional = 0.0;
+    if (!parse_double(begin, end, fractional) || fractional < 0) {
+        return false;
+    }
+    out_ns = static_cast<uint64_t>(fractional * NANOS_PER_SECOND);
+    return true;
+}
+
+ImportResult import_csv(const ImportJob& job) {
+    ImportResult result;
+    MappedFile file(job.csv_path);
+    const char* data = file.data();
+    result.bytes = file.size();
+    if (result.bytes == 0) {
+        result.error = "empty file";
+        return result;
+    }
+
+    // Header line: map its columns to the fields we store
+    const char* header_newline = static_cast<const char*>(std::memchr(data, '\n', result.bytes));
+    const size_t header_end = header_newline ? static_cast<size_t>(header_newline - data) : result.bytes;
+    std::vector<size_t> delimiters;
+    delimiters.reserve(IMPORT_CHUNK_SIZE / 4);
+    scan_csv_structurals(data, header_end, delimiters);
+    delimiters.push_back(header_end);
+
+    int column_to_field[64];
+    std::fill(std::begin(column_to_field), std::end(column_to_field), -1);
+    size_t pos = 0;
+    int column = 0;
+    for (const size_t delimiter : delimiters) {
+        size_t end = delimiter;
+        if (end > pos && data[end - 1] == '\r') {
+            --end;
+        }
+        for (int f = 0; f < FIELD_COUNT && column < 64; ++f) {
+            if (end - pos == std::strlen(CSV_FIELD_NAMES[f]) &&
+                std::memcmp(data + pos, CSV_FIELD_NAMES[f], end - pos) == 0) {
+                column_to_field[column] = f;
+            }
+        }
+        ++column;
+        pos = delimiter + 1;
+    }
+    if (std::find(std::begin(column_to_field), std::end(column_to_field), FIELD_TIMESTAMP) == std::end(column_to_field) ||
+        std::find(std::begin(column_to_field), std::end(column_to_field), FIELD_PRICE) == std::end(column_to_field)) {
+        result.error = "header lacks timestamp/price columns";
+        return result;
+    }
+
+    std::vector<TickRecord> records;
+    records.reserve(result.bytes / (8 * static_cast<size_t>(column)));
+
+    // Rows are scanned a chunk at a time so the delimiter buffer stays in
+    // cache; parse state carries across chunk boundaries
+    TickRecord record;
+    unsigned seen = 0;  // bitmask of fields parsed for the current row
+    bool row_ok = true;
+    column = 0;
+    for (size_t chunk = pos; chunk < result.bytes; chunk += IMPORT_CHUNK_SIZE) {
+        const size_t chunk_size = std::min(IMPORT_CHUNK_SIZE, result.bytes - chunk);
+        delimiters.clear();
+        scan_csv_structurals(data + chunk, chunk_size, delimiters, chunk);
+        if (chunk + chunk_size == result.bytes && data[result.bytes - 1] != '\n') {
+            delimiters.push_back(result.bytes);  // last line without a trailing newline
+        }
+
+        for (const size_t delimiter : delimiters) {
+            size_t end = delimiter;
+            const bool line_end = end == result.bytes || data[end] == '\n';
+            if (end > pos && data[end - 1] == '\r') {
+                --end;
+            }
+
+            const bool blank_line = line_end && column == 0 && end == pos;
+            const int field = column < 64 ? column_to_field[column] : -1;
+            if (field == FIELD_TIMESTAMP && !blank_line) {
+                row_ok &= parse_timestamp(data + pos, data + end, record.timestamp);
+            } else if (field >= 0) {
+                double* target = &record.open + (field - FIELD_OPEN);
+                // Price-only feeds may leave OHLC empty; fill them from price below
+                if (end > pos) {
+                    row_ok &= parse_double(data + pos, data + end, *target);
+                }
+            }
+            if (field >= 0 && end > pos) {
+                seen |= 1u << field;
+            }
+            ++column;
+            pos = delimiter + 1;
+
+            if (line_end) {
+                if (!blank_line) {
+                    const bool complete = (seen & (1u << FIELD_TIMESTAMP)) && (seen & (1u << FIELD_PRICE));
+                    if (row_ok && complete) {
+                        for (int f = FIELD_OPEN; f <= FIELD_CLOSE; ++f) {
+                            if (!(seen & (1u << f))) {
+                                (&record.open)[f - FIELD_OPEN] = record.price;
+                            }
+                        }
+                        records.push_back(record);
+                    } else {
+                        ++result.skipped;
+                    }
+                }
+                record = TickRecord{};
+                seen = 0;
+                row_ok = true;
+                column = 0;
+            }
+        }
+    }
+
+    // Stores must be sorted for range lookups; re-fetched rows repeat timestamps
+    const auto by_time = [](const TickRecord& a, const TickRecord& b) { return a.timestamp < b.timestamp; };
+    if (!std::is_sorted(records.begin(), records.end(), by_time)) {
+        std::stable_sort(records.begin(), records.end(), by_time);
+    }
+    std::vector<TickRecord> unique;
+    unique.reserve(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (i + 1 < records.size() && records[i + 1].timestamp == records[i].timestamp) {
+            ++result.duplicates;  // keep the most recently written row
+            continue;
+        }
+        unique.push_back(records[i]);
+    }
+
+    unlink(job.store_path.c_str());
+    TickStoreWriter writer(job.store_path, job.symbol.c_str(), std::max<size_t>(unique.size(), 1));
+    writer.append_batch(unique.data(), unique.size());
+    if (job.sync) {
+        writer.flush();
+    }
+    result.rows = unique.size();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <market_data_dir> [-o <output_dir>] [-j <threads>] [--sync]" << std::endl;
+        return 1;
+    }
+
+    const fs::path input_dir = argv[1];
+    fs::path output_dir = input_dir;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool sync = false;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sync") == 0) {
+            sync = true;
+        } else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_dir = argv[++i];
+        } else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        }
+    }
+
+    std::vector<ImportJob> jobs;
+    try {
+        for (const auto& entry : fs::recursive_directory_iterator(input_dir)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".csv") {
+                continue;
+            }
+            const fs::path relative = fs::relative(entry.path(), input_dir);
+            const fs::path store_path = (output_dir / relative).replace_extension(".ticks");
+            fs::create_directories(store_path.parent_path());
+            jobs.push_back({entry.path().string(), store_path.string(), entry.path().stem().string(), sync});
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Importing " << jobs.size() << " CSV files with " << threads << " threads" << std::endl;
+
+    std::vector<ImportResult> results(jobs.size());
+    std::atomic<size_t> next_job{0};
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < std::min<size_t>(threads, jobs.size()); ++t) {
+        workers.emplace_back([&] {
+            for (size_t j = next_job.fetch_add(1); j < jobs.size(); j = next_job.fetch_add(1)) {
+                try {
+                    results[j] = import_csv(jobs[j]);
+                } catch (const std::exception& e) {
+                    results[j].error = e.what();
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t total_bytes = 0;
+    size_t total_rows = 0;
+    int failures = 0;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const ImportResult& r = results[j];
+        if (!r.error.empty()) {
+            std::cerr << "✗ " << jobs[j].csv_path << ": " << r.error << std::endl;
+            ++failures;
+            continue;
+        }
+        total_bytes += r.bytes;
+        total_rows += r.rows;
+        std::cout << "✓ " << jobs[j].symbol << ": " << r.rows << " rows"
+                  << " (" << r.skipped << " malformed, " << r.duplicates << " duplicate timestamps)"
+                  << " -> " << jobs[j].store_path << std::endl;
+    }
+
+    std::cout << "Imported " << total_rows << " rows, " << total_bytes << " bytes in "
+              << std::fixed << std::setprecision(3) << seconds * 1000 << " ms ("
+              << std::setprecision(2) << (seconds > 0 ? total_bytes / seconds / 1e9 : 0.0) << " GB/s)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+// Generates Python/segment_layouts.py from the SegmentLayout descriptions,
+// so the Python readers check the exact header the C++ producer writes.
+// Rerun after changing any shared layout:
+//
+// Build: g++ -std=c++17 -O2 -o gen_segment_layouts tools/gen_segment_layouts.cpp
+// Usage: gen_segment_layouts > ../../Python/segment_layouts.py
+
+#include <cstdio>
+#include "../include/shared_code.h"
+#include "../include/market_data_table.h"
+#include "../include/indicators.h"
+#include "../include/latency.h"
+#include "../include/order_book.h"
+#include "../include/command_queue.h"
+#include "../include/metrics.h"
+
+void print_layout(const SegmentHeader& header) {
+    std::printf("    '%s': SegmentLayout(\n", header.type_name);
+    std::printf("        layout_hash=0x%016llx,\n", static_cast<unsigned long long>(header.layout_hash));
+    std::printf("        payload_size=%u,\n", header.payload_size);
+    std::printf("        record_size=%u,\n", header.record_size);
+    std::printf("        capacity=%u,\n", header.capacity);
+    std::printf("        fields={\n");
+    for (uint32_t i = 0; i < header.field_count; ++i) {
+        std::printf("            '%s': (%u, %u),\n", header.fields[i].name, header.fields[i].offset, header.fields[i].size);
+    }
+    std::printf("        },\n");
+    std::printf("    ),\n");
+}
+
+int main() {
+    std::printf(R"py(#!/usr/bin/env python3
+"""
+Segment Layouts - GENERATED by C++/src/tools/gen_segment_layouts.cpp, do not edit
+Expected SegmentHeader contents (segment_header.h) for every shared memory segment
+"""
+import struct
+from typing import Dict, NamedTuple, Tuple
+
+SEGMENT_MAGIC = b'%.8s'
+SEGMENT_VERSION = %u
+SEGMENT_HEADER_SIZE = %zu
+SEGMENT_HEADER_FORMAT = '8sIIQIIIIII32s48x'  # magic, version, header_size, layout_hash, payload_offset,
+                                             # payload_size, record_size, capacity, field_count, reserved, type_name
+SEGMENT_FIELD_FORMAT = '24sII'               # name, offset, size
+SEGMENT_FIELDS_OFFSET = struct.calcsize(SEGMENT_HEADER_FORMAT)
+SEGMENT_FIELD_SIZE = struct.calcsize(SEGMENT_FIELD_FORMAT)
+
+class SegmentLayout(NamedTuple):
+    layout_hash: int
+    payload_size: int
+    record_size: int
+    capacity: int
+    fields: Dict[str, Tuple[int, int]]  # name -> (offset, size)
+
+class SegmentLayoutError(ValueError):
+    """The segment was created with a layout this reader does not understand"""
+
+LAYOUTS = {
+)py", SEGMENT_MAGIC, SEGMENT_VERSION, SEGMENT_HEADER_SIZE);
+
+    print_layout(make_segment_header<TradingData>());
+    print_layout(make_segment_header<TickRing>());
+    print_layout(make_segment_header<TickBroadcastRing>());
+    print_layout(make_segment_header<MarketData>());
+    print_layout(make_segment_header<Indicators>());
+    print_layout(make_segment_header<LatencyTable>());
+    print_layout(make_segment_header<OrderRing>());
+    print_layout(make_segment_header<OrderBooks>());
+    print_layout(make_segment_header<CommandRing>());
+    print_layout(make_segment_header<MetricsTable>());
+
+    std::fputs(R"py(}
+
+def read_segment_header(buffer) -> Dict:
+    """Decode the SegmentHeader at the start of buffer (the segment's first page)"""
+    (magic, version, header_size, layout_hash, payload_offset, payload_size, record_size,
+     capacity, field_count, _, type_name) = struct.unpack_from(SEGMENT_HEADER_FORMAT, buffer, 0)
+    fields = {}
+    for i in range(min(field_count, (header_size - SEGMENT_FIELDS_OFFSET) // SEGMENT_FIELD_SIZE)):
+        name, offset, size = struct.unpack_from(SEGMENT_FIELD_FORMAT, buffer, SEGMENT_FIELDS_OFFSET + i * SEGMENT_FIELD_SIZE)
+        fields[name.rstrip(b'\0').decode()] = (offset, size)
+    return {
+        'magic': magic, 'version': version, 'header_size': header_size, 'layout_hash': layout_hash,
+        'payload_offset': payload_offset, 'payload_size': payload_size, 'record_size': record_size,
+        'capacity': capacity, 'type_name': type_name.rstrip(b'\0').decode(), 'fields': fields,
+    }
+
+def check_segment(buffer, type_name: str) -> Dict:
+    """Header of buffer if it holds the layout this module was generated for; raises SegmentLayoutError otherwise"""
+    header = read_segment_header(buffer)
+    if header['magic'] != SEGMENT_MAGIC:
+        raise SegmentLayoutError("no segment header (not initialized, or an older producer)")
+    if header['version'] != SEGMENT_VERSION or header['payload_offset'] != SEGMENT_HEADER_SIZE:
+        raise SegmentLayoutError(f"segment header version {header['version']}, expected {SEGMENT_VERSION}")
+    expected = LAYOUTS[type_name]
+    if header['layout_hash'] != expected.layout_hash or header['payload_size'] != expected.payload_size:
+        raise SegmentLayoutError(
+            f"layout mismatch: segment holds {header['type_name']} ({header['payload_size']} bytes), "
+            f"expected {type_name} ({expected.payload_size} bytes) - regenerate segment_layouts.py")
+    return header
+)py", stdout);
+    return 0;
+}
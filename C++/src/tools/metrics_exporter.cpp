@@ -0,0 +1,235 @@
+// Prometheus exporter: serves /trading_metrics (per-thread counters,
+// gauges and batch-time histograms, see metrics.h) and the per-consumer
+// tick latency histograms of /trading_latency as Prometheus text on
+// http://<address>:<port>/metrics.
+//
+// Runs as its own process, so scrapes cost trading_app nothing but the
+// cache misses of reading its slots. The segments are attached afresh for
+// every scrape: a restarted trading_app is picked up without restarting
+// the exporter, and trading_up reports 0 while it is not running.
+//
+// Build: g++ -std=c++17 -O3 -o metrics_exporter tools/metrics_exporter.cpp -pthread
+// Usage: metrics_exporter [--port 9464] [--address 0.0.0.0]
+
+#include <arpa/inet.h>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/shared_code.h"
+#include "../include/latency.h"
+#include "../include/metrics.h"
+
+namespace {
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void handle_signal(int) { stop_requested = 1; }
+
+// Exported histogram buckets: every power of two from 1 us to ~17 s. The
+// log-linear buckets split exactly at powers of two, so each is exact.
+constexpr size_t EXPORT_FIRST_BUCKET_BITS = 10;
+constexpr size_t EXPORT_LAST_BUCKET_BITS = 34;
+
+std::string label_value(const char* text, size_t size) {
+    std::string value;
+    for (size_t i = 0; i < size && text[i] != '\0'; ++i) {
+        if (text[i] == '"' || text[i] == '\\') {
+            value += '\\';
+        }
+        value += text[i];
+    }
+    return value;
+}
+
+void write_histogram(std::ostream& out, const char* name, const std::string& labels, const LatencyHistogram& histogram) {
+    uint64_t cumulative = 0;
+    size_t bucket = 0;
+    for (size_t bits = EXPORT_FIRST_BUCKET_BITS; bits <= EXPORT_LAST_BUCKET_BITS; ++bits) {
+        const uint64_t bound = uint64_t{1} << bits;
+        for (; bucket < LATENCY_BUCKET_COUNT && latency_bucket_upper(bucket) < bound; ++bucket) {
+            cumulative += histogram.buckets[bucket].load(std::memory_order_relaxed);
+        }
+        out << name << "_bucket{" << labels << ",le=\"" << bound / 1e9 << "\"} " << cumulative << "\n";
+    }
+    for (; bucket < LATENCY_BUCKET_COUNT; ++bucket) {
+        cumulative += histogram.buckets[bucket].load(std::memory_order_relaxed);
+    }
+    out << name << "_bucket{" << labels << ",le=\"+Inf\"} " << cumulative << "\n";
+    out << name << "_sum{" << labels << "} " << histogram.total_ns.load(std::memory_order_relaxed) / 1e9 << "\n";
+    out << name << "_count{" << labels << "} " << cumulative << "\n";
+}
+
+void write_metrics(std::ostream& out, const MetricsTable& table) {
+    std::string labels[METRICS_MAX_THREADS];
+    for (size_t t = 0; t < METRICS_MAX_THREADS; ++t) {
+        const MetricsSlot& slot = table.threads[t];
+        const int32_t pid = slot.pid.load(std::memory_order_acquire);
+        if (pid != 0) {
+            labels[t] = "thread=\"" + label_value(slot.name, METRICS_NAME_SIZE) + "\",pid=\"" + std::to_string(pid) + "\"";
+        }
+    }
+
+    for (uint32_t id = 0; id < METRIC_COUNT; ++id) {
+        const MetricInfo& info = METRIC_INFO[id];
+        bool described = false;
+        for (size_t t = 0; t < METRICS_MAX_THREADS; ++t) {
+            const MetricsSlot& slot = table.threads[t];
+            if (labels[t].empty() || !(slot.used.load(std::memory_order_acquire) & (uint64_t{1} << id))) {
+                continue;
+            }
+            if (!described) {
+                out << "# HELP " << info.name << " " << info.help << "\n";
+                out << "# TYPE " << info.name << " " << (info.kind == MetricKind::Counter ? "counter" : "gauge") << "\n";
+                described = true;
+            }
+            out << info.name << "{" << labels[t] << "} " << slot.values[id].load(std::memory_order_relaxed) << "\n";
+        }
+    }
+
+    out << "# HELP trading_batch_duration_seconds Time each thread spent on one batch\n";
+    out << "# TYPE trading_batch_duration_seconds histogram\n";
+    for (size_t t = 0; t < METRICS_MAX_THREADS; ++t) {
+        if (!labels[t].empty()) {
+            write_histogram(out, "trading_batch_duration_seconds", labels[t], table.threads[t].batch);
+        }
+    }
+}
+
+void write_latency(std::ostream& out, const LatencyTable& table) {
+    out << "# HELP trading_tick_latency_seconds Publish-to-consume latency of each tick consumer\n";
+    out << "# TYPE trading_tick_latency_seconds histogram\n";
+    for (const auto& histogram : table.consumers) {
+        const int32_t pid = histogram.pid.load(std::memory_order_acquire);
+        if (pid == 0) {
+            continue;
+        }
+        const std::string labels = "consumer=\"" + label_value(histogram.name, LATENCY_NAME_SIZE) + "\",pid=\"" +
+                                   std::to_string(pid) + "\"";
+        write_histogram(out, "trading_tick_latency_seconds", labels, histogram);
+    }
+}
+
+std::string scrape(const MappingOptions& options) {
+    std::ostringstream out;
+    bool up = true;
+    try {
+        SharedMemory<MetricsTable> metrics("/trading_metrics", false, options);
+        write_metrics(out, *metrics.get());
+    } catch (const std::exception&) {
+        up = false;
+    }
+    try {
+        SharedMemory<LatencyTable> latency("/trading_latency", false, options);
+        write_latency(out, *latency.get());
+    } catch (const std::exception&) {
+        up = false;
+    }
+    out << "# HELP trading_up Whether the trading_app segments could be read\n";
+    out << "# TYPE trading_up gauge\n";
+    out << "trading_up " << (up ? 1 : 0) << "\n";
+    return out.str();
+}
+
+void send_all(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+// One request per connection, answered and closed; scrapes are seconds apart
+void serve(int client, const MappingOptions& options) {
+    timeval timeout{1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    char request[2048];
+    size_t used = 0;
+    while (used < sizeof(request) - 1) {
+        const ssize_t n = recv(client, request + used, sizeof(request) - 1 - used, 0);
+        if (n <= 0) {
+            break;
+        }
+        used += static_cast<size_t>(n);
+        request[used] = '\0';
+        if (std::strstr(request, "\r\n\r\n")) {
+            break;
+        }
+    }
+    request[used] = '\0';
+
+    std::string status = "200 OK";
+    std::string body;
+    if (std::strncmp(request, "GET /metrics", 12) == 0 && (request[12] == ' ' || request[12] == '?')) {
+        body = scrape(options);
+    } else if (std::strncmp(request, "GET ", 4) == 0) {
+        status = "404 Not Found";
+        body = "Metrics are at /metrics\n";
+    } else {
+        status = "405 Method Not Allowed";
+        body = "Only GET is supported\n";
+    }
+    send_all(client, "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                     "Content-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int port = 9464;
+    std::string address = "0.0.0.0";
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--port") == 0 && has_value) {
+            port = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--address") == 0 && has_value) {
+            address = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--port 9464] [--address 0.0.0.0]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+    const MappingOptions options = MappingOptions::from_env();
+
+    const int listener = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    const int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in bind_address{};
+    bind_address.sin_family = AF_INET;
+    bind_address.sin_port = htons(static_cast<uint16_t>(port));
+    if (listener == -1 || inet_pton(AF_INET, address.c_str(), &bind_address.sin_addr) != 1 ||
+        bind(listener, reinterpret_cast<sockaddr*>(&bind_address), sizeof(bind_address)) == -1 ||
+        listen(listener, 16) == -1) {
+        std::cerr << "Error: cannot listen on " << address << ":" << port << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cout << "✓ Serving metrics on http://" << address << ":" << port << "/metrics" << std::endl;
+
+    while (!stop_requested) {
+        pollfd ready{listener, POLLIN, 0};
+        if (poll(&ready, 1, 200) <= 0) {
+            continue;
+        }
+        const int client = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client == -1) {
+            continue;
+        }
+        serve(client, options);
+        close(client);
+    }
+    close(listener);
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Archiver: compresses binary tick stores (<symbol>.ticks, see tick_store.h)
+// into block-compressed archives (<symbol>.tka, see tick_archive.h) for
+// long-term history. A directory is walked recursively and every store
+// found is archived next to it, or under -o with the same layout.
+//
+// Blocks are encoded by -j workers per file; --verify decodes each archive
+// again, in parallel, and compares every column bit for bit.
+//
+// Build: g++ -std=c++17 -O3 -o tick_archive tools/tick_archive.cpp -pthread
+// Usage: tick_archive <market_data_dir | store.ticks> [-o <output_dir>] [-j <threads>] [--block <records>] [--verify] [--sync]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/tick_archive.h"
+#include "../include/tick_store.h"
+
+namespace fs = std::filesystem;
+
+struct ArchiveJob {
+    std::string store_path;
+    std::string archive_path;
+};
+
+struct ArchiveResult {
+    uint64_t records = 0;
+    size_t raw_bytes = 0;       // column bytes the store holds for those records
+    size_t archive_bytes = 0;
+    double encode_seconds = 0.0;
+    double decode_seconds = 0.0;
+};
+
+template<typename T>
+bool same_bits(const ColumnSpan<T>& a, const std::vector<T>& b) {
+    return a.size == b.size() && std::memcmp(a.data, b.data(), a.size * sizeof(T)) == 0;
+}
+
+ArchiveResult archive_store(const ArchiveJob& job, uint32_t block_records, unsigned threads, bool verify, bool sync) {
+    ArchiveResult result;
+    TickStoreReader store(job.store_path);
+    const TickRange all = store.slice(0, store.size());
+    result.records = all.size();
+    result.raw_bytes = all.size() * TICK_STORE_COLUMN_COUNT * sizeof(uint64_t);
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        TickArchiveWriter writer(job.archive_path, store.symbol(), block_records);
+        compress_tick_range(all, writer, threads);
+        writer.finish(sync);
+        result.archive_bytes = writer.bytes();
+    }
+    result.encode_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (verify) {
+        TickArchiveReader archive(job.archive_path);
+        const auto decode_start = std::chrono::steady_clock::now();
+        const TickColumns decoded = archive.decode_all(threads);
+        result.decode_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - decode_start).count();
+        if (!same_bits(all.timestamp, decoded.timestamp) || !same_bits(all.open, decoded.open) ||
+            !same_bits(all.high, decoded.high) || !same_bits(all.low, decoded.low) ||
+            !same_bits(all.close, decoded.close) || !same_bits(all.volume, decoded.volume) ||
+            !same_bits(all.price, decoded.price)) {
+            throw std::runtime_error("decoded archive differs from the store");
+        }
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <market_data_dir | store.ticks> [-o <output_dir>] [-j <threads>] "
+                  << "[--block <records>] [--verify] [--sync]" << std::endl;
+        return 1;
+    }
+
+    const fs::path input = argv[1];
+    fs::path output_dir;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t block_records = TICK_ARCHIVE_BLOCK_RECORDS;
+    bool verify = false;
+    bool sync = false;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--verify") == 0) {
+            verify = true;
+        } else if (std::strcmp(argv[i], "--sync") == 0) {
+            sync = true;
+        } else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_dir = argv[++i];
+        } else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            block_records = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        }
+    }
+
+    std::vector<ArchiveJob> jobs;
+    try {
+        const bool single = fs::is_regular_file(input);
+        const fs::path root = single ? input.parent_path() : input;
+        auto add_job = [&](const fs::path& store_path) {
+            fs::path archive_path = output_dir.empty() ? store_path : output_dir / fs::relative(store_path, root);
+            archive_path.replace_extension(".tka");
+            fs::create_directories(archive_path.parent_path());
+            jobs.push_back({store_path.string(), archive_path.string()});
+        };
+        if (single) {
+            add_job(input);
+        } else {
+            for (const auto& entry : fs::recursive_directory_iterator(input)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".ticks") {
+                    add_job(entry.path());
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Archiving " << jobs.size() << " tick stores, " << block_records << " records per block, "
+              << threads << " threads" << std::endl;
+
+    size_t total_records = 0;
+    size_t total_raw = 0;
+    size_t total_archived = 0;
+    double total_encode = 0.0;
+    int failures = 0;
+    for (const ArchiveJob& job : jobs) {
+        try {
+            const ArchiveResult r = archive_store(job, block_records, threads, verify, sync);
+            total_records += r.records;
+            total_raw += r.raw_bytes;
+            total_archived += r.archive_bytes;
+            total_encode += r.encode_seconds;
+            std::cout << "✓ " << job.store_path << ": " << r.records << " records, " << r.raw_bytes << " -> "
+                      << r.archive_bytes << " bytes (" << std::fixed << std::setprecision(2)
+                      << (r.archive_bytes ? static_cast<double>(r.raw_bytes) / r.archive_bytes : 0.0) << "x)";
+            if (verify) {
+                std::cout << " verified, decode " << std::setprecision(0)
+                          << (r.decode_seconds > 0 ? r.records / r.decode_seconds / 1e6 : 0.0) << "M records/s";
+            }
+            std::cout << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "✗ " << job.store_path << ": " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+
+    std::cout << "Archived " << total_records << " records, " << total_raw << " -> " << total_archived << " bytes ("
+              << std::fixed << std::setprecision(2)
+              << (total_archived ? static_cast<double>(total_raw) / total_archived : 0.0) << "x) in "
+              << std::setprecision(3) << total_encode * 1000 << " ms" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
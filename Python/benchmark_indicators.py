@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+Benchmark Indicators - pandas baseline for the C++ batch kernels (batch_kernels.h)
+Times returns, rolling mean/variance and OHLC resampling the way data_bridge.py
+code does them today, on the same synthetic series as `batch_indicators --bench`
+or on an existing tick store, and prints M rows/s in the same layout.
+
+Usage: python3 benchmark_indicators.py [--rows N] [--store path.ticks] [--window W] [--bar-seconds S]
+"""
+import argparse
+import time
+
+import numpy as np
+import pandas as pd
+
+from tick_store import TickStore, NANOS_PER_SECOND
+
+def synthetic_frame(rows: int) -> pd.DataFrame:
+    """Geometric random walk at one tick per 100 ms, like batch_indicators --bench"""
+    rng = np.random.default_rng(42)
+    prices = 104500.0 * np.exp(np.cumsum(rng.normal(0.0, 0.0005, rows)))
+    timestamps = 1_700_000_000 * NANOS_PER_SECOND + np.arange(rows, dtype=np.int64) * (NANOS_PER_SECOND // 10)
+    return pd.DataFrame({
+        'timestamp': timestamps,
+        'open': prices, 'high': prices, 'low': prices, 'close': prices,
+        'volume': rng.uniform(1.0, 1000.0, rows),
+        'price': prices,
+    })
+
+def store_frame(path: str) -> pd.DataFrame:
+    """Every record of a tick store, timestamps kept in nanoseconds"""
+    store = TickStore(path)
+    return pd.DataFrame({name: np.array(values) for name, values in store.columns().items()})
+
+def best_of(fn, runs: int = 5) -> float:
+    best = float('inf')
+    for _ in range(runs):
+        start = time.perf_counter()
+        fn()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--rows', type=int, default=5_000_000)
+    parser.add_argument('--store', help='benchmark an existing .ticks file instead of synthetic data')
+    parser.add_argument('--window', type=int, default=20)
+    parser.add_argument('--bar-seconds', type=int, default=60)
+    args = parser.parse_args()
+
+    df = store_frame(args.store) if args.store else synthetic_frame(args.rows)
+    rows = len(df)
+    prices = df['price']
+    indexed = df.set_index(pd.to_datetime(df['timestamp'], unit='ns'))
+    rule = f"{args.bar_seconds}s"
+
+    def resample():
+        bars = indexed['high'].resample(rule).max().to_frame()
+        bars['low'] = indexed['low'].resample(rule).min()
+        bars['open'] = indexed['open'].resample(rule).first()
+        bars['close'] = indexed['close'].resample(rule).last()
+        bars['volume'] = indexed['volume'].resample(rule).sum()
+        return bars.dropna()
+
+    timings = {
+        'returns': best_of(lambda: prices.pct_change()),
+        'rolling': best_of(lambda: (prices.rolling(args.window).mean(), prices.rolling(args.window).var())),
+        'resample': best_of(resample),
+    }
+
+    print(f"Benchmark: {rows} rows, window {args.window}, {args.bar_seconds}s bars, pandas {pd.__version__}")
+    print(f"{'path':<8}" + ''.join(f"{name:>14}" for name in timings) + "   (M rows/s)")
+    print(f"{'pandas':<8}" + ''.join(f"{rows / seconds / 1e6:>14.1f}" for seconds in timings.values()))
+
+if __name__ == "__main__":
+    main()
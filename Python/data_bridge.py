@@ -6,26 +6,450 @@ Handles shared memory communication and provides API for data access
 import mmap
 import struct
 import os
+import sys
 import json
+import numpy as np
 import pandas as pd
 import time
 from datetime import datetime
 from typing import Dict, List, Optional, Any
 import requests
 import threading
+import fcntl
+import ctypes
+import platform
+from tick_store import TickStore, tick_store_path, NANOS_PER_SECOND
+from segment_layouts import LAYOUTS, SEGMENT_HEADER_SIZE, SegmentLayoutError, check_segment
+
+# Optional native extension (C++/src/python/trading_shm.cpp), built next to trading_app
+NATIVE_MODULE_DIR = os.environ.get('TRADING_NATIVE_DIR',
+                                   os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'C++', 'build'))
+if os.path.isdir(NATIVE_MODULE_DIR) and NATIVE_MODULE_DIR not in sys.path:
+    sys.path.append(NATIVE_MODULE_DIR)
+try:
+    import trading_shm
+except ImportError:
+    trading_shm = None
+
+# Offsets below are relative to the payload; map_segment() checks the segment header page
+# in front of it against segment_layouts.py and maps from SEGMENT_HEADER_SIZE onwards
+
+# Layout of TradingData in trading_system.h: sequence, price, timestamp, volume, valid
+TRADING_DATA_FORMAT = 'QdQi?3x'
+TRADING_DATA_SIZE = struct.calcsize(TRADING_DATA_FORMAT)
+SEQLOCK_MAX_RETRIES = 10000
+
+# Layout of TickRing (SharedRingBuffer<TradingTick, 4096>) in shared_code.h
+CACHE_LINE_SIZE = 64
+TICK_RING_CAPACITY = 4096
+TICK_FORMAT = 'dQi?xHQ'  # price, timestamp (ns), volume, valid, symbol_index, publish_ns (CLOCK_MONOTONIC)
+TICK_SIZE = struct.calcsize(TICK_FORMAT)
+TICK_RING_HEAD_OFFSET = 0
+TICK_RING_TAIL_OFFSET = CACHE_LINE_SIZE
+TICK_RING_SLOTS_OFFSET = 2 * CACHE_LINE_SIZE
+TICK_RING_SIZE = TICK_RING_SLOTS_OFFSET + TICK_RING_CAPACITY * TICK_SIZE
+TICK_DTYPE = np.dtype({'names': ['price', 'timestamp', 'volume', 'valid', 'symbol_index', 'publish_ns'],
+                       'formats': ['<f8', '<u8', '<i4', '?', '<u2', '<u8'],
+                       'offsets': [0, 8, 16, 20, 22, 24], 'itemsize': TICK_SIZE})
+
+# Layout of TickBroadcastRing (SharedBroadcastRing<TradingTick, 4096, 16>)
+BROADCAST_RING_CAPACITY = 4096
+BROADCAST_MAX_READERS = 16
+BROADCAST_HEAD_OFFSET = 0
+BROADCAST_READERS_OFFSET = CACHE_LINE_SIZE
+BROADCAST_READER_FORMAT = 'i4xQQQ'  # pid, cursor, received, dropped
+BROADCAST_READER_STRIDE = CACHE_LINE_SIZE
+BROADCAST_SLOT_FORMAT = 'Q' + TICK_FORMAT  # sequence stamp + payload
+BROADCAST_SLOT_SIZE = 40  # payload rounded up to whole 8-byte words
+BROADCAST_SLOTS_OFFSET = BROADCAST_READERS_OFFSET + BROADCAST_MAX_READERS * BROADCAST_READER_STRIDE
+BROADCAST_RING_SIZE = BROADCAST_SLOTS_OFFSET + BROADCAST_RING_CAPACITY * BROADCAST_SLOT_SIZE
+
+# Layout of MarketData (MarketDataTable<4096, 8192>) in market_data_table.h
+SYMBOL_NAME_SIZE = 16
+MARKET_TABLE_CAPACITY = 4096
+MARKET_DIRECTORY_SIZE = 2 * MARKET_TABLE_CAPACITY
+MARKET_DIRECTORY_OFFSET = CACHE_LINE_SIZE
+MARKET_ENTRY_FORMAT = 'II16s'  # slot_plus_one, hash_tag, symbol
+MARKET_ENTRY_SIZE = struct.calcsize(MARKET_ENTRY_FORMAT)
+MARKET_SLOTS_OFFSET = MARKET_DIRECTORY_OFFSET + MARKET_DIRECTORY_SIZE * MARKET_ENTRY_SIZE
+MARKET_SLOT_FORMAT = TRADING_DATA_FORMAT + '16s'
+MARKET_SLOT_SIZE = CACHE_LINE_SIZE
+MARKET_TABLE_SIZE = MARKET_SLOTS_OFFSET + MARKET_TABLE_CAPACITY * MARKET_SLOT_SIZE
+# MarketRecord in trading_shm.cpp: one slot as returned by MarketTable.snapshot()
+MARKET_RECORD_DTYPE = np.dtype({'names': ['price', 'timestamp', 'volume', 'valid', 'symbol'],
+                                'formats': ['<f8', '<u8', '<i4', '?', 'S16'],
+                                'offsets': [0, 8, 16, 20, 24], 'itemsize': 40})
+
+# Layout of IndicatorTable in indicators.h; slot i belongs to market table slot i
+INDICATOR_WINDOW = 64
+INDICATOR_FORMAT = 'QQQ7d'  # sequence, timestamp, samples, last_price, sma, ema, vwap, volatility, min, max
+INDICATOR_SLOT_SIZE = 2 * CACHE_LINE_SIZE
+INDICATOR_SLOTS_OFFSET = CACHE_LINE_SIZE
+INDICATOR_TABLE_SIZE = INDICATOR_SLOTS_OFFSET + MARKET_TABLE_CAPACITY * INDICATOR_SLOT_SIZE
+INDICATOR_FIELDS = ['timestamp', 'samples', 'last_price', 'sma', 'ema', 'vwap', 'volatility', 'min', 'max']
+
+# Layout of OrderBookTable in order_book.h; slot i belongs to market table slot i
+BOOK_DEPTH = 10
+BOOK_HEADER_FORMAT = 'QQQdQII'  # sequence, timestamp, updates, last_price, last_quantity, bid_depth, ask_depth
+BOOK_LEVEL_FORMAT = 'dQI4x'     # price, quantity, orders
+BOOK_SLOT_FORMAT = BOOK_HEADER_FORMAT + BOOK_LEVEL_FORMAT * (2 * BOOK_DEPTH)
+BOOK_SLOT_SIZE = 9 * CACHE_LINE_SIZE
+BOOK_SLOTS_OFFSET = CACHE_LINE_SIZE
+BOOK_TABLE_SIZE = BOOK_SLOTS_OFFSET + MARKET_TABLE_CAPACITY * BOOK_SLOT_SIZE
+
+# Layout of LatencyTable in latency.h: one HDR-style histogram per consumer
+LATENCY_MAX_CONSUMERS = 16
+LATENCY_NAME_SIZE = 24
+LATENCY_SUB_BUCKET_BITS = 4
+LATENCY_SUB_BUCKETS = 1 << LATENCY_SUB_BUCKET_BITS
+LATENCY_MAX_BITS = 40
+LATENCY_BUCKET_COUNT = (LATENCY_MAX_BITS - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKETS
+LATENCY_HEADER_FORMAT = 'i24s4xQQQ8x'  # pid, name, count, total_ns, max_ns
+LATENCY_BUCKETS_OFFSET = struct.calcsize(LATENCY_HEADER_FORMAT)
+LATENCY_HISTOGRAM_SIZE = LATENCY_BUCKETS_OFFSET + LATENCY_BUCKET_COUNT * 8
+LATENCY_TABLE_SIZE = LATENCY_MAX_CONSUMERS * LATENCY_HISTOGRAM_SIZE
+
+# Layout of CommandRing (SharedRingBuffer<Command, 1024>) in command_queue.h; Python is its producer
+COMMAND_RING_CAPACITY = 1024
+COMMAND_FORMAT = 'QQdQIHBx16s8x'  # id, sent_ns (CLOCK_MONOTONIC), value, order_id, quantity, type, side, symbol
+COMMAND_SIZE = struct.calcsize(COMMAND_FORMAT)
+COMMAND_RING_HEAD_OFFSET = 0
+COMMAND_RING_TAIL_OFFSET = CACHE_LINE_SIZE
+COMMAND_RING_SLOTS_OFFSET = 2 * CACHE_LINE_SIZE
+COMMAND_RING_SIZE = COMMAND_RING_SLOTS_OFFSET + COMMAND_RING_CAPACITY * COMMAND_SIZE
+COMMAND_SUBSCRIBE = 1
+COMMAND_UNSUBSCRIBE = 2
+COMMAND_SET_RATE = 3
+COMMAND_PLACE_ORDER = 4
+COMMAND_CANCEL_ORDER = 5
+SIDES = {'bid': 0, 'buy': 0, 'ask': 1, 'sell': 1}
+
+# SegmentNotifier trails every SharedMemory<T> payload: epoch (futex word, producer-written)
+# and the sleepers flag (consumer-written) each sit on their own cache line
+NOTIFIER_EPOCH_OFFSET = 0
+NOTIFIER_SLEEPERS_OFFSET = CACHE_LINE_SIZE
+NOTIFIER_SIZE = 2 * CACHE_LINE_SIZE
+FUTEX_WAIT = 0
+FUTEX_WAKE = 1
+SYS_FUTEX = {'x86_64': 202, 'aarch64': 98}.get(platform.machine(), 202)
+
+if trading_shm and (trading_shm.TICK_RECORD_SIZE != TICK_DTYPE.itemsize or
+                    trading_shm.MARKET_RECORD_SIZE != MARKET_RECORD_DTYPE.itemsize):
+    raise SegmentLayoutError(f"trading_shm in {trading_shm.__file__} was built against different record layouts")
+
+def notifier_offset(payload_size: int) -> int:
+    """Offset of the SegmentNotifier, same as segment_notifier_offset() in shared_code.h"""
+    return (payload_size + CACHE_LINE_SIZE - 1) // CACHE_LINE_SIZE * CACHE_LINE_SIZE
+
+def segment_size(payload_size: int) -> int:
+    """Bytes mapped by SharedMemory<T> for a payload of payload_size"""
+    return notifier_offset(payload_size) + NOTIFIER_SIZE
+
+def map_segment(shm_fd: int, payload_size: int, type_name: str) -> mmap.mmap:
+    """Validate the segment header page and map the payload plus notifier behind it.
+    Offsets into the returned map are payload-relative, as in the C++ structs."""
+    if LAYOUTS[type_name].payload_size != payload_size:
+        raise SegmentLayoutError(f"{type_name} constants in data_bridge.py disagree with segment_layouts.py")
+    header_map = mmap.mmap(shm_fd, SEGMENT_HEADER_SIZE, mmap.MAP_SHARED, mmap.PROT_READ)
+    try:
+        check_segment(header_map, type_name)
+    finally:
+        header_map.close()
+    return mmap.mmap(shm_fd, segment_size(payload_size), mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE,
+                     offset=SEGMENT_HEADER_SIZE)
+
+def latency_bucket(ns: int) -> int:
+    """Histogram bucket of a latency, same as latency_bucket() in latency.h"""
+    if ns < LATENCY_SUB_BUCKETS:
+        return ns
+    if ns >= 1 << LATENCY_MAX_BITS:
+        return LATENCY_BUCKET_COUNT - 1
+    shift = ns.bit_length() - 1 - LATENCY_SUB_BUCKET_BITS
+    return (shift + 1) * LATENCY_SUB_BUCKETS + ((ns >> shift) & (LATENCY_SUB_BUCKETS - 1))
+
+def latency_bucket_upper(bucket: int) -> int:
+    """Largest latency that maps to bucket, what the percentiles report"""
+    if bucket < LATENCY_SUB_BUCKETS:
+        return bucket
+    shift = bucket // LATENCY_SUB_BUCKETS - 1
+    return ((LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) << shift) + (1 << shift) - 1
+
+class _Timespec(ctypes.Structure):
+    _fields_ = [('tv_sec', ctypes.c_long), ('tv_nsec', ctypes.c_long)]
+
+_libc = ctypes.CDLL(None, use_errno=True)
+_libc.syscall.restype = ctypes.c_long
+
+class WaitPolicy:
+    """Consumer wait strategy, same spec strings as WaitPolicy::parse in shared_code.h"""
+    
+    BUSY_SPIN = 'busy-spin'
+    YIELD = 'yield'
+    SPIN_THEN_BLOCK = 'spin'
+    SLEEP = 'sleep'
+    
+    def __init__(self, strategy: str = SPIN_THEN_BLOCK, spin_iterations: int = 0, sleep_interval: float = 0.0001):
+        self.strategy = strategy
+        self.spin_iterations = spin_iterations
+        self.sleep_interval = sleep_interval
+    
+    @classmethod
+    def parse(cls, spec: str) -> 'WaitPolicy':
+        """Accepts 'busy-spin', 'yield', 'block', 'spin:<iterations>' and 'sleep:<microseconds>'"""
+        kind, _, arg = spec.partition(':')
+        if kind == 'busy-spin':
+            return cls(cls.BUSY_SPIN)
+        if kind == 'yield':
+            return cls(cls.YIELD)
+        if kind == 'block':
+            return cls(cls.SPIN_THEN_BLOCK)
+        if kind == 'spin':
+            return cls(cls.SPIN_THEN_BLOCK, spin_iterations=int(arg) if arg else 10000)
+        if kind == 'sleep':
+            return cls(cls.SLEEP, sleep_interval=int(arg) / 1e6 if arg else 0.0001)
+        raise ValueError(f"Unknown wait strategy: {spec}")
+    
+    @classmethod
+    def from_env(cls, variable: str = 'TRADING_WAIT_STRATEGY') -> 'WaitPolicy':
+        """Lets each process pick its CPU/latency trade-off without code changes"""
+        spec = os.environ.get(variable)
+        return cls.parse(spec) if spec else cls()
+
+class SegmentNotifier:
+    """Futex wakeup channel shared with SharedMemory<T>::notify() in C++"""
+    
+    def __init__(self, shm_map, payload_size: int):
+        self.shm_map = shm_map
+        self.offset = notifier_offset(payload_size) + NOTIFIER_EPOCH_OFFSET
+        self._word = ctypes.c_uint32.from_buffer(shm_map, self.offset)
+        self.last_epoch = self.epoch()
+    
+    def epoch(self) -> int:
+        return struct.unpack_from('I', self.shm_map, self.offset)[0]
+    
+    def _updated(self) -> bool:
+        if self.epoch() != self.last_epoch:
+            self.last_epoch = self.epoch()
+            return True
+        return False
+    
+    def wait(self, timeout: float, policy: Optional[WaitPolicy] = None) -> bool:
+        """Wait until the producer publishes past the last seen epoch; False on timeout"""
+        policy = policy or WaitPolicy()
+        deadline = time.monotonic() + timeout
+        
+        if policy.strategy in (WaitPolicy.BUSY_SPIN, WaitPolicy.YIELD, WaitPolicy.SLEEP):
+            while not self._updated():
+                if time.monotonic() >= deadline:
+                    return False
+                if policy.strategy == WaitPolicy.YIELD:
+                    os.sched_yield()
+                elif policy.strategy == WaitPolicy.SLEEP:
+                    time.sleep(policy.sleep_interval)
+            return True
+        
+        for _ in range(policy.spin_iterations):
+            if self._updated():
+                return True
+        
+        while self.epoch() == self.last_epoch:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return False
+            # Announce before re-checking so a concurrent notify() cannot miss us
+            struct.pack_into('I', self.shm_map, self.offset + NOTIFIER_SLEEPERS_OFFSET, 1)
+            if self.epoch() != self.last_epoch:
+                break
+            ts = _Timespec(int(remaining), int((remaining % 1) * 1e9))
+            # ctypes drops the GIL for the duration of the call
+            _libc.syscall(ctypes.c_long(SYS_FUTEX), ctypes.c_void_p(ctypes.addressof(self._word)),
+                          ctypes.c_int(FUTEX_WAIT), ctypes.c_uint32(self.last_epoch),
+                          ctypes.byref(ts), None, ctypes.c_int(0))
+        self.last_epoch = self.epoch()
+        return True
+    
+    def notify(self):
+        """Producer side, for the segments Python writes: bump the epoch and wake all sleepers.
+        Always a syscall: skipping it when the sleepers flag is clear would need a store-load
+        fence between the two, which Python can't issue."""
+        struct.pack_into('I', self.shm_map, self.offset, (self.epoch() + 1) & 0xFFFFFFFF)
+        struct.pack_into('I', self.shm_map, self.offset + NOTIFIER_SLEEPERS_OFFSET, 0)
+        _libc.syscall(ctypes.c_long(SYS_FUTEX), ctypes.c_void_p(ctypes.addressof(self._word)),
+                      ctypes.c_int(FUTEX_WAKE), ctypes.c_int(0x7FFFFFFF), None, None, ctypes.c_int(0))
+    
+    def release(self):
+        """Drop the exported buffer so the mmap can be closed"""
+        self._word = None
+
+def symbol_hash(symbol: str) -> int:
+    """FNV-1a, identical to symbol_hash() in market_data_table.h"""
+    h = 14695981039346656037
+    for byte in symbol.encode()[:SYMBOL_NAME_SIZE]:
+        h ^= byte
+        h = (h * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+def _claim_histogram(shm_fd: int, shm_map, name: str) -> int:
+    # Same flock-guarded slot table as LatencyRecorder in latency.h
+    fcntl.flock(shm_fd, fcntl.LOCK_EX)
+    try:
+        for i in range(LATENCY_MAX_CONSUMERS):
+            offset = i * LATENCY_HISTOGRAM_SIZE
+            pid = struct.unpack_from('i', shm_map, offset)[0]
+            if pid != 0:
+                try:
+                    os.kill(pid, 0)
+                    continue
+                except ProcessLookupError:
+                    pass  # stale slot from a consumer that died
+                except PermissionError:
+                    continue
+            shm_map[offset + 4:offset + LATENCY_HISTOGRAM_SIZE] = bytes(LATENCY_HISTOGRAM_SIZE - 4)
+            struct.pack_into('24s', shm_map, offset + 4, name.encode()[:LATENCY_NAME_SIZE - 1])
+            struct.pack_into('i', shm_map, offset, os.getpid())
+            return offset
+    finally:
+        fcntl.flock(shm_fd, fcntl.LOCK_UN)
+    raise RuntimeError("Latency table is full")
+
+class LatencyRecorder:
+    """This consumer's publish-to-consume histogram in /trading_latency (LatencyRecorder in latency.h)"""
+    
+    def __init__(self, name: str, shm_name="/trading_latency"):
+        self.name = name
+        self.shm_name = shm_name
+        self.shm_fd = None
+        self.shm_map = None
+        self.offset = None
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Claim a histogram slot in the C++ latency table"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            self.shm_map = map_segment(self.shm_fd, LATENCY_TABLE_SIZE, 'LatencyTable')
+            self.offset = _claim_histogram(self.shm_fd, self.shm_map, self.name)
+            self.connected = True
+            print(f"✓ Connected to C++ latency table as {self.name}")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to latency table: {e}")
+            self.close()
+            return False
+    
+    def record_ticks(self, ticks: List[Dict[str, Any]], received_ns: int):
+        """Record received_ns - publish_ns for every stamped tick of one batch"""
+        if not self.connected:
+            return
+        counts: Dict[int, int] = {}
+        total = 0
+        longest = 0
+        for tick in ticks:
+            publish_ns = tick['publish_ns']
+            if publish_ns == 0 or received_ns < publish_ns:
+                continue
+            latency = received_ns - publish_ns
+            bucket = latency_bucket(latency)
+            counts[bucket] = counts.get(bucket, 0) + 1
+            total += latency
+            longest = max(longest, latency)
+        if not counts:
+            return
+        
+        # Single writer per slot, so read-modify-write without atomics is safe
+        for bucket, n in counts.items():
+            bucket_offset = self.offset + LATENCY_BUCKETS_OFFSET + bucket * 8
+            struct.pack_into('Q', self.shm_map, bucket_offset, struct.unpack_from('Q', self.shm_map, bucket_offset)[0] + n)
+        count, total_ns, max_ns = struct.unpack_from('QQQ', self.shm_map, self.offset + 32)
+        struct.pack_into('QQQ', self.shm_map, self.offset + 32,
+                         count + sum(counts.values()), total_ns + total, max(max_ns, longest))
+    
+    def close(self):
+        """Release the histogram slot"""
+        if self.shm_map:
+            if self.offset is not None:
+                struct.pack_into('i', self.shm_map, self.offset, 0)
+                self.offset = None
+            self.shm_map.close()
+            self.shm_map = None
+        if self.shm_fd:
+            os.close(self.shm_fd)
+            self.shm_fd = None
+        self.connected = False
+
+class LatencyTableReader:
+    """Percentiles of every consumer's histogram in /trading_latency"""
+    
+    def __init__(self, shm_name="/trading_latency"):
+        self.shm_name = shm_name
+        self.shm_fd = None
+        self.shm_map = None
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Connect to the C++ latency table"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            self.shm_map = map_segment(self.shm_fd, LATENCY_TABLE_SIZE, 'LatencyTable')
+            self.connected = True
+            print("✓ Connected to C++ latency table")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to latency table: {e}")
+            return False
+    
+    def summaries(self) -> List[Dict[str, Any]]:
+        """p50/p99/p99.9/max publish-to-consume latency (microseconds) per registered consumer"""
+        if not self.connected:
+            return []
+        results = []
+        for i in range(LATENCY_MAX_CONSUMERS):
+            offset = i * LATENCY_HISTOGRAM_SIZE
+            pid, name, _, total_ns, max_ns = struct.unpack_from(LATENCY_HEADER_FORMAT, self.shm_map, offset)
+            if pid == 0:
+                continue
+            counts = struct.unpack_from(f'{LATENCY_BUCKET_COUNT}Q', self.shm_map, offset + LATENCY_BUCKETS_OFFSET)
+            count = sum(counts)
+            if count == 0:
+                continue
+            
+            # Same ranks as summarize_latency() in latency.h
+            summary = {'consumer': name.rstrip(b'\0').decode(), 'pid': pid, 'count': count,
+                       'mean_us': total_ns / count / 1000, 'max_us': max_ns / 1000}
+            targets = [('p50_us', 0.50), ('p99_us', 0.99), ('p999_us', 0.999)]
+            seen = 0
+            for bucket, n in enumerate(counts):
+                seen += n
+                while targets and seen >= max(int(targets[0][1] * count + 0.5), 1):
+                    summary[targets.pop(0)[0]] = min(latency_bucket_upper(bucket), max_ns) / 1000
+                if not targets:
+                    break
+            results.append(summary)
+        return results
+    
+    def close(self):
+        """Close latency table connection"""
+        if self.shm_map:
+            self.shm_map.close()
+        if self.shm_fd:
+            os.close(self.shm_fd)
+        self.connected = False
 
 class TradingDataBridge:
     def __init__(self, shm_name="/trading_data"):
         self.shm_name = shm_name
         self.shm_fd = None
         self.shm_map = None
+        self.notifier = None
+        self.wait_policy = WaitPolicy.from_env()
         self.connected = False
         
     def connect(self) -> bool:
         """Connect to C++ shared memory"""
         try:
             self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
-            self.shm_map = mmap.mmap(self.shm_fd, 24, mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE)
+            self.shm_map = map_segment(self.shm_fd, TRADING_DATA_SIZE, 'TradingData')
+            self.notifier = SegmentNotifier(self.shm_map, TRADING_DATA_SIZE)
             self.connected = True
             print("✓ Connected to C++ shared memory")
             return True
@@ -39,42 +463,753 @@ class TradingDataBridge:
             return None
         
         try:
-            self.shm_map.seek(0)
-            data = self.shm_map.read(24)
-            price, timestamp, volume, valid = struct.unpack('dQi?3x', data)
+            # Seqlock read: retry while the writer is mid-update (odd sequence)
+            # or the sequence moved while we copied the record
+            for _ in range(SEQLOCK_MAX_RETRIES):
+                data = self.shm_map[0:TRADING_DATA_SIZE]
+                sequence, price, timestamp, volume, valid = struct.unpack(TRADING_DATA_FORMAT, data)
+                if sequence & 1:
+                    continue
+                if struct.unpack_from('Q', self.shm_map, 0)[0] == sequence:
+                    break
+            else:
+                return None
             
             return {
+                'sequence': sequence,
                 'price': price,
                 'timestamp': timestamp,
                 'volume': volume,
                 'valid': bool(valid),
-                'datetime': datetime.fromtimestamp(timestamp) if timestamp > 0 else None,
-                'formatted_time': datetime.fromtimestamp(timestamp).strftime("%Y-%m-%d %H:%M:%S") if timestamp > 0 else "N/A"
+                'datetime': datetime.fromtimestamp(timestamp / NANOS_PER_SECOND) if timestamp > 0 else None,
+                'formatted_time': datetime.fromtimestamp(timestamp / NANOS_PER_SECOND).strftime("%Y-%m-%d %H:%M:%S") if timestamp > 0 else "N/A"
             }
         except Exception as e:
             print(f"Error reading shared memory: {e}")
             return None
     
     def write_data(self, price: float, volume: int, timestamp: int = None, valid: bool = True) -> bool:
-        """Write trading data to shared memory"""
+        """Write trading data to shared memory; timestamp in nanoseconds since the epoch"""
         if not self.connected:
             return False
         
         try:
             if timestamp is None:
-                timestamp = int(time.time())
+                timestamp = time.time_ns()
             
-            data = struct.pack('dQi?3x', price, timestamp, volume, valid)
-            self.shm_map.seek(0)
-            self.shm_map.write(data)
-            self.shm_map.flush()
+            # Same seqlock protocol as TradingData::publish: odd while writing
+            sequence = struct.unpack_from('Q', self.shm_map, 0)[0]
+            struct.pack_into('Q', self.shm_map, 0, sequence + 1)
+            self.shm_map[8:TRADING_DATA_SIZE] = struct.pack(TRADING_DATA_FORMAT, 0, price, timestamp, volume, valid)[8:]
+            struct.pack_into('Q', self.shm_map, 0, sequence + 2)
             return True
         except Exception as e:
             print(f"Error writing to shared memory: {e}")
             return False
     
+    def wait_for_update(self, timeout: float = 1.0) -> bool:
+        """Wait (per self.wait_policy) until the C++ producer publishes again; False on timeout"""
+        if not self.connected:
+            return False
+        return self.notifier.wait(timeout, self.wait_policy)
+    
     def close(self):
         """Close shared memory connection"""
+        if self.notifier:
+            self.notifier.release()
+            self.notifier = None
+        if self.shm_map:
+            self.shm_map.close()
+        if self.shm_fd:
+            os.close(self.shm_fd)
+        self.connected = False
+
+class TickRingReader:
+    """Single consumer of the C++ tick ring (/trading_ticks)"""
+    
+    def __init__(self, shm_name="/trading_ticks", latency_name: Optional[str] = None):
+        self.shm_name = shm_name
+        self.shm_fd = None
+        self.shm_map = None
+        self.notifier = None
+        self.wait_policy = WaitPolicy.from_env()
+        self.latency = LatencyRecorder(latency_name) if latency_name else None
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Connect to the C++ tick ring"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            self.shm_map = map_segment(self.shm_fd, TICK_RING_SIZE, 'TickRing')
+            self.notifier = SegmentNotifier(self.shm_map, TICK_RING_SIZE)
+            if self.latency and not self.latency.connect():
+                self.latency = None
+            self.connected = True
+            print("✓ Connected to C++ tick ring")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to tick ring: {e}")
+            return False
+    
+    def pending(self) -> int:
+        """Number of ticks waiting to be drained"""
+        if not self.connected:
+            return 0
+        tail = struct.unpack_from('Q', self.shm_map, TICK_RING_TAIL_OFFSET)[0]
+        head = struct.unpack_from('Q', self.shm_map, TICK_RING_HEAD_OFFSET)[0]
+        return head - tail
+    
+    def drain(self, max_ticks: int = TICK_RING_CAPACITY) -> List[Dict[str, Any]]:
+        """Pop every available tick (up to max_ticks) in one batch"""
+        if not self.connected:
+            return []
+        
+        tail = struct.unpack_from('Q', self.shm_map, TICK_RING_TAIL_OFFSET)[0]
+        head = struct.unpack_from('Q', self.shm_map, TICK_RING_HEAD_OFFSET)[0]
+        count = min(head - tail, max_ticks)
+        if count <= 0:
+            return []
+        
+        # Copy the occupied slots out in at most two contiguous pieces
+        first = tail % TICK_RING_CAPACITY
+        first_count = min(count, TICK_RING_CAPACITY - first)
+        start = TICK_RING_SLOTS_OFFSET + first * TICK_SIZE
+        raw = self.shm_map[start:start + first_count * TICK_SIZE]
+        if first_count < count:
+            raw += self.shm_map[TICK_RING_SLOTS_OFFSET:TICK_RING_SLOTS_OFFSET + (count - first_count) * TICK_SIZE]
+        
+        received_ns = time.monotonic_ns()
+        ticks = [
+            {'price': price, 'timestamp': timestamp, 'volume': volume, 'valid': bool(valid),
+             'symbol_index': symbol_index, 'publish_ns': publish_ns}
+            for price, timestamp, volume, valid, symbol_index, publish_ns in struct.iter_unpack(TICK_FORMAT, raw)
+        ]
+        
+        # Hand the slots back to the producer only after copying them out
+        struct.pack_into('Q', self.shm_map, TICK_RING_TAIL_OFFSET, tail + count)
+        if self.latency:
+            self.latency.record_ticks(ticks, received_ns)
+        return ticks
+    
+    def wait_for_update(self, timeout: float = 1.0) -> bool:
+        """Wait (per self.wait_policy) until the C++ producer publishes again; False on timeout"""
+        if not self.connected:
+            return False
+        return self.notifier.wait(timeout, self.wait_policy)
+    
+    def close(self):
+        """Close tick ring connection"""
+        if self.notifier:
+            self.notifier.release()
+            self.notifier = None
+        if self.latency:
+            self.latency.close()
+        if self.shm_map:
+            self.shm_map.close()
+        if self.shm_fd:
+            os.close(self.shm_fd)
+        self.connected = False
+
+class BroadcastRingReader:
+    """One of many independent readers of the C++ broadcast ring (/trading_broadcast)"""
+    
+    def __init__(self, shm_name="/trading_broadcast", latency_name: Optional[str] = None):
+        self.shm_name = shm_name
+        self.shm_fd = None
+        self.shm_map = None
+        self.notifier = None
+        self.wait_policy = WaitPolicy.from_env()
+        self.latency = LatencyRecorder(latency_name) if latency_name else None
+        self.connected = False
+        self.reader_offset = None
+        self.cursor = 0
+        self.received = 0
+        self.dropped = 0
+    
+    def connect(self) -> bool:
+        """Attach to the broadcast ring and claim a reader slot"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            self.shm_map = map_segment(self.shm_fd, BROADCAST_RING_SIZE, 'TickBroadcastRing')
+            self.notifier = SegmentNotifier(self.shm_map, BROADCAST_RING_SIZE)
+            self.cursor = struct.unpack_from('Q', self.shm_map, BROADCAST_HEAD_OFFSET)[0]
+            self.reader_offset = self._register()
+            if self.latency and not self.latency.connect():
+                self.latency = None
+            self.connected = True
+            print("✓ Connected to C++ broadcast ring")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to broadcast ring: {e}")
+            self.close()
+            return False
+    
+    def _register(self) -> int:
+        # Same flock-guarded reader table as BroadcastReader in shared_code.h
+        fcntl.flock(self.shm_fd, fcntl.LOCK_EX)
+        try:
+            for i in range(BROADCAST_MAX_READERS):
+                offset = BROADCAST_READERS_OFFSET + i * BROADCAST_READER_STRIDE
+                pid = struct.unpack_from('i', self.shm_map, offset)[0]
+                if pid != 0:
+                    try:
+                        os.kill(pid, 0)
+                        continue
+                    except ProcessLookupError:
+                        pass  # stale slot from a reader that died
+                    except PermissionError:
+                        continue
+                struct.pack_into(BROADCAST_READER_FORMAT, self.shm_map, offset, 0, self.cursor, 0, 0)
+                struct.pack_into('i', self.shm_map, offset, os.getpid())
+                return offset
+        finally:
+            fcntl.flock(self.shm_fd, fcntl.LOCK_UN)
+        raise RuntimeError("Broadcast ring reader table is full")
+    
+    def _skip_overrun(self, head: int):
+        # The slot at head may be mid-write, so resume one past it
+        oldest = head - BROADCAST_RING_CAPACITY + 1
+        if oldest > self.cursor:
+            self.dropped += oldest - self.cursor
+            self.cursor = oldest
+    
+    def poll(self, max_ticks: int = BROADCAST_RING_CAPACITY) -> List[Dict[str, Any]]:
+        """Return every tick published since the last poll (up to max_ticks)"""
+        if not self.connected:
+            return []
+        
+        while True:
+            head = struct.unpack_from('Q', self.shm_map, BROADCAST_HEAD_OFFSET)[0]
+            if head - self.cursor >= BROADCAST_RING_CAPACITY:
+                self._skip_overrun(head)
+            count = min(head - self.cursor, max_ticks)
+            if count <= 0:
+                return []
+            
+            first = self.cursor % BROADCAST_RING_CAPACITY
+            first_count = min(count, BROADCAST_RING_CAPACITY - first)
+            start = BROADCAST_SLOTS_OFFSET + first * BROADCAST_SLOT_SIZE
+            raw = self.shm_map[start:start + first_count * BROADCAST_SLOT_SIZE]
+            if first_count < count:
+                raw += self.shm_map[BROADCAST_SLOTS_OFFSET:BROADCAST_SLOTS_OFFSET + (count - first_count) * BROADCAST_SLOT_SIZE]
+            
+            # The writer overwrites in order, so if the oldest copied slot still
+            # carries its stamp none of the later ones were touched either
+            oldest_stamp = struct.unpack_from('Q', self.shm_map, start)[0]
+            if oldest_stamp == 2 * self.cursor + 2:
+                break
+            self._skip_overrun(struct.unpack_from('Q', self.shm_map, BROADCAST_HEAD_OFFSET)[0])
+        
+        received_ns = time.monotonic_ns()
+        ticks = [
+            {'price': price, 'timestamp': timestamp, 'volume': volume, 'valid': bool(valid),
+             'symbol_index': symbol_index, 'publish_ns': publish_ns}
+            for _, price, timestamp, volume, valid, symbol_index, publish_ns
+            in struct.iter_unpack(BROADCAST_SLOT_FORMAT, raw)
+        ]
+        
+        self.cursor += count
+        self.received += count
+        struct.pack_into('QQQ', self.shm_map, self.reader_offset + 8, self.cursor, self.received, self.dropped)
+        if self.latency:
+            self.latency.record_ticks(ticks, received_ns)
+        return ticks
+    
+    def lag(self) -> int:
+        """Ticks published but not yet consumed by this reader"""
+        if not self.connected:
+            return 0
+        return struct.unpack_from('Q', self.shm_map, BROADCAST_HEAD_OFFSET)[0] - self.cursor
+    
+    def wait_for_update(self, timeout: float = 1.0) -> bool:
+        """Wait (per self.wait_policy) until the C++ producer publishes again; False on timeout"""
+        if not self.connected:
+            return False
+        return self.notifier.wait(timeout, self.wait_policy)
+    
+    def close(self):
+        """Release the reader slot and close the broadcast ring"""
+        if self.notifier:
+            self.notifier.release()
+            self.notifier = None
+        if self.latency:
+            self.latency.close()
+        if self.shm_map:
+            if self.reader_offset is not None:
+                struct.pack_into('i', self.shm_map, self.reader_offset, 0)
+                self.reader_offset = None
+            self.shm_map.close()
+            self.shm_map = None
+        if self.shm_fd:
+            os.close(self.shm_fd)
+            self.shm_fd = None
+        self.connected = False
+
+class NativeTickRingReader:
+    """Single consumer of the tick ring through trading_shm: drain() returns a numpy structured
+    array (TICK_DTYPE) viewing the ring slots, with no per-tick Python objects"""
+    
+    def __init__(self, shm_name="/trading_ticks"):
+        self.shm_name = shm_name
+        self.reader = None
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Attach to the C++ tick ring; needs the trading_shm extension"""
+        if trading_shm is None:
+            print(f"trading_shm extension not found (looked in {NATIVE_MODULE_DIR})")
+            return False
+        try:
+            self.reader = trading_shm.TickRingReader(self.shm_name)
+            self.connected = True
+            print("✓ Connected to C++ tick ring (native)")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to tick ring: {e}")
+            return False
+    
+    def pending(self) -> int:
+        """Number of ticks waiting to be drained"""
+        return self.reader.pending() if self.connected else 0
+    
+    def drain(self, max_ticks: int = TICK_RING_CAPACITY, timeout: float = 0.0) -> np.ndarray:
+        """Next contiguous run of ticks, waiting up to timeout with the GIL released when empty.
+        The array views the ring: it stays valid until the next drain() or commit(), after which the producer
+        overwrites what it points at without any error. copy() it to keep it"""
+        if not self.connected:
+            return np.empty(0, dtype=TICK_DTYPE)
+        return np.frombuffer(self.reader.drain(max_ticks, timeout), dtype=TICK_DTYPE)
+    
+    def commit(self):
+        """Hand the last drained slots back to the producer without draining again"""
+        if self.connected:
+            self.reader.commit()
+    
+    def close(self):
+        """Return the drained slots and detach"""
+        if self.reader:
+            self.reader.commit()
+            self.reader = None
+        self.connected = False
+
+class NativeBroadcastReader:
+    """Broadcast ring reader through trading_shm; poll() copies new ticks into a numpy array"""
+    
+    def __init__(self, shm_name="/trading_broadcast"):
+        self.shm_name = shm_name
+        self.reader = None
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Attach to the broadcast ring and claim a reader slot; needs the trading_shm extension"""
+        if trading_shm is None:
+            print(f"trading_shm extension not found (looked in {NATIVE_MODULE_DIR})")
+            return False
+        try:
+            self.reader = trading_shm.BroadcastReader(self.shm_name)
+            self.connected = True
+            print("✓ Connected to C++ broadcast ring (native)")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to broadcast ring: {e}")
+            return False
+    
+    def poll(self, max_ticks: int = BROADCAST_RING_CAPACITY, timeout: float = 0.0) -> np.ndarray:
+        """Ticks published since the last poll (TICK_DTYPE), waiting up to timeout with the GIL released"""
+        if not self.connected:
+            return np.empty(0, dtype=TICK_DTYPE)
+        return np.frombuffer(self.reader.poll(max_ticks, timeout), dtype=TICK_DTYPE)
+    
+    def lag(self) -> int:
+        return self.reader.lag() if self.connected else 0
+    
+    def dropped(self) -> int:
+        return self.reader.dropped() if self.connected else 0
+    
+    def close(self):
+        """Release the reader slot (once no batch references the reader)"""
+        self.reader = None
+        self.connected = False
+
+class NativeMarketTable:
+    """Market data table through trading_shm: snapshot() is every symbol's latest tick as one array"""
+    
+    def __init__(self, shm_name="/market_data"):
+        self.shm_name = shm_name
+        self.table = None
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Attach to the market data table; needs the trading_shm extension"""
+        if trading_shm is None:
+            print(f"trading_shm extension not found (looked in {NATIVE_MODULE_DIR})")
+            return False
+        try:
+            self.table = trading_shm.MarketTable(self.shm_name)
+            self.connected = True
+            print("✓ Connected to C++ market data table (native)")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to market data table: {e}")
+            return False
+    
+    def find(self, symbol: str) -> int:
+        """Slot index for symbol, or -1; also the row of that symbol in snapshot()"""
+        return self.table.find(symbol) if self.connected else -1
+    
+    def snapshot(self) -> np.ndarray:
+        """Consistent copy of every slot (MARKET_RECORD_DTYPE), read with the GIL released"""
+        if not self.connected:
+            return np.empty(0, dtype=MARKET_RECORD_DTYPE)
+        return np.frombuffer(self.table.snapshot(), dtype=MARKET_RECORD_DTYPE)
+    
+    def wait_for_update(self, timeout: float = 1.0) -> bool:
+        return self.table.wait_for_update(timeout) if self.connected else False
+    
+    def close(self):
+        self.table = None
+        self.connected = False
+
+class MarketDataTableReader:
+    """Reader for the multi-symbol C++ market data segment (/market_data)"""
+    
+    def __init__(self, shm_name="/market_data"):
+        self.shm_name = shm_name
+        self.shm_fd = None
+        self.shm_map = None
+        self.notifier = None
+        self.wait_policy = WaitPolicy.from_env()
+        self.connected = False
+        self.index_cache = {}
+    
+    def connect(self) -> bool:
+        """Connect to the C++ market data table"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            self.shm_map = map_segment(self.shm_fd, MARKET_TABLE_SIZE, 'MarketData')
+            self.notifier = SegmentNotifier(self.shm_map, MARKET_TABLE_SIZE)
+            self.connected = True
+            print("✓ Connected to C++ market data table")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to market data table: {e}")
+            return False
+    
+    def count(self) -> int:
+        """Number of symbols published so far"""
+        if not self.connected:
+            return 0
+        return struct.unpack_from('I', self.shm_map, 0)[0]
+    
+    def find(self, symbol: str) -> int:
+        """Slot index for symbol via the shared directory, or -1"""
+        if not self.connected:
+            return -1
+        if symbol in self.index_cache:
+            return self.index_cache[symbol]
+        
+        h = symbol_hash(symbol)
+        name = symbol.encode()
+        for probe in range(MARKET_DIRECTORY_SIZE):
+            offset = MARKET_DIRECTORY_OFFSET + ((h + probe) & (MARKET_DIRECTORY_SIZE - 1)) * MARKET_ENTRY_SIZE
+            slot_plus_one, hash_tag, stored = struct.unpack_from(MARKET_ENTRY_FORMAT, self.shm_map, offset)
+            if slot_plus_one == 0:
+                return -1
+            if hash_tag == (h & 0xFFFFFFFF) and stored.rstrip(b'\0') == name:
+                self.index_cache[symbol] = slot_plus_one - 1
+                return slot_plus_one - 1
+        return -1
+    
+    def _read_slot(self, index: int) -> Optional[Dict[str, Any]]:
+        offset = MARKET_SLOTS_OFFSET + index * MARKET_SLOT_SIZE
+        for _ in range(SEQLOCK_MAX_RETRIES):
+            sequence, price, timestamp, volume, valid, name = struct.unpack_from(MARKET_SLOT_FORMAT, self.shm_map, offset)
+            if sequence & 1:
+                continue
+            if struct.unpack_from('Q', self.shm_map, offset)[0] == sequence:
+                return {
+                    'symbol': name.rstrip(b'\0').decode(),
+                    'price': price,
+                    'timestamp': timestamp,
+                    'volume': volume,
+                    'valid': bool(valid),
+                }
+        return None
+    
+    def read_symbol(self, symbol: str) -> Optional[Dict[str, Any]]:
+        """Latest consistent tick for one symbol"""
+        index = self.find(symbol)
+        if index < 0:
+            return None
+        return self._read_slot(index)
+    
+    def scan(self) -> List[Dict[str, Any]]:
+        """Latest tick for every symbol, read straight from the mapping"""
+        if not self.connected:
+            return []
+        return [tick for tick in (self._read_slot(i) for i in range(self.count())) if tick]
+    
+    def wait_for_update(self, timeout: float = 1.0) -> bool:
+        """Wait (per self.wait_policy) until the C++ producer publishes again; False on timeout"""
+        if not self.connected:
+            return False
+        return self.notifier.wait(timeout, self.wait_policy)
+    
+    def close(self):
+        """Close market data table connection"""
+        if self.notifier:
+            self.notifier.release()
+            self.notifier = None
+        if self.shm_map:
+            self.shm_map.close()
+        if self.shm_fd:
+            os.close(self.shm_fd)
+        self.connected = False
+
+class IndicatorReader:
+    """Reader for indicators the C++ engine maintains per symbol (/trading_indicators)"""
+    
+    def __init__(self, market_table: MarketDataTableReader, shm_name="/trading_indicators"):
+        self.shm_name = shm_name
+        self.market_table = market_table
+        self.shm_fd = None
+        self.shm_map = None
+        self.notifier = None
+        self.wait_policy = WaitPolicy.from_env()
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Connect to the C++ indicator table"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            self.shm_map = map_segment(self.shm_fd, INDICATOR_TABLE_SIZE, 'Indicators')
+            self.notifier = SegmentNotifier(self.shm_map, INDICATOR_TABLE_SIZE)
+            self.connected = True
+            print("✓ Connected to C++ indicator table")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to indicator table: {e}")
+            return False
+    
+    def _read_slot(self, index: int) -> Optional[Dict[str, Any]]:
+        offset = INDICATOR_SLOTS_OFFSET + index * INDICATOR_SLOT_SIZE
+        for _ in range(SEQLOCK_MAX_RETRIES):
+            sequence, *values = struct.unpack_from(INDICATOR_FORMAT, self.shm_map, offset)
+            if sequence & 1:
+                continue
+            if struct.unpack_from('Q', self.shm_map, offset)[0] == sequence:
+                return dict(zip(INDICATOR_FIELDS, values)) if sequence else None
+        return None
+    
+    def read_symbol(self, symbol: str) -> Optional[Dict[str, Any]]:
+        """Latest SMA/EMA/VWAP/volatility/min/max for symbol, None before its first tick"""
+        if not self.connected:
+            return None
+        index = self.market_table.find(symbol)
+        if index < 0:
+            return None
+        values = self._read_slot(index)
+        if values:
+            values['symbol'] = symbol
+        return values
+    
+    def wait_for_update(self, timeout: float = 1.0) -> bool:
+        """Wait (per self.wait_policy) until the engine publishes again; False on timeout"""
+        if not self.connected:
+            return False
+        return self.notifier.wait(timeout, self.wait_policy)
+    
+    def close(self):
+        """Close indicator table connection"""
+        if self.notifier:
+            self.notifier.release()
+            self.notifier = None
+        if self.shm_map:
+            self.shm_map.close()
+        if self.shm_fd:
+            os.close(self.shm_fd)
+        self.connected = False
+
+class OrderBookReader:
+    """Reader for the order book depth the C++ book engine publishes per symbol (/trading_book)"""
+    
+    def __init__(self, market_table: MarketDataTableReader, shm_name="/trading_book"):
+        self.shm_name = shm_name
+        self.market_table = market_table
+        self.shm_fd = None
+        self.shm_map = None
+        self.notifier = None
+        self.wait_policy = WaitPolicy.from_env()
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Connect to the C++ order book table"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            self.shm_map = map_segment(self.shm_fd, BOOK_TABLE_SIZE, 'OrderBooks')
+            self.notifier = SegmentNotifier(self.shm_map, BOOK_TABLE_SIZE)
+            self.connected = True
+            print("✓ Connected to C++ order book table")
+            return True
+        except Exception as e:
+            print(f"Failed to connect to order book table: {e}")
+            return False
+    
+    def _read_slot(self, index: int) -> Optional[Dict[str, Any]]:
+        offset = BOOK_SLOTS_OFFSET + index * BOOK_SLOT_SIZE
+        for _ in range(SEQLOCK_MAX_RETRIES):
+            sequence, timestamp, updates, last_price, last_quantity, bid_depth, ask_depth, *levels = \
+                struct.unpack_from(BOOK_SLOT_FORMAT, self.shm_map, offset)
+            if sequence & 1:
+                continue
+            if struct.unpack_from('Q', self.shm_map, offset)[0] != sequence:
+                continue
+            if not sequence:
+                return None
+            bids = [levels[i * 3:i * 3 + 3] for i in range(min(bid_depth, BOOK_DEPTH))]
+            asks = [levels[(BOOK_DEPTH + i) * 3:(BOOK_DEPTH + i) * 3 + 3] for i in range(min(ask_depth, BOOK_DEPTH))]
+            return {
+                'timestamp': timestamp,
+                'updates': updates,
+                'last_price': last_price,
+                'last_quantity': last_quantity,
+                'bids': [{'price': p, 'quantity': q, 'orders': n} for p, q, n in bids],
+                'asks': [{'price': p, 'quantity': q, 'orders': n} for p, q, n in asks],
+            }
+        return None
+    
+    def read_symbol(self, symbol: str) -> Optional[Dict[str, Any]]:
+        """Top BOOK_DEPTH bid/ask levels (best first) and last trade for symbol, None before its first delta"""
+        if not self.connected:
+            return None
+        index = self.market_table.find(symbol)
+        if index < 0:
+            return None
+        book = self._read_slot(index)
+        if book:
+            book['symbol'] = symbol
+        return book
+    
+    def top_of_book(self, symbol: str) -> Optional[Dict[str, Any]]:
+        """Best bid and ask with their quantities; a side is None while it is empty"""
+        book = self.read_symbol(symbol)
+        if not book:
+            return None
+        return {
+            'symbol': symbol,
+            'bid': book['bids'][0] if book['bids'] else None,
+            'ask': book['asks'][0] if book['asks'] else None,
+            'timestamp': book['timestamp'],
+        }
+    
+    def wait_for_update(self, timeout: float = 1.0) -> bool:
+        """Wait (per self.wait_policy) until the engine publishes again; False on timeout"""
+        if not self.connected:
+            return False
+        return self.notifier.wait(timeout, self.wait_policy)
+    
+    def close(self):
+        """Close order book table connection"""
+        if self.notifier:
+            self.notifier.release()
+            self.notifier = None
+        if self.shm_map:
+            self.shm_map.close()
+        if self.shm_fd:
+            os.close(self.shm_fd)
+        self.connected = False
+
+class CommandSender:
+    """Producer side of the C++ command ring (/trading_commands), the control plane into trading_app"""
+    
+    def __init__(self, shm_name="/trading_commands"):
+        self.shm_name = shm_name
+        self.shm_fd = None
+        self.shm_map = None
+        self.notifier = None
+        self.next_id = 1
+        self.lock = threading.Lock()  # one producer: threads of this process take turns
+        self.connected = False
+    
+    def connect(self) -> bool:
+        """Connect to the C++ command ring and claim it as its only sender"""
+        try:
+            self.shm_fd = os.open(f"/dev/shm{self.shm_name}", os.O_RDWR)
+            # Held until close(); a second sender would race on head
+            fcntl.flock(self.shm_fd, fcntl.LOCK_EX | fcntl.LOCK_NB)
+            self.shm_map = map_segment(self.shm_fd, COMMAND_RING_SIZE, 'CommandRing')
+            self.notifier = SegmentNotifier(self.shm_map, COMMAND_RING_SIZE)
+            self.connected = True
+            print("✓ Connected to C++ command ring")
+            return True
+        except BlockingIOError:
+            print("Failed to connect to command ring: another process is sending commands")
+        except Exception as e:
+            print(f"Failed to connect to command ring: {e}")
+        if self.shm_fd:
+            os.close(self.shm_fd)
+            self.shm_fd = None
+        return False
+    
+    def send(self, command_type: int, symbol: str = '', value: float = 0.0, quantity: int = 0,
+             side: int = 0, order_id: int = 0) -> Optional[int]:
+        """Queue one command; returns its id, or None if not connected or the ring is full"""
+        if not self.connected:
+            return None
+        encoded = symbol.upper().encode()
+        if len(encoded) >= SYMBOL_NAME_SIZE:
+            raise ValueError(f"Symbol name too long: {symbol}")
+        with self.lock:
+            head = struct.unpack_from('Q', self.shm_map, COMMAND_RING_HEAD_OFFSET)[0]
+            tail = struct.unpack_from('Q', self.shm_map, COMMAND_RING_TAIL_OFFSET)[0]
+            if head - tail >= COMMAND_RING_CAPACITY:
+                return None
+            command_id = self.next_id
+            self.next_id += 1
+            # Slot first, then head: x86 keeps the stores in order, as for the other rings
+            struct.pack_into(COMMAND_FORMAT, self.shm_map,
+                             COMMAND_RING_SLOTS_OFFSET + (head % COMMAND_RING_CAPACITY) * COMMAND_SIZE,
+                             command_id, time.monotonic_ns(), float(value), order_id, quantity,
+                             command_type, side, encoded)
+            struct.pack_into('Q', self.shm_map, COMMAND_RING_HEAD_OFFSET, head + 1)
+            self.notifier.notify()
+            return command_id
+    
+    def subscribe(self, symbol: str, start_price: float = 0.0) -> Optional[int]:
+        """Publish symbol again, or in simulated mode start simulating it from start_price"""
+        return self.send(COMMAND_SUBSCRIBE, symbol, value=start_price)
+    
+    def unsubscribe(self, symbol: str) -> Optional[int]:
+        """Stop publishing ticks for symbol"""
+        return self.send(COMMAND_UNSUBSCRIBE, symbol)
+    
+    def set_rate(self, rate: float) -> Optional[int]:
+        """Ticks per second in load mode, updates per second per symbol in simulated mode"""
+        return self.send(COMMAND_SET_RATE, value=rate)
+    
+    def place_order(self, symbol: str, side: str, price: float, quantity: int, order_id: int) -> Optional[int]:
+        """Rest an order in the C++ order book for symbol"""
+        return self.send(COMMAND_PLACE_ORDER, symbol, value=price, quantity=quantity,
+                         side=SIDES[side.lower()], order_id=order_id)
+    
+    def cancel_order(self, symbol: str, side: str, price: float, quantity: int, order_id: int) -> Optional[int]:
+        """Cancel an order placed with place_order()"""
+        return self.send(COMMAND_CANCEL_ORDER, symbol, value=price, quantity=quantity,
+                         side=SIDES[side.lower()], order_id=order_id)
+    
+    def pending(self) -> int:
+        """Commands trading_app has not taken off the ring yet"""
+        if not self.connected:
+            return 0
+        tail = struct.unpack_from('Q', self.shm_map, COMMAND_RING_TAIL_OFFSET)[0]
+        head = struct.unpack_from('Q', self.shm_map, COMMAND_RING_HEAD_OFFSET)[0]
+        return head - tail
+    
+    def close(self):
+        """Close command ring connection and give up the sender role"""
+        if self.notifier:
+            self.notifier.release()
+            self.notifier = None
         if self.shm_map:
             self.shm_map.close()
         if self.shm_fd:
@@ -86,6 +1221,16 @@ class DataManager:
         self.data_dir = data_dir
         self.bridge = TradingDataBridge()
         self.bridge.connect()
+        self.tick_ring = TickRingReader(latency_name='python-tick-ring')
+        self.tick_ring.connect()
+        self.market_table = MarketDataTableReader()
+        self.market_table.connect()
+        self.indicators = IndicatorReader(self.market_table)
+        self.indicators.connect()
+        self.books = OrderBookReader(self.market_table)
+        self.books.connect()
+        self.latency = LatencyTableReader()
+        self.latency.connect()
         
     def get_available_symbols(self) -> Dict[str, List[str]]:
         """Get all available symbols organized by asset type"""
@@ -95,13 +1240,26 @@ class DataManager:
             asset_dir = os.path.join(self.data_dir, asset_type)
             if os.path.exists(asset_dir):
                 for file in os.listdir(asset_dir):
-                    if file.endswith('.csv'):
-                        symbols[asset_type].append(file[:-4])
+                    name, ext = os.path.splitext(file)
+                    if ext in ('.csv', '.ticks') and name not in symbols[asset_type]:
+                        symbols[asset_type].append(name)
         
         return symbols
     
+    def open_tick_store(self, symbol: str, asset_type: str = None) -> Optional[TickStore]:
+        """Open the binary tick store for a symbol, if one exists"""
+        for atype in [asset_type] if asset_type else ['stocks', 'forex', 'crypto']:
+            path = tick_store_path(self.data_dir, atype, symbol)
+            if os.path.exists(path):
+                return TickStore(path)
+        return None
+    
     def load_symbol_data(self, symbol: str, asset_type: str = None) -> Optional[pd.DataFrame]:
         """Load data for a specific symbol"""
+        store = self.open_tick_store(symbol, asset_type)
+        if store is not None:
+            return store.to_dataframe()
+        
         if asset_type:
             file_path = os.path.join(self.data_dir, asset_type, f"{symbol}.csv")
             if os.path.exists(file_path):
@@ -117,6 +1275,11 @@ class DataManager:
     
     def get_latest_price(self, symbol: str) -> Optional[float]:
         """Get latest price for a symbol from local data"""
+        store = self.open_tick_store(symbol)
+        if store is not None:
+            latest = store.latest()
+            return float(latest['price']) if latest else None
+        
         df = self.load_symbol_data(symbol)
         if df is not None and 'price' in df.columns and not df.empty:
             return float(df['price'].iloc[-1])
@@ -124,11 +1287,27 @@ class DataManager:
     
     def get_price_history(self, symbol: str, limit: int = 100) -> Optional[pd.DataFrame]:
         """Get recent price history for a symbol"""
+        store = self.open_tick_store(symbol)
+        if store is not None:
+            return store.to_dataframe(max(0, len(store) - limit)) if len(store) else None
+        
         df = self.load_symbol_data(symbol)
         if df is not None and not df.empty:
             return df.tail(limit)
         return None
     
+    def get_price_range(self, symbol: str, start: int, end: int) -> Optional[pd.DataFrame]:
+        """Get records with start <= timestamp < end (seconds) without loading the whole file"""
+        store = self.open_tick_store(symbol)
+        if store is not None:
+            first, last = store.time_range_bounds(start * NANOS_PER_SECOND, end * NANOS_PER_SECOND)
+            return store.to_dataframe(first, last)
+        
+        df = self.load_symbol_data(symbol)
+        if df is not None and not df.empty:
+            return df[(df['timestamp'] >= start) & (df['timestamp'] < end)]
+        return None
+    
     def update_shared_memory(self, symbol: str) -> bool:
         """Update shared memory with latest data for symbol"""
         df = self.load_symbol_data(symbol)
@@ -137,7 +1316,7 @@ class DataManager:
             return self.bridge.write_data(
                 price=float(latest['price']),
                 volume=int(latest['volume']),
-                timestamp=int(latest['timestamp']),
+                timestamp=int(latest['timestamp']) * NANOS_PER_SECOND,
                 valid=True
             )
         return False
@@ -146,24 +1325,63 @@ class DataManager:
         """Get current data from shared memory"""
         return self.bridge.read_data()
     
+    def get_live_data(self, symbol: str) -> Optional[Dict[str, Any]]:
+        """Get the latest tick the C++ producer published for symbol"""
+        return self.market_table.read_symbol(symbol)
+    
+    def get_indicators(self, symbol: str) -> Optional[Dict[str, Any]]:
+        """Rolling indicators the C++ engine computed for symbol's last INDICATOR_WINDOW ticks"""
+        return self.indicators.read_symbol(symbol)
+    
+    def get_order_book(self, symbol: str) -> Optional[Dict[str, Any]]:
+        """Order book depth the C++ book engine maintains for symbol"""
+        return self.books.read_symbol(symbol)
+    
+    def get_latency(self) -> List[Dict[str, Any]]:
+        """Publish-to-consume latency percentiles of every consumer, C++ and Python"""
+        return self.latency.summaries()
+    
+    def drain_ticks(self, max_ticks: int = TICK_RING_CAPACITY) -> List[Dict[str, Any]]:
+        """Get every tick published since the last drain"""
+        return self.tick_ring.drain(max_ticks)
+    
+    def wait_for_ticks(self, timeout: float = 1.0, max_ticks: int = TICK_RING_CAPACITY) -> List[Dict[str, Any]]:
+        """Block until the producer publishes, then drain the tick ring"""
+        if self.tick_ring.pending() == 0:
+            self.tick_ring.wait_for_update(timeout)
+        return self.tick_ring.drain(max_ticks)
+    
     def save_new_data(self, symbol: str, data: List[Dict], asset_type: str = 'stocks'):
-        """Save new market data to CSV"""
+        """Append new market data to the symbol's binary tick store"""
         if not data:
             return
         
-        df = pd.DataFrame(data)
-        asset_dir = os.path.join(self.data_dir, asset_type)
-        os.makedirs(asset_dir, exist_ok=True)
-        
-        file_path = os.path.join(asset_dir, f"{symbol}.csv")
-        
-        # Append to existing file or create new one
-        if os.path.exists(file_path):
-            df.to_csv(file_path, mode='a', header=False, index=False)
+        path = tick_store_path(self.data_dir, asset_type, symbol)
+        if os.path.exists(path):
+            store = TickStore(path, writable=True)
         else:
-            df.to_csv(file_path, index=False)
+            store = TickStore.create(path, symbol)
+            # Carry over history still kept in the legacy CSV
+            csv_path = os.path.join(self.data_dir, asset_type, f"{symbol}.csv")
+            if os.path.exists(csv_path):
+                # Same rule as csv_import: stable sort, the last row written for a timestamp wins
+                history = (pd.read_csv(csv_path).sort_values('timestamp', kind='stable')
+                           .drop_duplicates('timestamp', keep='last'))
+                store.append(history.to_dict('records'))
+        
+        # Keep the store sorted by timestamp: skip rows we already hold
+        count = len(store)
+        last_timestamp = int(store.column('timestamp', count - 1)[0]) // NANOS_PER_SECOND if count else -1
+        latest = {}
+        for row in data:
+            timestamp = int(row['timestamp'])
+            if timestamp > last_timestamp:
+                latest[timestamp] = row  # a later row for the same timestamp replaces the earlier one
+        new_rows = [latest[timestamp] for timestamp in sorted(latest)]
+        store.append(new_rows)
+        store.close()
         
-        print(f"Saved {len(data)} records for {symbol}")
+        print(f"Saved {len(new_rows)} records for {symbol}")
 
 class PythonAPIClient:
     """Python API client for fetching data (complementing C++ providers)"""
@@ -240,6 +1458,9 @@ class TradingSystem:
         self.api_client = PythonAPIClient()
         self.monitoring = False
         self.monitor_thread = None
+        self.commands = None  # CommandSender, connected on the first send_signal_to_cpp
+        # Set by trading_app when its feed handler ingests live data itself
+        self.native_feed = os.environ.get('TRADING_NATIVE_FEED') == '1'
     
     def start_monitoring(self, symbols: List[str], interval: int = 60):
         """Start monitoring symbols and updating shared memory"""
@@ -264,6 +1485,10 @@ class TradingSystem:
     def _monitor_loop(self):
         """Main monitoring loop"""
         while self.monitoring:
+            if self.native_feed:
+                # Market data arrives through the C++ feed handler; nothing to fetch or write
+                time.sleep(self.monitor_interval)
+                continue
             for symbol in self.monitor_symbols:
                 try:
                     # Update shared memory with latest local data
@@ -283,6 +1508,9 @@ class TradingSystem:
     
     def fetch_and_store(self, symbol: str, days: int = 30, asset_type: str = 'stocks'):
         """Fetch data and store locally"""
+        if self.native_feed:
+            print(f"Skipping fetch for {symbol}: live data comes from the C++ feed handler")
+            return False
         if asset_type == 'crypto':
             data = self.api_client.get_crypto_data(symbol, days)
         else:
@@ -304,17 +1532,38 @@ class TradingSystem:
         }
         return summary
     
-    def send_signal_to_cpp(self, signal_type: str, data: Dict[str, Any]):
-        """Send trading signal back to C++ system"""
-        # For now, we'll update shared memory with signal data
+    def send_signal_to_cpp(self, signal_type: str, data: Dict[str, Any]) -> bool:
+        """Send a command to the C++ system over /trading_commands; False if it could not be queued.
+        signal_type is subscribe, unsubscribe, set_rate, place_order or cancel_order."""
         if signal_type == "price_update":
             self.data_manager.bridge.write_data(
                 price=data.get('price', 0.0),
                 volume=data.get('volume', 0),
-                timestamp=data.get('timestamp', int(time.time())),
+                timestamp=data.get('timestamp', time.time_ns()),
                 valid=True
             )
-        print(f"Sent signal to C++: {signal_type}")
+            return True
+        
+        if self.commands is None:
+            self.commands = CommandSender()
+        if not self.commands.connected and not self.commands.connect():
+            return False
+        if signal_type == "subscribe":
+            command_id = self.commands.subscribe(data['symbol'], data.get('price', 0.0))
+        elif signal_type == "unsubscribe":
+            command_id = self.commands.unsubscribe(data['symbol'])
+        elif signal_type == "set_rate":
+            command_id = self.commands.set_rate(data['rate'])
+        elif signal_type in ("place_order", "cancel_order"):
+            send = self.commands.place_order if signal_type == "place_order" else self.commands.cancel_order
+            command_id = send(data['symbol'], data['side'], data['price'], data['quantity'], data['order_id'])
+        else:
+            raise ValueError(f"Unknown signal type: {signal_type}")
+        
+        if command_id is None:
+            print(f"Command ring full, dropped {signal_type}")
+            return False
+        return True
 
 # Example usage functions
 def main():
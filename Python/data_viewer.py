@@ -12,7 +12,7 @@ import matplotlib.pyplot as plt
 from matplotlib.backends.backend_tkagg import FigureCanvasTkAgg
 import numpy as np
 
-from data_bridge import TradingDataBridge
+from data_bridge import TradingDataBridge, BroadcastRingReader
 
 class DataViewer:
     def __init__(self, root):
@@ -22,6 +22,7 @@ class DataViewer:
         
         self.current_data = None
         self.shared_memory = TradingDataBridge()
+        self.tick_stream = BroadcastRingReader()
         self.update_thread = None
         self.running = False
         
@@ -155,8 +156,9 @@ class DataViewer:
             subdir_path = os.path.join(data_dir, subdir)
             if os.path.exists(subdir_path):
                 for file in os.listdir(subdir_path):
-                    if file.endswith('.csv'):
-                        symbols.append(file[:-4])  # Remove .csv extension
+                    name, ext = os.path.splitext(file)
+                    if ext in ('.csv', '.ticks') and name not in symbols:
+                        symbols.append(name)
         
         self.symbol_combo['values'] = sorted(symbols)
         if symbols:
@@ -276,6 +278,8 @@ class DataViewer:
     
     def start_monitoring(self):
         if not self.running:
+            if not self.tick_stream.connected:
+                self.tick_stream.connect()
             self.running = True
             self.update_thread = threading.Thread(target=self.monitor_shared_memory, daemon=True)
             self.update_thread.start()
@@ -289,16 +293,27 @@ class DataViewer:
     
     def monitor_shared_memory(self):
         while self.running:
+            # Block until the producer publishes (or 1s passes) instead of sleep-polling
+            if self.tick_stream.connected:
+                self.tick_stream.wait_for_update(timeout=1.0)
+            elif self.shared_memory.connected:
+                self.shared_memory.wait_for_update(timeout=1.0)
+            else:
+                # Nothing to wait on until trading_app is up; wait_for_update would return at once
+                time.sleep(1.0)
+                continue
             data = self.shared_memory.read_data()
+            ticks = self.tick_stream.poll()
             if data:
                 timestamp = datetime.now().strftime("%H:%M:%S")
                 info = f"[{timestamp}] Price: ${data['price']:.2f}, Volume: {data['volume']:,}, "
-                info += f"Timestamp: {data['timestamp']}, Valid: {data['valid']}\n"
+                info += f"Timestamp: {data['timestamp']}, Valid: {data['valid']}"
+                if self.tick_stream.connected:
+                    info += f", Ticks: {len(ticks)} (dropped {self.tick_stream.dropped})"
+                info += "\n"
                 
                 self.root.after(0, lambda: self.realtime_text.insert('end', info))
                 self.root.after(0, lambda: self.realtime_text.see('end'))
-            
-            time.sleep(1)
     
     def plot_price(self):
         if self.current_data is None or 'price' not in self.current_data.columns:
@@ -345,6 +360,7 @@ class DataViewer:
     def on_closing(self):
         self.stop_monitoring()
         self.shared_memory.close()
+        self.tick_stream.close()
         self.root.destroy()
 
 if __name__ == "__main__":
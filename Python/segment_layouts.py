@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+Segment Layouts - GENERATED by C++/src/tools/gen_segment_layouts.cpp, do not edit
+Expected SegmentHeader contents (segment_header.h) for every shared memory segment
+"""
+import struct
+from typing import Dict, NamedTuple, Tuple
+
+SEGMENT_MAGIC = b'TRDSEG01'
+SEGMENT_VERSION = 1
+SEGMENT_HEADER_SIZE = 4096
+SEGMENT_HEADER_FORMAT = '8sIIQIIIIII32s48x'  # magic, version, header_size, layout_hash, payload_offset,
+                                             # payload_size, record_size, capacity, field_count, reserved, type_name
+SEGMENT_FIELD_FORMAT = '24sII'               # name, offset, size
+SEGMENT_FIELDS_OFFSET = struct.calcsize(SEGMENT_HEADER_FORMAT)
+SEGMENT_FIELD_SIZE = struct.calcsize(SEGMENT_FIELD_FORMAT)
+
+class SegmentLayout(NamedTuple):
+    layout_hash: int
+    payload_size: int
+    record_size: int
+    capacity: int
+    fields: Dict[str, Tuple[int, int]]  # name -> (offset, size)
+
+class SegmentLayoutError(ValueError):
+    """The segment was created with a layout this reader does not understand"""
+
+LAYOUTS = {
+    'TradingData': SegmentLayout(
+        layout_hash=0xbd667004fc1751fc,
+        payload_size=32,
+        record_size=32,
+        capacity=1,
+        fields={
+            'sequence': (0, 8),
+            'price': (8, 8),
+            'timestamp': (16, 8),
+            'volume': (24, 4),
+            'valid': (28, 1),
+        },
+    ),
+    'TickRing': SegmentLayout(
+        layout_hash=0xd2fbae37bb6cb84d,
+        payload_size=131200,
+        record_size=32,
+        capacity=4096,
+        fields={
+            'head': (0, 8),
+            'tail': (64, 8),
+            'slots': (128, 131072),
+            'record.price': (0, 8),
+            'record.timestamp': (8, 8),
+            'record.volume': (16, 4),
+            'record.valid': (20, 1),
+            'record.symbol_index': (22, 2),
+            'record.publish_ns': (24, 8),
+        },
+    ),
+    'TickBroadcastRing': SegmentLayout(
+        layout_hash=0x4b3b42f72e98c88e,
+        payload_size=164928,
+        record_size=40,
+        capacity=4096,
+        fields={
+            'head': (0, 8),
+            'readers': (64, 1024),
+            'reader.pid': (0, 4),
+            'reader.cursor': (8, 8),
+            'reader.received': (16, 8),
+            'reader.dropped': (24, 8),
+            'slots': (1088, 163840),
+            'record.sequence': (0, 8),
+            'record.price': (8, 8),
+            'record.timestamp': (16, 8),
+            'record.volume': (24, 4),
+            'record.valid': (28, 1),
+            'record.symbol_index': (30, 2),
+            'record.publish_ns': (32, 8),
+        },
+    ),
+    'MarketData': SegmentLayout(
+        layout_hash=0x06d9fa4f3cf9b09d,
+        payload_size=458816,
+        record_size=64,
+        capacity=4096,
+        fields={
+            'count': (0, 4),
+            'directory': (64, 196608),
+            'entry.slot_plus_one': (0, 4),
+            'entry.hash_tag': (4, 4),
+            'entry.symbol': (8, 16),
+            'slots': (196672, 262144),
+            'record.sequence': (0, 8),
+            'record.price': (8, 8),
+            'record.timestamp': (16, 8),
+            'record.volume': (24, 4),
+            'record.valid': (28, 1),
+            'record.symbol': (32, 16),
+        },
+    ),
+    'Indicators': SegmentLayout(
+        layout_hash=0xed28bf91be7a6cac,
+        payload_size=524352,
+        record_size=128,
+        capacity=4096,
+        fields={
+            'count': (0, 4),
+            'slots': (64, 524288),
+            'record.sequence': (0, 8),
+            'record.timestamp': (8, 8),
+            'record.samples': (16, 8),
+            'record.last_price': (24, 8),
+            'record.sma': (32, 8),
+            'record.ema': (40, 8),
+            'record.vwap': (48, 8),
+            'record.volatility': (56, 8),
+            'record.min': (64, 8),
+            'record.max': (72, 8),
+        },
+    ),
+    'LatencyTable': SegmentLayout(
+        layout_hash=0x145baa733c7aa888,
+        payload_size=76800,
+        record_size=4800,
+        capacity=16,
+        fields={
+            'consumers': (0, 76800),
+            'record.pid': (0, 4),
+            'record.name': (4, 24),
+            'record.count': (32, 8),
+            'record.total_ns': (40, 8),
+            'record.max_ns': (48, 8),
+            'record.buckets': (64, 4736),
+        },
+    ),
+    'OrderRing': SegmentLayout(
+        layout_hash=0x83bca57873f62029,
+        payload_size=2097280,
+        record_size=32,
+        capacity=65536,
+        fields={
+            'head': (0, 8),
+            'tail': (64, 8),
+            'slots': (128, 2097152),
+            'record.order_id': (0, 8),
+            'record.price': (8, 8),
+            'record.timestamp': (16, 8),
+            'record.quantity': (24, 4),
+            'record.symbol_index': (28, 2),
+            'record.side': (30, 1),
+            'record.action': (31, 1),
+        },
+    ),
+    'OrderBooks': SegmentLayout(
+        layout_hash=0xcf481e260418c63f,
+        payload_size=2359360,
+        record_size=576,
+        capacity=4096,
+        fields={
+            'count': (0, 4),
+            'slots': (64, 2359296),
+            'record.sequence': (0, 8),
+            'record.timestamp': (8, 8),
+            'record.updates': (16, 8),
+            'record.last_price': (24, 8),
+            'record.last_quantity': (32, 8),
+            'record.bid_depth': (40, 4),
+            'record.ask_depth': (44, 4),
+            'record.bids': (48, 240),
+            'record.asks': (288, 240),
+            'level.price': (0, 8),
+            'level.quantity': (8, 8),
+            'level.orders': (16, 4),
+        },
+    ),
+    'CommandRing': SegmentLayout(
+        layout_hash=0x0ea12a4735f93122,
+        payload_size=65664,
+        record_size=64,
+        capacity=1024,
+        fields={
+            'head': (0, 8),
+            'tail': (64, 8),
+            'slots': (128, 65536),
+            'record.id': (0, 8),
+            'record.sent_ns': (8, 8),
+            'record.value': (16, 8),
+            'record.order_id': (24, 8),
+            'record.quantity': (32, 4),
+            'record.type': (36, 2),
+            'record.side': (38, 1),
+            'record.symbol': (40, 16),
+        },
+    ),
+    'MetricsTable': SegmentLayout(
+        layout_hash=0xc6f635bc32d2b21b,
+        payload_size=80896,
+        record_size=5056,
+        capacity=16,
+        fields={
+            'threads': (0, 80896),
+            'record.pid': (0, 4),
+            'record.name': (4, 24),
+            'record.used': (32, 8),
+            'record.values': (64, 160),
+            'record.batch.count': (288, 8),
+            'record.batch.buckets': (320, 4736),
+        },
+    ),
+}
+
+def read_segment_header(buffer) -> Dict:
+    """Decode the SegmentHeader at the start of buffer (the segment's first page)"""
+    (magic, version, header_size, layout_hash, payload_offset, payload_size, record_size,
+     capacity, field_count, _, type_name) = struct.unpack_from(SEGMENT_HEADER_FORMAT, buffer, 0)
+    fields = {}
+    for i in range(min(field_count, (header_size - SEGMENT_FIELDS_OFFSET) // SEGMENT_FIELD_SIZE)):
+        name, offset, size = struct.unpack_from(SEGMENT_FIELD_FORMAT, buffer, SEGMENT_FIELDS_OFFSET + i * SEGMENT_FIELD_SIZE)
+        fields[name.rstrip(b'\0').decode()] = (offset, size)
+    return {
+        'magic': magic, 'version': version, 'header_size': header_size, 'layout_hash': layout_hash,
+        'payload_offset': payload_offset, 'payload_size': payload_size, 'record_size': record_size,
+        'capacity': capacity, 'type_name': type_name.rstrip(b'\0').decode(), 'fields': fields,
+    }
+
+def check_segment(buffer, type_name: str) -> Dict:
+    """Header of buffer if it holds the layout this module was generated for; raises SegmentLayoutError otherwise"""
+    header = read_segment_header(buffer)
+    if header['magic'] != SEGMENT_MAGIC:
+        raise SegmentLayoutError("no segment header (not initialized, or an older producer)")
+    if header['version'] != SEGMENT_VERSION or header['payload_offset'] != SEGMENT_HEADER_SIZE:
+        raise SegmentLayoutError(f"segment header version {header['version']}, expected {SEGMENT_VERSION}")
+    expected = LAYOUTS[type_name]
+    if header['layout_hash'] != expected.layout_hash or header['payload_size'] != expected.payload_size:
+        raise SegmentLayoutError(
+            f"layout mismatch: segment holds {header['type_name']} ({header['payload_size']} bytes), "
+            f"expected {type_name} ({expected.payload_size} bytes) - regenerate segment_layouts.py")
+    return header
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""
+Tick Store - Python access to the C++ binary columnar tick store (tick_store.h)
+Columns are returned as numpy arrays viewing the mapped file, with no parsing
+"""
+import mmap
+import os
+import struct
+from typing import Dict, List, Optional, Any
+
+import numpy as np
+
+# Layout of TickStoreHeader in tick_store.h
+TICK_STORE_MAGIC = b'TICKSTOR'
+TICK_STORE_VERSION = 1
+TICK_STORE_HEADER_SIZE = 4096
+TICK_STORE_HEADER_FORMAT = '8sII16sQQII7Q'  # magic, version, column_count, symbol, count, capacity, superseded, reserved, offsets
+TICK_STORE_COUNT_OFFSET = 32
+TICK_STORE_SUPERSEDED_OFFSET = 48
+TICK_STORE_CAPACITY_ALIGN = 512
+TICK_STORE_INITIAL_CAPACITY = 4096
+
+COLUMNS = ['timestamp', 'open', 'high', 'low', 'close', 'volume', 'price']
+COLUMN_DTYPES = {name: (np.uint64 if name == 'timestamp' else np.float64) for name in COLUMNS}
+NANOS_PER_SECOND = 1_000_000_000
+
+def tick_store_path(data_dir: str, asset_type: str, symbol: str) -> str:
+    """market_data/<asset_type>/<symbol>.ticks, next to the legacy CSV"""
+    return os.path.join(data_dir, asset_type, f"{symbol}.ticks")
+
+def _file_size(capacity: int) -> int:
+    return TICK_STORE_HEADER_SIZE + len(COLUMNS) * capacity * 8
+
+def _round_capacity(records: int) -> int:
+    return (records + TICK_STORE_CAPACITY_ALIGN - 1) // TICK_STORE_CAPACITY_ALIGN * TICK_STORE_CAPACITY_ALIGN
+
+def _create_file(path: str, symbol: str, capacity: int):
+    offsets = [TICK_STORE_HEADER_SIZE + c * capacity * 8 for c in range(len(COLUMNS))]
+    header = struct.pack(TICK_STORE_HEADER_FORMAT, TICK_STORE_MAGIC, TICK_STORE_VERSION, len(COLUMNS),
+                         symbol.encode()[:15], 0, capacity, 0, 0, *offsets)
+    with open(path, 'wb') as f:
+        f.truncate(_file_size(capacity))
+        f.write(header)
+
+class TickStore:
+    """One symbol's tick store file; arrays returned are views valid while the store is open"""
+
+    def __init__(self, path: str, writable: bool = False):
+        self.path = path
+        self.writable = writable
+        self.shm_map = None
+        self.symbol = None
+        self.capacity = 0
+        self.offsets = []
+        self._map()
+
+    @classmethod
+    def create(cls, path: str, symbol: str, capacity: int = TICK_STORE_INITIAL_CAPACITY) -> 'TickStore':
+        """Create an empty store file and open it for appending"""
+        os.makedirs(os.path.dirname(path) or '.', exist_ok=True)
+        _create_file(path, symbol, _round_capacity(capacity))
+        return cls(path, writable=True)
+
+    def _map(self):
+        flags = os.O_RDWR if self.writable else os.O_RDONLY
+        prot = mmap.PROT_READ | (mmap.PROT_WRITE if self.writable else 0)
+        fd = os.open(self.path, flags)
+        try:
+            size = os.fstat(fd).st_size
+            # Earlier maps may still back live numpy views; they close once those are gone
+            self.shm_map = mmap.mmap(fd, size, mmap.MAP_SHARED, prot)
+        finally:
+            os.close(fd)
+
+        magic, version, column_count, symbol, _, capacity, _, _, *offsets = struct.unpack_from(
+            TICK_STORE_HEADER_FORMAT, self.shm_map, 0)
+        if magic != TICK_STORE_MAGIC:
+            raise ValueError(f"Not a tick store file: {self.path}")
+        if version != TICK_STORE_VERSION or column_count != len(COLUMNS):
+            raise ValueError(f"Unsupported tick store version: {self.path}")
+        self.symbol = symbol.rstrip(b'\0').decode()
+        self.capacity = capacity
+        self.offsets = offsets
+
+    def _refresh(self):
+        # The writer swaps in a larger file when this one fills up
+        if struct.unpack_from('I', self.shm_map, TICK_STORE_SUPERSEDED_OFFSET)[0]:
+            self._map()
+
+    def __len__(self) -> int:
+        self._refresh()
+        return struct.unpack_from('Q', self.shm_map, TICK_STORE_COUNT_OFFSET)[0]
+
+    def column(self, name: str, start: int = 0, stop: Optional[int] = None) -> np.ndarray:
+        """Zero-copy view of one column for records [start, stop)"""
+        count = len(self)
+        stop = count if stop is None else min(stop, count)
+        start = max(0, min(start, stop))
+        index = COLUMNS.index(name)
+        return np.frombuffer(self.shm_map, dtype=COLUMN_DTYPES[name], count=stop - start,
+                             offset=self.offsets[index] + start * 8)
+
+    def columns(self, start: int = 0, stop: Optional[int] = None) -> Dict[str, np.ndarray]:
+        """Zero-copy views of every column for records [start, stop)"""
+        return {name: self.column(name, start, stop) for name in COLUMNS}
+
+    def time_range(self, begin_ns: int, end_ns: int) -> Dict[str, np.ndarray]:
+        """Views of records with begin_ns <= timestamp < end_ns, found by binary search"""
+        first, last = self.time_range_bounds(begin_ns, end_ns)
+        return self.columns(first, last)
+
+    def time_range_bounds(self, begin_ns: int, end_ns: int):
+        """Record indices [first, last) covering begin_ns <= timestamp < end_ns"""
+        timestamps = self.column('timestamp')
+        first = int(np.searchsorted(timestamps, np.uint64(begin_ns), side='left'))
+        last = int(np.searchsorted(timestamps, np.uint64(end_ns), side='left'))
+        return first, max(first, last)
+
+    def tail(self, n: int) -> Dict[str, np.ndarray]:
+        """Views of the most recent n records; O(1) regardless of file size"""
+        count = len(self)
+        return self.columns(max(0, count - n), count)
+
+    def latest(self) -> Optional[Dict[str, Any]]:
+        """Most recent record as plain Python values"""
+        count = len(self)
+        if count == 0:
+            return None
+        return {name: self.column(name, count - 1)[0].item() for name in COLUMNS}
+
+    def to_dataframe(self, start: int = 0, stop: Optional[int] = None):
+        """Copy records into a DataFrame with the legacy CSV schema (timestamp in seconds)"""
+        import pandas as pd
+        data = self.columns(start, stop)
+        df = pd.DataFrame({name: np.array(values) for name, values in data.items()})
+        df['timestamp'] = (df['timestamp'] // NANOS_PER_SECOND).astype('int64')
+        df.insert(1, 'symbol', self.symbol)
+        df['source'] = 'TickStore'
+        return df
+
+    def append(self, records: List[Dict[str, Any]]):
+        """Append rows (CSV-style dicts with timestamp in seconds) to the store"""
+        if not self.writable:
+            raise PermissionError(f"Tick store opened read-only: {self.path}")
+        if not records:
+            return
+
+        count = len(self)
+        if count + len(records) > self.capacity:
+            self._grow(count + len(records))
+
+        for index, name in enumerate(COLUMNS):
+            if name == 'timestamp':
+                values = np.array([int(r['timestamp']) * NANOS_PER_SECOND for r in records], dtype=np.uint64)
+            elif name == 'volume':
+                values = np.array([float(r.get('volume', 0.0)) for r in records], dtype=np.float64)
+            else:
+                # Price-only feeds leave OHLC empty; fall back to the trade price
+                values = np.array([float(r[name] if name in r else r['price']) for r in records], dtype=np.float64)
+            raw = values.tobytes()
+            start = self.offsets[index] + count * 8
+            self.shm_map[start:start + len(raw)] = raw
+
+        # Publish the new count only after the column data is in place
+        struct.pack_into('Q', self.shm_map, TICK_STORE_COUNT_OFFSET, count + len(records))
+
+    def _grow(self, min_capacity: int):
+        # Same scheme as TickStoreWriter::grow: copy into a bigger file, rename over, flag the old one
+        capacity = self.capacity * 2
+        while capacity < min_capacity:
+            capacity *= 2
+
+        count = len(self)
+        tmp_path = self.path + '.grow'
+        _create_file(tmp_path, self.symbol, capacity)
+        with open(tmp_path, 'r+b') as f:
+            grown = mmap.mmap(f.fileno(), _file_size(capacity))
+            for index in range(len(COLUMNS)):
+                src = self.offsets[index]
+                dst = TICK_STORE_HEADER_SIZE + index * capacity * 8
+                grown[dst:dst + count * 8] = self.shm_map[src:src + count * 8]
+            struct.pack_into('Q', grown, TICK_STORE_COUNT_OFFSET, count)
+            grown.close()
+
+        os.replace(tmp_path, self.path)
+        struct.pack_into('I', self.shm_map, TICK_STORE_SUPERSEDED_OFFSET, 1)
+        self._map()
+
+    def close(self):
+        """Release this store's mapping"""
+        self.shm_map = None